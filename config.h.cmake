@@ -38,6 +38,9 @@
 #cmakedefine UBUNTU_TOUCH
 #cmakedefine ENABLE_TOUCHSCREEN_SUPPORT
 
+#cmakedefine ENABLE_PROFILER
+#cmakedefine ENABLE_ALLOCATION_COUNTER
+
 #cmakedefine REMOVE_QUIT_BUTTON
 
 #endif /*CONFIG_H*/
@@ -10,13 +10,15 @@ out vec4 texcoord_repeat_var;
 out vec2 texcoord_var;
 
 uniform mat3 modelviewprojection;
+uniform vec2 model_translation;
+uniform float model_scale;
 
 void main(void)
 {
   texcoord_var = texcoord;
   texcoord_repeat_var = texcoord_repeat;
   diffuse_var = diffuse;
-  gl_Position = vec4(vec3(position, 1) * modelviewprojection, 1.0);
+  gl_Position = vec4(vec3(position * model_scale + model_translation, 1) * modelviewprojection, 1.0);
 }
 
 /* EOF */
@@ -0,0 +1,91 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "audio/audio_decode_thread.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "audio/stream_sound_source.hpp"
+
+namespace {
+
+/** How long to sleep when all rings are full. The rings hold seconds
+    of audio, so this only needs to be well below that. */
+const std::chrono::milliseconds IDLE_TIME(20);
+
+} // namespace
+
+AudioDecodeThread::AudioDecodeThread() :
+  m_mutex(),
+  m_cond(),
+  m_sources(),
+  m_quit(false),
+  m_thread()
+{
+  m_thread = std::thread(&AudioDecodeThread::run, this);
+}
+
+AudioDecodeThread::~AudioDecodeThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+}
+
+void
+AudioDecodeThread::add(StreamSoundSource& source)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sources.push_back(&source);
+  }
+  m_cond.notify_all();
+}
+
+void
+AudioDecodeThread::remove(StreamSoundSource& source)
+{
+  // The sources are only decoded with the lock held
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_sources.erase(std::remove(m_sources.begin(), m_sources.end(), &source),
+                  m_sources.end());
+}
+
+void
+AudioDecodeThread::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_quit)
+  {
+    bool decoded = false;
+    for (auto* source : m_sources)
+    {
+      decoded |= source->decode();
+    }
+
+    if (!decoded)
+    {
+      m_cond.wait_for(lock, IDLE_TIME);
+    }
+  }
+}
+
+/* EOF */
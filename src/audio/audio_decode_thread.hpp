@@ -0,0 +1,58 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_AUDIO_AUDIO_DECODE_THREAD_HPP
+#define HEADER_SUPERTUX_AUDIO_AUDIO_DECODE_THREAD_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class StreamSoundSource;
+
+/** Keeps the PCM rings of all StreamSoundSources filled, so that the
+    game thread never has to decode audio itself. */
+class AudioDecodeThread final
+{
+public:
+  AudioDecodeThread();
+  ~AudioDecodeThread();
+
+  void add(StreamSoundSource& source);
+
+  /** Returns once the thread doesn't access `source` anymore */
+  void remove(StreamSoundSource& source);
+
+private:
+  void run();
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::vector<StreamSoundSource*> m_sources;
+  bool m_quit;
+  std::thread m_thread;
+
+private:
+  AudioDecodeThread(const AudioDecodeThread&) = delete;
+  AudioDecodeThread& operator=(const AudioDecodeThread&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,65 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_AUDIO_PCM_RING_BUFFER_HPP
+#define HEADER_SUPERTUX_AUDIO_PCM_RING_BUFFER_HPP
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+
+/** Lock-free ring of decoded audio data for exactly one producer
+    thread (the decoder) and one consumer thread (the game thread). */
+class PCMRingBuffer final
+{
+public:
+  PCMRingBuffer(size_t capacity);
+
+  /** Producer side, returns the number of bytes written */
+  size_t write(const char* data, size_t size);
+
+  /** Consumer side, returns the number of bytes read */
+  size_t read(char* data, size_t size);
+
+  /** Bytes that can be read right now */
+  size_t get_read_available() const;
+
+  /** Bytes that can be written right now */
+  size_t get_write_available() const;
+
+  /** Drops all data, neither side may access the ring meanwhile */
+  void clear();
+
+  size_t get_capacity() const { return m_capacity; }
+
+private:
+  std::unique_ptr<char[]> m_data;
+  const size_t m_capacity;
+
+  /** Total bytes read and written, positions in m_data are these
+      modulo m_capacity */
+  std::atomic<size_t> m_read_pos;
+  std::atomic<size_t> m_write_pos;
+
+private:
+  PCMRingBuffer(const PCMRingBuffer&) = delete;
+  PCMRingBuffer& operator=(const PCMRingBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
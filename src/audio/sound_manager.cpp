@@ -22,10 +22,12 @@
 #include <sstream>
 #include <memory>
 
+#include "audio/audio_decode_thread.hpp"
 #include "audio/dummy_sound_source.hpp"
 #include "audio/sound_file.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 SoundManager::SoundManager() :
   m_device(alcOpenDevice(nullptr)),
@@ -35,6 +37,7 @@ SoundManager::SoundManager() :
   m_buffers(),
   m_sources(),
   m_update_list(),
+  m_decode_thread(),
   m_music_source(),
   m_music_enabled(false),
   m_music_volume(0),
@@ -71,6 +74,7 @@ SoundManager::~SoundManager()
 {
   m_music_source.reset();
   m_sources.clear();
+  m_decode_thread.reset();
 
   for (const auto& buffer : m_buffers) {
     alDeleteBuffers(1, &buffer.second);
@@ -227,6 +231,10 @@ SoundManager::register_for_update(StreamSoundSource* sss)
   if (sss)
   {
     m_update_list.push_back(sss);
+
+    if (!m_decode_thread)
+      m_decode_thread.reset(new AudioDecodeThread);
+    m_decode_thread->add(*sss);
   }
 }
 
@@ -235,6 +243,9 @@ SoundManager::remove_from_update(StreamSoundSource* sss)
 {
   if (sss)
   {
+    if (m_decode_thread)
+      m_decode_thread->remove(*sss);
+
     auto it = m_update_list.begin();
     while (it != m_update_list.end()) {
       if (*it == sss) {
@@ -437,6 +448,8 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  PROFILE_ZONE("SoundManager::update");
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
@@ -28,6 +28,7 @@
 #include "math/vector.hpp"
 #include "util/currenton.hpp"
 
+class AudioDecodeThread;
 class SoundFile;
 class SoundSource;
 class StreamSoundSource;
@@ -120,6 +121,9 @@ private:
 
   std::vector<StreamSoundSource*> m_update_list;
 
+  /** Decodes the sources in m_update_list, started on demand */
+  std::unique_ptr<AudioDecodeThread> m_decode_thread;
+
   std::unique_ptr<StreamSoundSource> m_music_source;
 
   bool m_music_enabled;
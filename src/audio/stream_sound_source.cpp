@@ -17,11 +17,22 @@
 #include "audio/sound_file.hpp"
 #include "audio/sound_manager.hpp"
 #include "audio/stream_sound_source.hpp"
+
+#include <algorithm>
+
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
 StreamSoundSource::StreamSoundSource() :
   m_file(),
+  m_free_buffers(),
+  m_file_mutex(),
+  m_ring(STREAMBUFFERSIZE),
+  m_decode_buffer(new char[DECODECHUNKSIZE]),
+  m_fragment(new char[STREAMFRAGMENTSIZE]),
+  m_eof(false),
+  m_format(),
+  m_rate(),
   m_fade_state(NoFading),
   m_fade_start_time(),
   m_fade_time(),
@@ -36,13 +47,15 @@ StreamSoundSource::StreamSoundSource() :
   {
     log_warning << e.what() << std::endl;
   }
+  m_free_buffers.assign(m_buffers, m_buffers + STREAMFRAGMENTS);
+
   //add me to update list
   SoundManager::current()->register_for_update( this );
 }
 
 StreamSoundSource::~StreamSoundSource()
 {
-  //don't update me any longer
+  //don't update me any longer, this also waits for the decode thread
   SoundManager::current()->remove_from_update( this );
   m_file.reset();
   stop();
@@ -61,16 +74,72 @@ StreamSoundSource::~StreamSoundSource()
 void
 StreamSoundSource::set_sound_file(std::unique_ptr<SoundFile> newfile)
 {
+  std::lock_guard<std::mutex> lock(m_file_mutex);
+
   m_file = std::move(newfile);
+  m_format = SoundManager::get_sample_format(*m_file);
+  m_rate = static_cast<ALsizei>(m_file->m_rate);
+  m_ring.clear();
+  m_eof = false;
 
-  ALint queued;
-  alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
-  for (size_t i = 0; i < STREAMFRAGMENTS - queued; ++i) {
-    if (fillBufferAndQueue(m_buffers[i]) == false)
+  // The first buffers are filled right away, so that the source can be
+  // played without waiting for the decode thread
+  while (!m_free_buffers.empty()) {
+    const size_t bytesread = read_fragment();
+    if (bytesread > 0) {
+      queue_buffer(m_free_buffers.back(), bytesread);
+      m_free_buffers.pop_back();
+    }
+
+    if (bytesread < STREAMFRAGMENTSIZE) {
+      m_eof = true;
       break;
+    }
   }
 }
 
+void
+StreamSoundSource::set_looping(bool looping_)
+{
+  m_looping = looping_;
+
+  if (looping_ && m_eof) {
+    // The decode thread stopped at the end of the file, continue from
+    // the start
+    std::lock_guard<std::mutex> lock(m_file_mutex);
+    if (m_file && m_eof) {
+      m_file->reset();
+      m_eof = false;
+    }
+  }
+}
+
+bool
+StreamSoundSource::decode()
+{
+  std::lock_guard<std::mutex> lock(m_file_mutex);
+
+  if (!m_file || m_eof || m_ring.get_write_available() < DECODECHUNKSIZE)
+    return false;
+
+  size_t bytesread = m_file->read(m_decode_buffer.get(), DECODECHUNKSIZE);
+  if (bytesread == 0) {
+    // end of sound file
+    if (m_looping) {
+      m_file->reset();
+      bytesread = m_file->read(m_decode_buffer.get(), DECODECHUNKSIZE);
+    }
+
+    if (bytesread == 0) {
+      m_eof = true;
+      return false;
+    }
+  }
+
+  m_ring.write(m_decode_buffer.get(), bytesread);
+  return true;
+}
+
 void
 StreamSoundSource::update()
 {
@@ -82,18 +151,18 @@ StreamSoundSource::update()
     try
     {
       SoundManager::check_al_error("Couldn't unqueue audio buffer: ");
+      m_free_buffers.push_back(buffer);
     }
     catch(std::exception& e)
     {
       log_warning << e.what() << std::endl;
     }
-
-    if (fillBufferAndQueue(buffer) == false)
-      break;
   }
 
+  const int queued = queue_buffers();
+
   if (!playing() && !paused()) {
-    if (processed == 0 || !m_looping)
+    if (queued == 0 || !m_looping)
       return;
 
     // we might have to restart the source if we had a buffer underrun
@@ -131,15 +200,13 @@ StreamSoundSource::set_fading(FadeState state, float fade_time_)
   m_fade_start_time = g_real_time;
 }
 
-bool
-StreamSoundSource::fillBufferAndQueue(ALuint buffer)
+size_t
+StreamSoundSource::read_fragment()
 {
-  // fill buffer
-  std::unique_ptr<char[]> bufferdata(new char[STREAMFRAGMENTSIZE]);
   size_t bytesread = 0;
   do {
-    bytesread += m_file->read(bufferdata.get() + bytesread,
-                            STREAMFRAGMENTSIZE - bytesread);
+    bytesread += m_file->read(m_fragment.get() + bytesread,
+                              STREAMFRAGMENTSIZE - bytesread);
     // end of sound file
     if (bytesread < STREAMFRAGMENTSIZE) {
       if (m_looping)
@@ -149,24 +216,46 @@ StreamSoundSource::fillBufferAndQueue(ALuint buffer)
     }
   } while(bytesread < STREAMFRAGMENTSIZE);
 
-  if (bytesread > 0) {
-    ALenum format = SoundManager::get_sample_format(*m_file);
-    try
-    {
-      alBufferData(buffer, format, bufferdata.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
-      SoundManager::check_al_error("Couldn't refill audio buffer: ");
+  return bytesread;
+}
 
-      alSourceQueueBuffers(m_source, 1, &buffer);
-      SoundManager::check_al_error("Couldn't queue audio buffer: ");
-    }
-    catch(std::exception& e)
-    {
-      log_warning << e.what() << std::endl;
-    }
+int
+StreamSoundSource::queue_buffers()
+{
+  int queued = 0;
+  while (!m_free_buffers.empty()) {
+    // m_eof has to be read before the ring, the decoder sets it only
+    // after its last write
+    const bool eof = m_eof;
+    const size_t size = std::min(m_ring.get_read_available(), STREAMFRAGMENTSIZE);
+
+    // Only the end of the file may be queued as a partial fragment
+    if (size == 0 || (size < STREAMFRAGMENTSIZE && !eof))
+      break;
+
+    m_ring.read(m_fragment.get(), size);
+    queue_buffer(m_free_buffers.back(), size);
+    m_free_buffers.pop_back();
+    queued += 1;
   }
+  return queued;
+}
 
-  // return false if there aren't more buffers to fill
-  return bytesread >= STREAMFRAGMENTSIZE;
+void
+StreamSoundSource::queue_buffer(ALuint buffer, size_t size)
+{
+  try
+  {
+    alBufferData(buffer, m_format, m_fragment.get(), static_cast<ALsizei>(size), m_rate);
+    SoundManager::check_al_error("Couldn't refill audio buffer: ");
+
+    alSourceQueueBuffers(m_source, 1, &buffer);
+    SoundManager::check_al_error("Couldn't queue audio buffer: ");
+  }
+  catch(std::exception& e)
+  {
+    log_warning << e.what() << std::endl;
+  }
 }
 
 /* EOF */
@@ -17,7 +17,12 @@
 #ifndef HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 #define HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "audio/openal_sound_source.hpp"
+#include "audio/pcm_ring_buffer.hpp"
 
 class SoundFile;
 
@@ -28,6 +33,9 @@ private:
   static const size_t STREAMFRAGMENTS = 5;
   static const size_t STREAMFRAGMENTSIZE = STREAMBUFFERSIZE / STREAMFRAGMENTS;
 
+  /** Amount of data the decode thread decodes at once */
+  static const size_t DECODECHUNKSIZE = 1024 * 16;
+
 public:
   enum FadeState { NoFading, FadingOn, FadingOff, FadingPause, FadingResume };
 
@@ -36,7 +44,7 @@ public:
   ~StreamSoundSource() override;
 
   virtual void update() override;
-  virtual void set_looping(bool looping_) override { m_looping = looping_; }
+  virtual void set_looping(bool looping_) override;
 
   void set_sound_file(std::unique_ptr<SoundFile> newfile);
 
@@ -44,17 +52,40 @@ public:
   FadeState get_fade_state() const { return m_fade_state; }
   bool get_looping() const { return m_looping; }
 
+  /** Called by the AudioDecodeThread, decodes the next chunk of the
+      sound file into the ring. Returns false if there was nothing to
+      do. */
+  bool decode();
+
 private:
-  bool fillBufferAndQueue(ALuint buffer);
+  /** Reads a whole fragment from the file, only used for the initial
+      buffers. */
+  size_t read_fragment();
+
+  /** Fills free buffers from the ring and queues them, returns the
+      number of queued buffers */
+  int queue_buffers();
+
+  void queue_buffer(ALuint buffer, size_t size);
 
 private:
   std::unique_ptr<SoundFile> m_file;
   ALuint m_buffers[STREAMFRAGMENTS];
+  std::vector<ALuint> m_free_buffers;
+
+  /** Guards m_file against the decode thread */
+  std::mutex m_file_mutex;
+  PCMRingBuffer m_ring;
+  std::unique_ptr<char[]> m_decode_buffer;
+  std::unique_ptr<char[]> m_fragment;
+  std::atomic<bool> m_eof;
+  ALenum m_format;
+  ALsizei m_rate;
 
   FadeState m_fade_state;
   float m_fade_start_time;
   float m_fade_time;
-  bool m_looping;
+  std::atomic<bool> m_looping;
 
 private:
   StreamSoundSource(const StreamSoundSource&) = delete;
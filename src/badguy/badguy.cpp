@@ -16,6 +16,8 @@
 
 #include "badguy/badguy.hpp"
 
+#include <algorithm>
+
 #include "audio/sound_manager.hpp"
 #include "badguy/dispenser.hpp"
 #include "editor/editor.hpp"
@@ -150,6 +152,17 @@ BadGuy::draw(DrawingContext& context)
   }
 }
 
+float
+BadGuy::get_draw_margin() const
+{
+  if (!m_glowing)
+    return MovingSprite::get_draw_margin();
+
+  // The light is centered on the badguy and might be a lot larger
+  const int light_size = std::max(m_lightsprite->get_width(), m_lightsprite->get_height());
+  return std::max(MovingSprite::get_draw_margin(), static_cast<float>(light_size) / 2.0f);
+}
+
 void
 BadGuy::update(float dt_sec)
 {
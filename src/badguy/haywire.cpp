@@ -34,6 +34,13 @@ const float TIME_STUNNED = 0.5f;
 const float NORMAL_WALK_SPEED = 80.0f;
 const float EXPLODING_WALK_SPEED = 200.0f;
 
+const ActionId WALK_LEFT("left");
+const ActionId WALK_RIGHT("right");
+const ActionId TICKING_LEFT("ticking-left");
+const ActionId TICKING_RIGHT("ticking-right");
+const ActionId ACTIVE_LEFT("active-left");
+const ActionId ACTIVE_RIGHT("active-right");
+
 } // namespace
 
 Haywire::Haywire(const ReaderMapping& reader) :
@@ -163,14 +170,14 @@ Haywire::active_update(float dt_sec)
     //end of pathfinding
 
 	  if (stomped_timer.get_timeleft() < 0.05f) {
-        set_action ((m_dir == Direction::LEFT) ? "ticking-left" : "ticking-right", /* loops = */ -1);
-        walk_left_action = "ticking-left";
-        walk_right_action = "ticking-right";
+        set_action ((m_dir == Direction::LEFT) ? TICKING_LEFT : TICKING_RIGHT, /* loops = */ -1);
+        walk_left_action = TICKING_LEFT;
+        walk_right_action = TICKING_RIGHT;
     }
     else {
-        set_action ((m_dir == Direction::LEFT) ? "active-left" : "active-right", /* loops = */ 1);
-        walk_left_action = "active-left";
-	      walk_right_action = "active-right";
+        set_action ((m_dir == Direction::LEFT) ? ACTIVE_LEFT : ACTIVE_RIGHT, /* loops = */ 1);
+        walk_left_action = ACTIVE_LEFT;
+	      walk_right_action = ACTIVE_RIGHT;
     }
 
     auto p = get_nearest_player ();
@@ -259,8 +266,8 @@ Haywire::start_exploding()
 void
 Haywire::stop_exploding()
 {
-  walk_left_action = "left";
-  walk_right_action = "right";
+  walk_left_action = WALK_LEFT;
+  walk_right_action = WALK_RIGHT;
   set_walk_speed(NORMAL_WALK_SPEED);
   max_drop_height = 16;
   time_until_explosion = 0.0f;
@@ -27,8 +27,8 @@ WalkingBadguy::WalkingBadguy(const Vector& pos,
                              int layer_,
                              const std::string& light_sprite_name) :
   BadGuy(pos, sprite_name_, layer_, light_sprite_name),
-  walk_left_action(walk_left_action_),
-  walk_right_action(walk_right_action_),
+  walk_left_action(ActionId(walk_left_action_)),
+  walk_right_action(ActionId(walk_right_action_)),
   walk_speed(80),
   max_drop_height(-1),
   turn_around_timer(),
@@ -44,8 +44,8 @@ WalkingBadguy::WalkingBadguy(const Vector& pos,
                              int layer_,
                              const std::string& light_sprite_name) :
   BadGuy(pos, direction, sprite_name_, layer_, light_sprite_name),
-  walk_left_action(walk_left_action_),
-  walk_right_action(walk_right_action_),
+  walk_left_action(ActionId(walk_left_action_)),
+  walk_right_action(ActionId(walk_right_action_)),
   walk_speed(80),
   max_drop_height(-1),
   turn_around_timer(),
@@ -60,8 +60,8 @@ WalkingBadguy::WalkingBadguy(const ReaderMapping& reader,
                              int layer_,
                              const std::string& light_sprite_name) :
   BadGuy(reader, sprite_name_, layer_, light_sprite_name),
-  walk_left_action(walk_left_action_),
-  walk_right_action(walk_right_action_),
+  walk_left_action(ActionId(walk_left_action_)),
+  walk_right_action(ActionId(walk_right_action_)),
   walk_speed(80),
   max_drop_height(-1),
   turn_around_timer(),
@@ -26,6 +26,8 @@ public:
   Yeti(const ReaderMapping& mapping);
 
   virtual void draw(DrawingContext& context) override;
+  /** The hit points are drawn in screen coordinates */
+  virtual float get_draw_margin() const override { return -1.0f; }
   virtual void initialize() override;
   virtual void active_update(float dt_sec) override;
   virtual void collision_solid(const CollisionHit& hit) override;
@@ -74,6 +74,56 @@ CollisionGroundMovementManager::apply_all_ground_movement()
   m_movements_per_target.clear();
 }
 
+void
+CollisionGroundMovementManager::track_bottom_collisions(CollisionObject& object)
+{
+  m_bottom_collision_objects.insert(&object);
+}
+
+void
+CollisionGroundMovementManager::track_bottom_collisions(TileMap& tilemap)
+{
+  m_bottom_collision_tilemaps.insert(&tilemap);
+}
+
+void
+CollisionGroundMovementManager::untrack_bottom_collisions(CollisionObject& object)
+{
+  m_bottom_collision_objects.erase(&object);
+}
+
+void
+CollisionGroundMovementManager::untrack_bottom_collisions(TileMap& tilemap)
+{
+  m_bottom_collision_tilemaps.erase(&tilemap);
+}
+
+void
+CollisionGroundMovementManager::notify_object_removal(const std::vector<CollisionObject*>& removed)
+{
+  for (auto* object : removed) {
+    m_movements_per_target.erase(object);
+  }
+
+  // Objects that forgot all their bottom collisions since they were
+  // tracked are dropped, they get tracked again on the next hit.
+  for (auto it = m_bottom_collision_objects.begin(); it != m_bottom_collision_objects.end();) {
+    if ((*it)->notify_object_removal(removed)) {
+      ++it;
+    } else {
+      it = m_bottom_collision_objects.erase(it);
+    }
+  }
+
+  for (auto it = m_bottom_collision_tilemaps.begin(); it != m_bottom_collision_tilemaps.end();) {
+    if ((*it)->notify_object_removal(removed)) {
+      ++it;
+    } else {
+      it = m_bottom_collision_tilemaps.erase(it);
+    }
+  }
+}
+
 void
 CollisionGroundMovementManager::TargetMovementData::register_movement(
   CollisionObject& moving_object,
@@ -22,6 +22,8 @@
 #include "math/vector.hpp"
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /**
  * This class takes care of moving objects that have collided on top of other moving
@@ -63,7 +65,9 @@ private:
 public:
 
   CollisionGroundMovementManager() :
-    m_movements_per_target()
+    m_movements_per_target(),
+    m_bottom_collision_objects(),
+    m_bottom_collision_tilemaps()
   {}
 
   void register_movement(CollisionObject& moving_object, CollisionObject& target_object, const Vector& movement);
@@ -76,6 +80,16 @@ public:
       objects does. */
   void apply_all_ground_movement();
 
+  /** Objects and tilemaps are tracked while they remember objects
+      that hit them from above, only those need to hear about removed
+      objects. */
+  void track_bottom_collisions(CollisionObject& object);
+  void track_bottom_collisions(TileMap& tilemap);
+  void untrack_bottom_collisions(CollisionObject& object);
+  void untrack_bottom_collisions(TileMap& tilemap);
+
+  /** Makes all tracked objects and tilemaps forget the removed objects */
+  void notify_object_removal(const std::vector<CollisionObject*>& removed);
 
 private:
 
@@ -83,6 +97,9 @@ private:
       objects that collided on top of them. */
   std::unordered_map<CollisionObject*, TargetMovementData> m_movements_per_target;
 
+  std::unordered_set<CollisionObject*> m_bottom_collision_objects;
+  std::unordered_set<TileMap*> m_bottom_collision_tilemaps;
+
 
 private:
   CollisionGroundMovementManager(const CollisionGroundMovementManager&) = delete;
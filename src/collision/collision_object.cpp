@@ -19,6 +19,7 @@
 
 #include "collision/collision_listener.hpp"
 #include "collision/collision_movement_manager.hpp"
+#include "collision/collision_system.hpp"
 #include "supertux/game_object.hpp"
 
 CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listener) :
@@ -28,10 +29,48 @@ CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listen
   m_movement(0.0f, 0.0f),
   m_dest(),
   m_objects_hit_bottom(),
-  m_ground_movement_manager(nullptr)
+  m_ground_movement_manager(nullptr),
+  m_collision_system(nullptr),
+  m_index(0)
 {
 }
 
+CollisionObject::~CollisionObject()
+{
+  if (m_ground_movement_manager)
+    m_ground_movement_manager->untrack_bottom_collisions(*this);
+}
+
+void
+CollisionObject::set_pos(const Vector& pos)
+{
+  m_dest.move(pos - get_pos());
+  m_bbox.set_pos(pos);
+
+  if (m_collision_system)
+    m_collision_system->object_moved(*this);
+}
+
+void
+CollisionObject::set_width(float w)
+{
+  m_dest.set_width(w);
+  m_bbox.set_width(w);
+
+  if (m_collision_system)
+    m_collision_system->object_moved(*this);
+}
+
+void
+CollisionObject::set_size(float w, float h)
+{
+  m_dest.set_size(w, h);
+  m_bbox.set_size(w, h);
+
+  if (m_collision_system)
+    m_collision_system->object_moved(*this);
+}
+
 void
 CollisionObject::collision_solid(const CollisionHit& hit)
 {
@@ -63,13 +102,20 @@ CollisionObject::collision_moving_object_bottom(CollisionObject& other)
     || m_group == COLGROUP_MOVING_STATIC)
   {
     m_objects_hit_bottom.insert(&other);
+    if (m_ground_movement_manager)
+      m_ground_movement_manager->track_bottom_collisions(*this);
   }
 }
 
-void
-CollisionObject::notify_object_removal(CollisionObject* other)
+bool
+CollisionObject::notify_object_removal(const std::vector<CollisionObject*>& removed)
 {
-  m_objects_hit_bottom.erase(other);
+  for (auto* other : removed) {
+    if (m_objects_hit_bottom.empty())
+      break;
+    m_objects_hit_bottom.erase(other);
+  }
+  return !m_objects_hit_bottom.empty();
 }
 
 void
@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "collision/collision_group.hpp"
 #include "collision/collision_hit.hpp"
@@ -28,6 +29,7 @@
 
 class CollisionListener;
 class CollisionGroundMovementManager;
+class CollisionSystem;
 class GameObject;
 
 class CollisionObject
@@ -36,6 +38,7 @@ class CollisionObject
 
 public:
   CollisionObject(CollisionGroup group, CollisionListener& parent);
+  ~CollisionObject();
 
   /** this function is called when the object collided with something solid */
   void collision_solid(const CollisionHit& hit);
@@ -54,7 +57,9 @@ public:
   /** called when this object, if (moving) static, has collided on its top with a moving object */
   void collision_moving_object_bottom(CollisionObject& other);
 
-  void notify_object_removal(CollisionObject* other);
+  /** Forgets the removed objects, returns false if no object is left
+      touching the top of this object */
+  bool notify_object_removal(const std::vector<CollisionObject*>& removed);
 
   void set_ground_movement_manager(const std::shared_ptr<CollisionGroundMovementManager>& movement_manager)
   {
@@ -84,11 +89,7 @@ public:
   /** places the moving object at a specific position. Be careful when
       using this function. There are no collision detection checks
       performed here so bad things could happen. */
-  void set_pos(const Vector& pos)
-  {
-    m_dest.move(pos - get_pos());
-    m_bbox.set_pos(pos);
-  }
+  void set_pos(const Vector& pos);
 
   Vector get_pos() const
   {
@@ -106,20 +107,12 @@ public:
   /** sets the moving object's bbox to a specific width. Be careful
       when using this function. There are no collision detection
       checks performed here so bad things could happen. */
-  void set_width(float w)
-  {
-    m_dest.set_width(w);
-    m_bbox.set_width(w);
-  }
+  void set_width(float w);
 
   /** sets the moving object's bbox to a specific size. Be careful
       when using this function. There are no collision detection
       checks performed here so bad things could happen. */
-  void set_size(float w, float h)
-  {
-    m_dest.set_size(w, h);
-    m_bbox.set_size(w, h);
-  }
+  void set_size(float w, float h);
 
   CollisionGroup get_group() const
   {
@@ -161,6 +154,12 @@ private:
 
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
+  /** The CollisionSystem the object was added to, nullptr if none */
+  CollisionSystem* m_collision_system;
+
+  /** Position in the object list of the CollisionSystem */
+  size_t m_index;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
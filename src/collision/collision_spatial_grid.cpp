@@ -0,0 +1,255 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_spatial_grid.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+#include "math/rectf.hpp"
+
+namespace {
+
+/** Cell coordinates are clamped to this range so that objects at
+    absurd (or non-finite) positions can't overflow the cell keys. */
+const float MAX_CELL_COORD = 1048576.0f;
+
+int to_cell(float v, float cell_size)
+{
+  const float cell = floorf(v / cell_size);
+  if (!(cell > -MAX_CELL_COORD))
+    return -static_cast<int>(MAX_CELL_COORD);
+  if (!(cell < MAX_CELL_COORD))
+    return static_cast<int>(MAX_CELL_COORD);
+  return static_cast<int>(cell);
+}
+
+} // namespace
+
+CollisionSpatialGrid::CollisionSpatialGrid(float cell_size) :
+  m_cell_size(cell_size),
+  m_entries(),
+  m_free_entries(),
+  m_slots(),
+  m_cells(),
+  m_oversized(),
+  m_next_order(0),
+  m_stamp(0),
+  m_query_entries()
+{
+  assert(m_cell_size > 0.0f);
+}
+
+CollisionSpatialGrid::CellRange
+CollisionSpatialGrid::get_cells(const Rectf& rect) const
+{
+  const float x1 = std::min(rect.get_left(), rect.get_right());
+  const float x2 = std::max(rect.get_left(), rect.get_right());
+  const float y1 = std::min(rect.get_top(), rect.get_bottom());
+  const float y2 = std::max(rect.get_top(), rect.get_bottom());
+
+  return CellRange{ to_cell(x1, m_cell_size), to_cell(y1, m_cell_size),
+                    to_cell(x2, m_cell_size), to_cell(y2, m_cell_size) };
+}
+
+void
+CollisionSpatialGrid::insert(CollisionObject& object, const Rectf& rect)
+{
+  assert(m_slots.find(&object) == m_slots.end());
+
+  size_t slot;
+  if (m_free_entries.empty()) {
+    slot = m_entries.size();
+    m_entries.push_back(Entry());
+  } else {
+    slot = m_free_entries.back();
+    m_free_entries.pop_back();
+  }
+
+  Entry& entry = m_entries[slot];
+  entry.object = &object;
+  entry.order = m_next_order++;
+  entry.cells = get_cells(rect);
+  entry.oversized = false;
+  entry.stamp = 0;
+
+  m_slots[&object] = slot;
+  bin(slot);
+}
+
+void
+CollisionSpatialGrid::remove(CollisionObject& object)
+{
+  auto it = m_slots.find(&object);
+  if (it == m_slots.end())
+    return;
+
+  const size_t slot = it->second;
+  unbin(slot);
+  m_entries[slot].object = nullptr;
+  m_free_entries.push_back(slot);
+  m_slots.erase(it);
+}
+
+void
+CollisionSpatialGrid::update(CollisionObject& object, const Rectf& rect)
+{
+  auto it = m_slots.find(&object);
+  if (it == m_slots.end())
+    return;
+
+  const size_t slot = it->second;
+  const CellRange cells = get_cells(rect);
+  if (cells == m_entries[slot].cells)
+    return;
+
+  unbin(slot);
+  m_entries[slot].cells = cells;
+  bin(slot);
+}
+
+void
+CollisionSpatialGrid::query(const Rectf& rect, std::vector<CollisionObject*>& result) const
+{
+  // A new stamp marks every entry as "not yet seen" for this query.
+  if (++m_stamp == 0) {
+    for (const auto& entry : m_entries)
+      entry.stamp = 0;
+    m_stamp = 1;
+  }
+
+  m_query_entries.clear();
+
+  const CellRange cells = get_cells(rect);
+  const int64_t cell_count = (static_cast<int64_t>(cells.right) - cells.left + 1) *
+                             (static_cast<int64_t>(cells.bottom) - cells.top + 1);
+
+  if (cell_count > static_cast<int64_t>(m_cells.size())) {
+    // The query covers more cells than have ever been used, walking
+    // those is cheaper than walking the query area.
+    for (const auto& cell : m_cells) {
+      const int x = static_cast<int32_t>(static_cast<uint32_t>(cell.first >> 32));
+      const int y = static_cast<int32_t>(static_cast<uint32_t>(cell.first & 0xffffffffu));
+      if (x < cells.left || x > cells.right || y < cells.top || y > cells.bottom)
+        continue;
+
+      for (const size_t slot : cell.second) {
+        const Entry& entry = m_entries[slot];
+        if (entry.stamp != m_stamp) {
+          entry.stamp = m_stamp;
+          m_query_entries.push_back(&entry);
+        }
+      }
+    }
+  } else {
+    for (int y = cells.top; y <= cells.bottom; ++y) {
+      for (int x = cells.left; x <= cells.right; ++x) {
+        auto it = m_cells.find(cell_key(x, y));
+        if (it == m_cells.end())
+          continue;
+
+        for (const size_t slot : it->second) {
+          const Entry& entry = m_entries[slot];
+          if (entry.stamp != m_stamp) {
+            entry.stamp = m_stamp;
+            m_query_entries.push_back(&entry);
+          }
+        }
+      }
+    }
+  }
+
+  for (const size_t slot : m_oversized) {
+    m_query_entries.push_back(&m_entries[slot]);
+  }
+
+  std::sort(m_query_entries.begin(), m_query_entries.end(),
+            [](const Entry* lhs, const Entry* rhs) {
+              return lhs->order < rhs->order;
+            });
+
+  for (const auto* entry : m_query_entries) {
+    result.push_back(entry->object);
+  }
+}
+
+void
+CollisionSpatialGrid::clear()
+{
+  m_entries.clear();
+  m_free_entries.clear();
+  m_slots.clear();
+  m_cells.clear();
+  m_oversized.clear();
+}
+
+uint64_t
+CollisionSpatialGrid::get_order(const CollisionObject& object) const
+{
+  auto it = m_slots.find(&object);
+  assert(it != m_slots.end());
+  return m_entries[it->second].order;
+}
+
+void
+CollisionSpatialGrid::bin(size_t slot)
+{
+  Entry& entry = m_entries[slot];
+  const CellRange& cells = entry.cells;
+  const int64_t cell_count = (static_cast<int64_t>(cells.right) - cells.left + 1) *
+                             (static_cast<int64_t>(cells.bottom) - cells.top + 1);
+
+  if (cell_count > MAX_CELLS_PER_OBJECT) {
+    entry.oversized = true;
+    m_oversized.push_back(slot);
+    return;
+  }
+
+  entry.oversized = false;
+  for (int y = cells.top; y <= cells.bottom; ++y) {
+    for (int x = cells.left; x <= cells.right; ++x) {
+      m_cells[cell_key(x, y)].push_back(slot);
+    }
+  }
+}
+
+void
+CollisionSpatialGrid::unbin(size_t slot)
+{
+  Entry& entry = m_entries[slot];
+
+  if (entry.oversized) {
+    m_oversized.erase(std::find(m_oversized.begin(), m_oversized.end(), slot));
+    return;
+  }
+
+  const CellRange& cells = entry.cells;
+  for (int y = cells.top; y <= cells.bottom; ++y) {
+    for (int x = cells.left; x <= cells.right; ++x) {
+      auto it = m_cells.find(cell_key(x, y));
+      assert(it != m_cells.end());
+
+      auto& slots = it->second;
+      auto slot_it = std::find(slots.begin(), slots.end(), slot);
+      assert(slot_it != slots.end());
+      *slot_it = slots.back();
+      slots.pop_back();
+    }
+  }
+}
+
+/* EOF */
@@ -0,0 +1,127 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_COLLISION_COLLISION_SPATIAL_GRID_HPP
+#define HEADER_SUPERTUX_COLLISION_COLLISION_SPATIAL_GRID_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+class CollisionObject;
+class Rectf;
+
+/**
+ * Uniform grid used as the broad-phase of the CollisionSystem.
+ *
+ * Every object is binned into all cells its rectangle touches. Queries
+ * return the objects of all cells touched by the query rectangle in
+ * the order in which they were inserted, so callers iterating the
+ * result see the same order as when iterating the full object list.
+ * The result is conservative: callers still have to do the exact
+ * intersection test.
+ */
+class CollisionSpatialGrid final
+{
+private:
+  struct CellRange
+  {
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    bool operator==(const CellRange& other) const
+    {
+      return left == other.left && top == other.top &&
+             right == other.right && bottom == other.bottom;
+    }
+  };
+
+  struct Entry
+  {
+    CollisionObject* object;
+    uint64_t order;
+    CellRange cells;
+
+    /** Objects spanning too many cells are kept out of the grid and
+        are returned by every query instead. */
+    bool oversized;
+
+    /** Query stamp, used to avoid returning an object twice */
+    mutable uint32_t stamp;
+  };
+
+public:
+  /** Objects touching more cells than this are not binned. */
+  static const int MAX_CELLS_PER_OBJECT = 256;
+
+public:
+  CollisionSpatialGrid(float cell_size = 128.0f);
+
+  void insert(CollisionObject& object, const Rectf& rect);
+  void remove(CollisionObject& object);
+
+  /** Rebins the object if its rectangle now touches other cells
+      than before, does nothing otherwise. */
+  void update(CollisionObject& object, const Rectf& rect);
+
+  /** Appends all objects that might overlap `rect` to `result`,
+      sorted by insertion order. */
+  void query(const Rectf& rect, std::vector<CollisionObject*>& result) const;
+
+  void clear();
+
+  size_t size() const { return m_slots.size(); }
+  float get_cell_size() const { return m_cell_size; }
+
+  /** Insertion order of the object, as used for sorting query results */
+  uint64_t get_order(const CollisionObject& object) const;
+
+private:
+  CellRange get_cells(const Rectf& rect) const;
+  void bin(size_t slot);
+  void unbin(size_t slot);
+
+  static uint64_t cell_key(int x, int y)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+            static_cast<uint64_t>(static_cast<uint32_t>(y));
+  }
+
+private:
+  float m_cell_size;
+
+  std::vector<Entry> m_entries;
+  std::vector<size_t> m_free_entries;
+  std::unordered_map<const CollisionObject*, size_t> m_slots;
+
+  std::unordered_map<uint64_t, std::vector<size_t> > m_cells;
+  std::vector<size_t> m_oversized;
+
+  uint64_t m_next_order;
+  mutable uint32_t m_stamp;
+  mutable std::vector<const Entry*> m_query_entries;
+
+private:
+  CollisionSpatialGrid(const CollisionSpatialGrid&) = delete;
+  CollisionSpatialGrid& operator=(const CollisionSpatialGrid&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -17,6 +17,8 @@
 
 #include "collision/collision_system.hpp"
 
+#include <assert.h>
+
 #include "collision/collision.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "editor/editor.hpp"
@@ -24,9 +26,11 @@
 #include "math/rect.hpp"
 #include "object/player.hpp"
 #include "object/tilemap.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
+#include "util/profiler.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 
@@ -34,11 +38,73 @@ namespace {
 
 const float MAX_SPEED = 16.0f;
 
+/** Margin added to the grid queries of the public query functions.
+    During update() the grid holds the destination rectangles, which
+    can be a frame worth of movement away from the bounding boxes. */
+const float QUERY_MARGIN = 2.0f * MAX_SPEED;
+
+/** Walks the tiles of `solids` that the line passes through, using a
+    DDA traversal, and returns true if one of them is solid. */
+bool line_hits_solid_tile(const TileMap& solids, const Vector& line_start, const Vector& line_end)
+{
+  const Vector start = (line_start - solids.get_offset()) / 32.0f;
+  const Vector end = (line_end - solids.get_offset()) / 32.0f;
+  const Vector dir = end - start;
+
+  int x = static_cast<int>(floorf(start.x));
+  int y = static_cast<int>(floorf(start.y));
+  const int end_x = static_cast<int>(floorf(end.x));
+  const int end_y = static_cast<int>(floorf(end.y));
+
+  const float infinity = std::numeric_limits<float>::infinity();
+
+  const int step_x = (dir.x > 0.0f) ? 1 : ((dir.x < 0.0f) ? -1 : 0);
+  const int step_y = (dir.y > 0.0f) ? 1 : ((dir.y < 0.0f) ? -1 : 0);
+
+  // distance along the line (in units of its length) between two vertical/horizontal tile borders
+  const float t_delta_x = step_x ? 1.0f / fabsf(dir.x) : infinity;
+  const float t_delta_y = step_y ? 1.0f / fabsf(dir.y) : infinity;
+
+  // distance along the line to the next vertical/horizontal tile border
+  float t_max_x = (step_x > 0) ? (static_cast<float>(x + 1) - start.x) * t_delta_x :
+                  (step_x < 0) ? (start.x - static_cast<float>(x)) * t_delta_x : infinity;
+  float t_max_y = (step_y > 0) ? (static_cast<float>(y + 1) - start.y) * t_delta_y :
+                  (step_y < 0) ? (start.y - static_cast<float>(y)) * t_delta_y : infinity;
+
+  const int steps = abs(end_x - x) + abs(end_y - y);
+  for (int i = 0; i <= steps; ++i)
+  {
+    if (x >= 0 && y >= 0 && x < solids.get_width() && y < solids.get_height())
+    {
+      const Tile& tile = solids.get_tile(x, y);
+      // FIXME: check collision with slope tiles
+      if (tile.get_attributes() & Tile::SOLID)
+        return true;
+    }
+
+    if (t_max_x < t_max_y) {
+      x += step_x;
+      t_max_x += t_delta_x;
+    } else {
+      y += step_y;
+      t_max_y += t_delta_y;
+    }
+  }
+
+  return false;
+}
+
 } // namespace
 
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
   m_objects(),
+  m_removed_objects(),
+  m_grid(),
+  m_grid_uses_dest(false),
+  m_static_candidates(),
+  m_candidates(),
+  m_query_candidates(),
   m_ground_movement_manager(new CollisionGroundMovementManager)
 {
 }
@@ -47,23 +113,47 @@ void
 CollisionSystem::add(CollisionObject* object)
 {
   object->set_ground_movement_manager(m_ground_movement_manager);
+  object->m_collision_system = this;
+  object->m_index = m_objects.size();
   m_objects.push_back(object);
+  m_grid.insert(*object, object->get_bbox());
 }
 
 void
 CollisionSystem::remove(CollisionObject* object)
 {
-  m_objects.erase(
-    std::find(m_objects.begin(), m_objects.end(),
-              object));
-  
-  // FIXME: this is a patch. A better way of fixing this is coming.
-  for (auto* collision_object : m_objects) {
-    collision_object->notify_object_removal(object);
-  }
-  for (auto* tilemap : m_sector.get_solid_tilemaps()) {
-    tilemap->notify_object_removal(object);
+  assert(object->m_index < m_objects.size() && m_objects[object->m_index] == object);
+
+  // The slot is only cleared, compacting once per batch keeps the
+  // order of the remaining objects, which collision response and the
+  // grid queries depend on.
+  m_objects[object->m_index] = nullptr;
+  m_grid.remove(*object);
+  object->m_collision_system = nullptr;
+
+  m_ground_movement_manager->untrack_bottom_collisions(*object);
+  object->clear_bottom_collision_list();
+
+  m_removed_objects.push_back(object);
+}
+
+void
+CollisionSystem::flush_removals()
+{
+  if (m_removed_objects.empty())
+    return;
+
+  size_t count = 0;
+  for (auto* object : m_objects) {
+    if (object) {
+      object->m_index = count;
+      m_objects[count++] = object;
+    }
   }
+  m_objects.resize(count);
+
+  m_ground_movement_manager->notify_object_removal(m_removed_objects);
+  m_removed_objects.clear();
 }
 
 void
@@ -75,6 +165,9 @@ CollisionSystem::draw(DrawingContext& context)
   const Color cyan(0.0f, 1.0f, 1.0f, 0.75f);
   const Color orange(1.0f, 0.5f, 0.0f, 0.75f);
   const Color green_bright(0.7f, 1.0f, 0.7f, 0.75f);
+
+  flush_removals();
+
   for (auto& object : m_objects) {
     Color color;
     switch (object->get_group()) {
@@ -325,7 +418,7 @@ static void get_hit_normal(const Rectf& r1, const Rectf& r2, CollisionHit& hit,
 }
 
 void
-CollisionSystem::collision_object(CollisionObject* object1, CollisionObject* object2) const
+CollisionSystem::collision_object(CollisionObject* object1, CollisionObject* object2)
 {
   using namespace collision;
 
@@ -372,7 +465,10 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
   collision_tilemap(constraints, movement, dest, object);
 
   // collision with other (static) objects
-  for (auto* static_object : m_objects)
+  m_static_candidates.clear();
+  m_grid.query(dest.grown(EPSILON), m_static_candidates);
+
+  for (auto* static_object : m_static_candidates)
   {
     if ((
           static_object->get_group() == COLGROUP_STATIC ||
@@ -509,9 +605,28 @@ CollisionSystem::collision_static_constrains(CollisionObject& object)
   }
 }
 
+void
+CollisionSystem::object_moved(CollisionObject& object)
+{
+  m_grid.update(object, m_grid_uses_dest ? object.m_dest : object.get_bbox());
+}
+
+void
+CollisionSystem::update_grid()
+{
+  for (auto* object : m_objects) {
+    m_grid.update(*object, object->m_dest);
+  }
+}
+
 void
 CollisionSystem::update()
 {
+  PROFILE_ZONE("CollisionSystem::update");
+  BenchmarkTimer benchmark_timer("CollisionSystem::update");
+
+  flush_removals();
+
   if (Editor::is_active()) {
     return;
     //Objects in editor shouldn't collide.
@@ -536,6 +651,9 @@ CollisionSystem::update()
     object->clear_bottom_collision_list();
   }
 
+  update_grid();
+  m_grid_uses_dest = true;
+
   // part1: COLGROUP_MOVING vs COLGROUP_STATIC and tilemap
   for (const auto& object : m_objects) {
     if ((object->get_group() != COLGROUP_MOVING
@@ -545,6 +663,7 @@ CollisionSystem::update()
       continue;
 
     collision_static_constrains(*object);
+    m_grid.update(*object, object->m_dest);
   }
 
   // part2: COLGROUP_MOVING vs tile attributes
@@ -569,7 +688,10 @@ CollisionSystem::update()
        || !object->is_valid())
       continue;
 
-    for (auto& object_2 : m_objects) {
+    m_candidates.clear();
+    m_grid.query(object->m_dest, m_candidates);
+
+    for (auto& object_2 : m_candidates) {
       if (object_2->get_group() != COLGROUP_TOUCHABLE
          || !object_2->is_valid())
         continue;
@@ -591,30 +713,69 @@ CollisionSystem::update()
   }
 
   // part3: COLGROUP_MOVING vs COLGROUP_MOVING
-  for (auto i = m_objects.begin(); i != m_objects.end(); ++i)
-  {
-    auto object = *i;
+  collision_moving_objects(m_objects, m_grid, m_candidates);
 
+  // apply object movement
+  for (auto* object : m_objects) {
+    object->m_bbox = object->m_dest;
+    object->m_movement = Vector(0, 0);
+    m_grid.update(*object, object->m_dest);
+  }
+  m_grid_uses_dest = false;
+}
+
+void
+CollisionSystem::collision_moving_objects(const std::vector<CollisionObject*>& objects,
+                                          CollisionSpatialGrid& grid,
+                                          std::vector<CollisionObject*>& candidates)
+{
+  for (auto* object : objects)
+  {
     if ((object->get_group() != COLGROUP_MOVING
         && object->get_group() != COLGROUP_MOVING_STATIC)
        || !object->is_valid())
       continue;
 
-    for (auto i2 = i+1; i2 != m_objects.end(); ++i2) {
+    // Query results are sorted in insertion order, so only the
+    // candidates after the object itself are left to be checked.
+    const uint64_t object_order = grid.get_order(*object);
+    const auto after = [&grid](uint64_t order) {
+      return [&grid, order](const CollisionObject* candidate) {
+        return grid.get_order(*candidate) > order;
+      };
+    };
+
+    candidates.clear();
+    grid.query(object->m_dest, candidates);
+    auto i2 = std::find_if(candidates.begin(), candidates.end(), after(object_order));
+
+    while (i2 != candidates.end()) {
       auto object_2 = *i2;
+      ++i2;
+
       if ((object_2->get_group() != COLGROUP_MOVING
           && object_2->get_group() != COLGROUP_MOVING_STATIC)
          || !object_2->is_valid())
         continue;
 
+      const Rectf old_dest = object->m_dest;
       collision_object(object, object_2);
-    }
-  }
 
-  // apply object movement
-  for (auto* object : m_objects) {
-    object->m_bbox = object->m_dest;
-    object->m_movement = Vector(0, 0);
+      // The response can push either object, both have to stay binned
+      // where they are now for the following queries.
+      grid.update(*object, object->m_dest);
+      grid.update(*object_2, object_2->m_dest);
+
+      if (object->m_dest == old_dest)
+        continue;
+
+      // The object was pushed, so the objects it has to be checked
+      // against might have changed. Continue with a fresh query from
+      // where we left off.
+      candidates.clear();
+      grid.query(object->m_dest, candidates);
+      i2 = std::find_if(candidates.begin(), candidates.end(), after(grid.get_order(*object_2)));
+    }
   }
 }
 
@@ -659,7 +820,10 @@ CollisionSystem::is_free_of_statics(const Rectf& rect, const CollisionObject* ig
 
   if (!is_free_of_tiles(rect, ignoreUnisolid)) return false;
 
-  for (const auto& object : m_objects) {
+  m_query_candidates.clear();
+  m_grid.query(rect.grown(QUERY_MARGIN), m_query_candidates);
+
+  for (const auto& object : m_query_candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->get_group() == COLGROUP_STATIC) {
@@ -677,7 +841,10 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const CollisionObje
 
   if (!is_free_of_tiles(rect)) return false;
 
-  for (const auto& object : m_objects) {
+  m_query_candidates.clear();
+  m_grid.query(rect.grown(QUERY_MARGIN), m_query_candidates);
+
+  for (const auto& object : m_query_candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -696,32 +863,24 @@ CollisionSystem::free_line_of_sight(const Vector& line_start, const Vector& line
   using namespace collision;
 
   // check if no tile is in the way
-  const float lsx = std::min(line_start.x, line_end.x);
-  const float lex = std::max(line_start.x, line_end.x);
-  const float lsy = std::min(line_start.y, line_end.y);
-  const float ley = std::max(line_start.y, line_end.y);
-
-  for (float test_x = lsx; test_x <= lex; test_x += 16) { // NOLINT
-    for (float test_y = lsy; test_y <= ley; test_y += 16) { // NOLINT
-      for (const auto& solids : m_sector.get_solid_tilemaps()) {
-        const auto& test_vector = Vector(test_x, test_y);
-        if(solids->is_outside_bounds(test_vector))
-        {
-          continue;
-        }
-        
-        const Tile& tile = solids->get_tile_at(test_vector);
-        // FIXME: check collision with slope tiles
-        if ((tile.get_attributes() & Tile::SOLID)) return false;
-      }
-    }
+  for (const auto& solids : m_sector.get_solid_tilemaps()) {
+    if (line_hits_solid_tile(*solids, line_start, line_end))
+      return false;
   }
 
   if (ignore_objects)
     return true;
 
   // check if no object is in the way
-  for (const auto& object : m_objects) {
+  const Rectf line_rect(std::min(line_start.x, line_end.x),
+                        std::min(line_start.y, line_end.y),
+                        std::max(line_start.x, line_end.x),
+                        std::max(line_start.y, line_end.y));
+
+  m_query_candidates.clear();
+  m_grid.query(line_rect.grown(QUERY_MARGIN), m_query_candidates);
+
+  for (const auto& object : m_query_candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -738,8 +897,18 @@ std::vector<CollisionObject*>
 CollisionSystem::get_nearby_objects (const Vector& center, float max_distance) const
 {
   std::vector<CollisionObject*> ret;
+  if (max_distance < 0.0f)
+    return ret;
 
-  for (const auto& object : m_objects) {
+  // The middle of the bbox, which the distance is measured from, is
+  // inside of it, so anything in range touches this rectangle.
+  const Rectf area(center.x - max_distance, center.y - max_distance,
+                   center.x + max_distance, center.y + max_distance);
+
+  std::vector<CollisionObject*> candidates;
+  m_grid.query(area.grown(QUERY_MARGIN), candidates);
+
+  for (const auto& object : candidates) {
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include "collision/collision.hpp"
+#include "collision/collision_spatial_grid.hpp"
 #include "supertux/tile.hpp"
 #include "math/fwd.hpp"
 
@@ -38,8 +39,21 @@ public:
   CollisionSystem(Sector& sector);
 
   void add(CollisionObject* object);
+
+  /** Takes the object out of collision detection in O(1), the other
+      objects only forget about it with the next flush_removals() */
   void remove(CollisionObject* object);
 
+  /** Rebins the object in the broad-phase grid, called by the object
+      when it is moved or resized outside of the collision response */
+  void object_moved(CollisionObject& object);
+
+  /** Compacts the object list and notifies the objects and tilemaps
+      that still hold references once for all objects removed since
+      the last call. Called by the Sector after each batch of object
+      removals. */
+  void flush_removals();
+
   /** Draw collision shapes for debugging */
   void draw(DrawingContext& context);
 
@@ -60,6 +74,14 @@ public:
 
   std::vector<CollisionObject*> get_nearby_objects(const Vector& center, float max_distance) const;
 
+  /** Collision response between all COLGROUP_MOVING and
+      COLGROUP_MOVING_STATIC objects of `objects`, part of update().
+      All objects have to be in `grid`, binned by their destination
+      rectangle, and are kept so when they get pushed. */
+  static void collision_moving_objects(const std::vector<CollisionObject*>& objects,
+                                       CollisionSpatialGrid& grid,
+                                       std::vector<CollisionObject*>& candidates);
+
 private:
   /** Does collision detection of an object against all other static
       objects (and the tilemap) in the level. Collision response is
@@ -79,14 +101,35 @@ private:
 
   uint32_t collision_tile_attributes(const Rectf& dest, const Vector& mov) const;
 
-  void collision_object(CollisionObject* object1, CollisionObject* object2) const;
+  static void collision_object(CollisionObject* object1, CollisionObject* object2);
 
   void collision_static_constrains(CollisionObject& object);
 
+  /** Brings the broad-phase grid in sync with the current
+      destination rectangles of all objects */
+  void update_grid();
+
 private:
   Sector& m_sector;
 
+  /** Objects in the order they were added, removed objects are
+      nullptr until the next flush_removals() */
   std::vector<CollisionObject*>  m_objects;
+  std::vector<CollisionObject*> m_removed_objects;
+
+  /** Broad-phase, holds the objects binned by m_dest during update()
+      and by their bbox otherwise */
+  CollisionSpatialGrid m_grid;
+
+  /** Whether the grid is binned by m_dest */
+  bool m_grid_uses_dest;
+
+  /** Scratch buffers for the grid queries of update() */
+  std::vector<CollisionObject*> m_static_candidates;
+  std::vector<CollisionObject*> m_candidates;
+
+  /** Scratch buffer for the is_free_of_*() and line of sight queries */
+  mutable std::vector<CollisionObject*> m_query_candidates;
 
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
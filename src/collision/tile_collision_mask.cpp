@@ -0,0 +1,94 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "collision/tile_collision_mask.hpp"
+
+#include <assert.h>
+
+TileCollisionMask::TileCollisionMask() :
+  m_rect(),
+  m_stride(0),
+  m_bits()
+{
+}
+
+void
+TileCollisionMask::reset(const Rect& tiles)
+{
+  m_rect = tiles;
+  if (m_rect.right < m_rect.left)
+    m_rect.right = m_rect.left;
+  if (m_rect.bottom < m_rect.top)
+    m_rect.bottom = m_rect.top;
+
+  m_stride = (m_rect.get_width() + 63) / 64;
+  m_bits.assign(static_cast<size_t>(m_stride) * static_cast<size_t>(m_rect.get_height()), 0);
+}
+
+void
+TileCollisionMask::set(int x, int y)
+{
+  assert(covers(x, y, x + 1, y + 1));
+
+  const int col = x - m_rect.left;
+  const int row = y - m_rect.top;
+  m_bits[row * m_stride + col / 64] |= uint64_t(1) << (col % 64);
+}
+
+bool
+TileCollisionMask::covers(int left, int top, int right, int bottom) const
+{
+  return left >= m_rect.left && top >= m_rect.top &&
+         right <= m_rect.right && bottom <= m_rect.bottom;
+}
+
+bool
+TileCollisionMask::any(int left, int top, int right, int bottom) const
+{
+  assert(covers(left, top, right, bottom));
+
+  if (right <= left || bottom <= top)
+    return false;
+
+  const int first_col = left - m_rect.left;
+  const int last_col = right - 1 - m_rect.left;
+  const int first_word = first_col / 64;
+  const int last_word = last_col / 64;
+  const uint64_t first_mask = ~uint64_t(0) << (first_col % 64);
+  const uint64_t last_mask = ~uint64_t(0) >> (63 - last_col % 64);
+
+  for (int row = top - m_rect.top; row < bottom - m_rect.top; ++row)
+  {
+    const uint64_t* words = &m_bits[row * m_stride];
+    if (first_word == last_word) {
+      if (words[first_word] & first_mask & last_mask)
+        return true;
+    } else {
+      if (words[first_word] & first_mask)
+        return true;
+      for (int word = first_word + 1; word < last_word; ++word) {
+        if (words[word])
+          return true;
+      }
+      if (words[last_word] & last_mask)
+        return true;
+    }
+  }
+  return false;
+}
+
+/* EOF */
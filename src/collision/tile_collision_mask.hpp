@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_COLLISION_TILE_COLLISION_MASK_HPP
+#define HEADER_SUPERTUX_COLLISION_TILE_COLLISION_MASK_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "math/rect.hpp"
+
+/**
+ * One bit per tile in a rectangle of tile indices, set for tiles that
+ * something can collide with.
+ *
+ * Built once per frame from the solid tilemaps, it lets code that tests
+ * many small rectangles against the tiles, like particles do, skip the
+ * per-tile lookups for all rectangles that don't touch a set tile.
+ */
+class TileCollisionMask final
+{
+public:
+  TileCollisionMask();
+
+  /** Clears the mask and makes it cover `tiles`, right and bottom
+      exclusive */
+  void reset(const Rect& tiles);
+
+  /** Marks tile x, y, which has to be covered by the mask */
+  void set(int x, int y);
+
+  /** Whether the tiles [left, right) x [top, bottom) are all covered
+      by the mask */
+  bool covers(int left, int top, int right, int bottom) const;
+
+  /** Whether any tile in [left, right) x [top, bottom) is set, the
+      range has to be covered by the mask */
+  bool any(int left, int top, int right, int bottom) const;
+
+  const Rect& get_rect() const { return m_rect; }
+
+private:
+  Rect m_rect;
+
+  /** 64 bit words per row */
+  int m_stride;
+  std::vector<uint64_t> m_bits;
+
+private:
+  TileCollisionMask(const TileCollisionMask&) = delete;
+  TileCollisionMask& operator=(const TileCollisionMask&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -43,6 +43,8 @@
 #include "gui/mousecursor.hpp"
 #include "math/util.hpp"
 #include "object/camera.hpp"
+#include "object/path_gameobject.hpp"
+#include "object/path_object.hpp"
 #include "object/player.hpp"
 #include "object/spawnpoint.hpp"
 #include "object/tilemap.hpp"
@@ -112,7 +114,8 @@ Editor::Editor() :
   m_layers_widget(),
   m_enabled(false),
   m_bgr_surface(Surface::from_file("images/engine/menu/bg_editor.png")),
-  m_undo_manager(new UndoManager),
+  m_undo_manager(new UndoManager(g_config->editor_undo_deltas,
+                                 static_cast<size_t>(std::max(g_config->editor_undo_memory, 1)) * 1024 * 1024)),
   m_ignore_sector_change(false),
   m_level_first_loaded(false),
   m_time_since_last_save(0.f),
@@ -505,6 +508,19 @@ Editor::set_level(std::unique_ptr<Level> level, bool reset)
     m_tileset = TileManager::current()->get_tileset(m_level->get_tileset());
   }
 
+  enter_sector(sector_name, reset ? boost::none : boost::optional<Vector>(translation));
+
+  if (!m_level_first_loaded)
+  {
+    m_undo_manager->try_snapshot(*m_level);
+    m_undo_manager->reset_index();
+    m_level_first_loaded = true;
+  }
+}
+
+void
+Editor::enter_sector(const std::string& sector_name, const boost::optional<Vector>& translation)
+{
   load_sector(sector_name);
 
   if (m_sector != nullptr)
@@ -512,21 +528,14 @@ Editor::set_level(std::unique_ptr<Level> level, bool reset)
     m_sector->activate(sector_name);
     m_sector->get_camera().set_mode(Camera::Mode::MANUAL);
 
-    if (!reset) {
-      m_sector->get_camera().set_translation(translation);
+    if (translation) {
+      m_sector->get_camera().set_translation(*translation);
     }
   }
 
   m_layers_widget->refresh_sector_text();
   m_toolbox_widget->update_mouse_icon();
   m_overlay_widget->on_level_change();
-  
-  if (!m_level_first_loaded)
-  {
-    m_undo_manager->try_snapshot(*m_level);
-    m_undo_manager->reset_index();
-    m_level_first_loaded = true;
-  }
 }
 
 void
@@ -747,6 +756,8 @@ Editor::event(const SDL_Event& ev)
     {
       if (!m_ignore_sector_change) {
         if (m_level) {
+          // Objects added during this event only show up after a flush
+          m_sector->flush_game_objects();
           m_undo_manager->try_snapshot(*m_level);
         }
       }
@@ -868,28 +879,87 @@ void
 Editor::undo()
 {
   log_info << "attempting undo" << std::endl;
-  auto level = m_undo_manager->undo();
+  if (!m_sector || !m_undo_manager->can_undo()) {
+    log_info << "undo failed" << std::endl;
+    return;
+  }
+
+  const std::string sector_name = m_sector->get_name();
+  const Vector translation = m_sector->get_camera().get_translation();
+  delete_markers();
+  m_sector->flush_game_objects();
+
+  auto level = m_undo_manager->undo(*m_level);
   if (level) {
     set_level(std::move(level), false);
-    m_ignore_sector_change = true;
   } else {
-    log_info << "undo failed" << std::endl;
+    on_level_changed(sector_name, translation);
   }
+  m_ignore_sector_change = true;
 }
 
 void
 Editor::redo()
 {
   log_info << "attempting redo" << std::endl;
-  auto level = m_undo_manager->redo();
+  if (!m_sector || !m_undo_manager->can_redo()) {
+    log_info << "redo failed" << std::endl;
+    return;
+  }
+
+  const std::string sector_name = m_sector->get_name();
+  const Vector translation = m_sector->get_camera().get_translation();
+  delete_markers();
+  m_sector->flush_game_objects();
+
+  auto level = m_undo_manager->redo(*m_level);
   if (level) {
     set_level(std::move(level), false);
-    m_ignore_sector_change = true;
   } else {
-    log_info << "redo failed" << std::endl;
+    on_level_changed(sector_name, translation);
+  }
+  m_ignore_sector_change = true;
+}
+
+void
+Editor::object_changed(const GameObject& object)
+{
+  if (!m_sector)
+    return;
+
+  m_undo_manager->object_changed(*m_sector, object);
+
+  // Objects on a path drag their path along when they are moved
+  auto* path_object = dynamic_cast<const PathObject*>(&object);
+  if (path_object)
+  {
+    BIND_SECTOR(*m_sector);
+    if (auto* path = path_object->get_path_gameobject()) {
+      m_undo_manager->object_changed(*m_sector, *path);
+    }
+  }
+}
+
+void
+Editor::sector_changed()
+{
+  if (m_sector) {
+    m_undo_manager->sector_changed(*m_sector);
   }
 }
 
+void
+Editor::on_level_changed(const std::string& sector_name, const Vector& translation)
+{
+  // The level was changed in place, objects and sectors may have been
+  // replaced under the widgets.
+  if (m_tileset != TileManager::current()->get_tileset(m_level->get_tileset())) {
+    change_tileset();
+  }
+
+  enter_sector(sector_name, translation);
+}
+
 IntegrationStatus
 Editor::get_status() const
 {
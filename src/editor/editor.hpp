@@ -153,12 +153,24 @@ public:
   void undo();
   void redo();
 
+  /** Tells the undo history that `object` in the current sector was
+      changed, see UndoManager::object_changed() */
+  void object_changed(const GameObject& object);
+  void sector_changed();
+
   void pack_addon();
 
 private:
   void set_sector(Sector* sector);
   void set_level(std::unique_ptr<Level> level, bool reset = true);
   void reload_level();
+
+  /** Switches to the given sector, or the first one if it doesn't
+      exist, and resets all widgets that refer to its objects. */
+  void enter_sector(const std::string& sector_name, const boost::optional<Vector>& translation);
+
+  /** Called after undo or redo changed the current level in place */
+  void on_level_changed(const std::string& sector_name, const Vector& translation);
   void quit_editor();
   /**
    * @param filename    If non-empty, save to this file instead.
@@ -658,6 +658,7 @@ EditorOverlayWidget::move_object()
     //}
 
     m_dragged_object->move_to(new_pos);
+    object_changed(*m_dragged_object);
   }
 }
 
@@ -668,6 +669,7 @@ EditorOverlayWidget::rubber_object()
     delete_markers();
   }
   if (m_dragged_object) {
+    object_changed(*m_dragged_object);
     m_dragged_object->editor_delete();
   }
   m_last_node_marker = nullptr;
@@ -681,6 +683,7 @@ EditorOverlayWidget::rubber_rect()
   for (auto& moving_object : m_editor.get_sector()->get_objects_by_type<MovingObject>()) {
     Rectf bbox = moving_object.get_bbox();
     if (dr.contains(bbox)) {
+      object_changed(moving_object);
       moving_object.editor_delete();
     }
   }
@@ -716,6 +719,7 @@ EditorOverlayWidget::add_path_node()
   auto& new_marker = Sector::get().add<NodeMarker>(&(m_edited_path.get()->get_path()), m_edited_path->get_path().m_nodes.end() - 1, m_edited_path->get_path().m_nodes.size() - 1, bezier_before.get_uid(), bezier_after.get_uid());
   bezier_before.set_parent(new_marker.get_uid());
   bezier_after.set_parent(new_marker.get_uid());
+  m_editor.object_changed(*m_edited_path);
   //last_node_marker = dynamic_cast<NodeMarker*>(marker.get());
   update_node_iterators();
   new_marker.update_node_times();
@@ -727,6 +731,23 @@ EditorOverlayWidget::add_path_node()
   grab_object();
 }
 
+void
+EditorOverlayWidget::object_changed(const GameObject& object)
+{
+  if (!dynamic_cast<const MarkerObject*>(&object)) {
+    m_editor.object_changed(object);
+    return;
+  }
+
+  // Markers are not saved, they edit the path or object they belong to
+  if (m_edited_path && m_edited_path->is_valid()) {
+    m_editor.object_changed(*m_edited_path);
+  }
+  if (m_selected_object && m_selected_object->is_valid()) {
+    m_editor.object_changed(*m_selected_object);
+  }
+}
+
 void
 EditorOverlayWidget::put_object()
 {
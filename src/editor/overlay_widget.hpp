@@ -94,6 +94,10 @@ private:
   void select_object();
   void add_path_node();
 
+  /** Reports a change to the undo history, for markers the path or
+      object they belong to */
+  void object_changed(const GameObject& object);
+
   void draw_tile_tip(DrawingContext&);
   void draw_tile_grid(DrawingContext&, int tile_size, bool draw_shadow) const;
   void draw_tilemap_border(DrawingContext&);
@@ -0,0 +1,135 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "editor/tile_region.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+bool
+TileRegion::diff(const std::vector<uint32_t>& before,
+                 const std::vector<uint32_t>& after,
+                 int width, TileRegion& region)
+{
+  assert(before.size() == after.size());
+  assert(width > 0 && before.size() % static_cast<size_t>(width) == 0);
+
+  // Most edits touch a handful of tiles, find the first and last
+  // difference with a plain compare before looking at columns.
+  auto first = std::mismatch(before.begin(), before.end(), after.begin());
+  if (first.first == before.end())
+    return false;
+
+  auto last = std::mismatch(before.rbegin(), before.rend(), after.rbegin());
+
+  const int first_index = static_cast<int>(first.first - before.begin());
+  const int last_index = static_cast<int>(before.rend() - last.first) - 1;
+
+  const int top = first_index / width;
+  const int bottom = last_index / width;
+
+  int left = width;
+  int right = -1;
+  for (int y = top; y <= bottom; ++y)
+  {
+    const size_t row = static_cast<size_t>(y) * width;
+    for (int x = 0; x < left; ++x) {
+      if (before[row + x] != after[row + x]) {
+        left = x;
+        break;
+      }
+    }
+    for (int x = width - 1; x > right; --x) {
+      if (before[row + x] != after[row + x]) {
+        right = x;
+        break;
+      }
+    }
+  }
+
+  region.copy(before, after, width, left, top, right, bottom);
+  return true;
+}
+
+bool
+TileRegion::diff(const std::vector<uint32_t>& before,
+                 const std::vector<uint32_t>& after,
+                 int width, const std::vector<int>& indices,
+                 TileRegion& region)
+{
+  assert(before.size() == after.size());
+  assert(width > 0 && before.size() % static_cast<size_t>(width) == 0);
+
+  int left = width;
+  int right = -1;
+  int top = static_cast<int>(before.size()) / width;
+  int bottom = -1;
+  for (const int index : indices)
+  {
+    assert(index >= 0 && static_cast<size_t>(index) < before.size());
+    if (before[index] == after[index])
+      continue;
+
+    const int x = index % width;
+    const int y = index / width;
+    left = std::min(left, x);
+    right = std::max(right, x);
+    top = std::min(top, y);
+    bottom = std::max(bottom, y);
+  }
+
+  if (right < 0)
+    return false;
+
+  region.copy(before, after, width, left, top, right, bottom);
+  return true;
+}
+
+void
+TileRegion::apply(std::vector<uint32_t>& tiles, int tiles_width, bool forward) const
+{
+  const auto& source = forward ? after : before;
+  for (int y = 0; y < height; ++y)
+  {
+    std::copy(source.begin() + y * width, source.begin() + (y + 1) * width,
+              tiles.begin() + static_cast<size_t>(top + y) * tiles_width + left);
+  }
+}
+
+void
+TileRegion::copy(const std::vector<uint32_t>& before_tiles,
+                 const std::vector<uint32_t>& after_tiles,
+                 int tiles_width, int left_, int top_, int right, int bottom)
+{
+  left = left_;
+  top = top_;
+  width = right - left_ + 1;
+  height = bottom - top_ + 1;
+
+  before.clear();
+  after.clear();
+  before.reserve(width * height);
+  after.reserve(width * height);
+  for (int y = top_; y <= bottom; ++y)
+  {
+    const size_t row = static_cast<size_t>(y) * tiles_width;
+    before.insert(before.end(), before_tiles.begin() + row + left_, before_tiles.begin() + row + right + 1);
+    after.insert(after.end(), after_tiles.begin() + row + left_, after_tiles.begin() + row + right + 1);
+  }
+}
+
+/* EOF */
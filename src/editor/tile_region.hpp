@@ -0,0 +1,69 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_EDITOR_TILE_REGION_HPP
+#define HEADER_SUPERTUX_EDITOR_TILE_REGION_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/** Rectangle of tiles that differ between two versions of a tilemap,
+    used by the editor to undo tile changes without a level snapshot. */
+struct TileRegion
+{
+  /** Stores the bounding rectangle of all tiles that differ between
+      `before` and `after` in `region`, returns false if both are equal.
+      Both vectors hold a `width` wide tilemap of the same size. */
+  static bool diff(const std::vector<uint32_t>& before,
+                   const std::vector<uint32_t>& after,
+                   int width, TileRegion& region);
+
+  /** Like diff(), but only looks at the tiles at `indices`, which
+      have to include every tile that differs */
+  static bool diff(const std::vector<uint32_t>& before,
+                   const std::vector<uint32_t>& after,
+                   int width, const std::vector<int>& indices,
+                   TileRegion& region);
+
+  int left;
+  int top;
+  int width;
+  int height;
+
+  /** Tiles inside the rectangle, row by row */
+  std::vector<uint32_t> before;
+  std::vector<uint32_t> after;
+
+  /** Writes the tiles before or after the change into `tiles` */
+  void apply(std::vector<uint32_t>& tiles, int tiles_width, bool forward) const;
+
+  size_t get_memory_usage() const
+  {
+    return sizeof(TileRegion) + (before.size() + after.size()) * sizeof(uint32_t);
+  }
+
+private:
+  /** Sets the rectangle and copies its tiles, right and bottom inclusive */
+  void copy(const std::vector<uint32_t>& before_tiles,
+            const std::vector<uint32_t>& after_tiles,
+            int tiles_width, int left, int top, int right, int bottom);
+};
+
+#endif
+
+/* EOF */
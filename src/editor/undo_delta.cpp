@@ -0,0 +1,738 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "editor/undo_delta.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "editor/object_option.hpp"
+#include "editor/object_settings.hpp"
+#include "object/tilemap.hpp"
+#include "supertux/game_object_factory.hpp"
+#include "supertux/level.hpp"
+#include "supertux/sector.hpp"
+#include "supertux/sector_parser.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+namespace {
+
+/** Saves the object like Sector::save() does, but leaves out the tiles
+    of tilemaps, those are compared separately. */
+std::string save_object(GameObject& object, bool tilemap)
+{
+  std::ostringstream out;
+  Writer writer(out);
+  if (tilemap)
+  {
+    auto settings = object.get_settings();
+    for (const auto& option : settings.get_options())
+    {
+      if (option->get_key() != "tiles")
+        option->save(writer);
+    }
+  }
+  else
+  {
+    object.save(writer);
+  }
+  return out.str();
+}
+
+std::string sector_to_string(const LevelProperties::SectorProperties& properties,
+                             const LevelSnapshot::SectorState& sector)
+{
+  std::ostringstream out;
+  Writer writer(out);
+  writer.start_list("sector", false);
+  writer.write("name", properties.name, false);
+  if (properties.gravity != 10.0f) {
+    writer.write("gravity", properties.gravity);
+  }
+  if (!properties.init_script.empty()) {
+    writer.write("init-script", properties.init_script, false);
+  }
+  for (const auto& object : sector.objects) {
+    out << object.to_string();
+  }
+  writer.end_list("sector");
+  return out.str();
+}
+
+/** Saves the object and starts collecting its changed tiles */
+LevelSnapshot::Object save_object_state(GameObject& object, int class_index)
+{
+  auto* tilemap = dynamic_cast<TileMap*>(&object);
+
+  LevelSnapshot::Object result;
+  result.uid = object.get_uid();
+  result.class_name = object.get_class();
+  result.class_index = class_index;
+  result.data = save_object(object, tilemap != nullptr);
+  result.tilemap = (tilemap != nullptr);
+  result.width = tilemap ? tilemap->get_width() : 0;
+  if (tilemap)
+  {
+    result.tiles = tilemap->get_tiles();
+    tilemap->reset_changed_tiles();
+  }
+  return result;
+}
+
+/** Saveable objects of the given class, in the order they are saved */
+std::vector<GameObject*> get_objects_of_class(Sector& sector, const std::string& class_name)
+{
+  std::vector<GameObject*> result;
+  for (const auto& object : sector.get_objects())
+  {
+    if (object->is_valid() && object->is_saveable() && object->get_class() == class_name)
+      result.push_back(object.get());
+  }
+  return result;
+}
+
+std::unique_ptr<GameObject> create_object(const std::string& data)
+{
+  std::istringstream in(data);
+  auto doc = ReaderDocument::from_stream(in, "<undo>");
+  auto root = doc.get_root();
+  return GameObjectFactory::instance().create(root.get_name(), root.get_mapping());
+}
+
+} // namespace
+
+bool
+LevelProperties::SectorProperties::operator==(const SectorProperties& other) const
+{
+  return name == other.name &&
+         gravity == other.gravity &&
+         init_script == other.init_script;
+}
+
+LevelProperties
+LevelProperties::from_level(const Level& level)
+{
+  LevelProperties result;
+  result.name = level.m_name;
+  result.author = level.m_author;
+  result.contact = level.m_contact;
+  result.license = level.m_license;
+  result.note = level.m_note;
+  result.tileset = level.m_tileset;
+  result.target_time = level.m_target_time;
+  result.suppress_pause_menu = level.m_suppress_pause_menu;
+
+  for (const auto& sector : level.m_sectors) {
+    result.sectors.push_back({ sector->get_name(), sector->get_gravity(), sector->get_init_script() });
+  }
+
+  return result;
+}
+
+void
+LevelProperties::apply(Level& level) const
+{
+  level.m_name = name;
+  level.m_author = author;
+  level.m_contact = contact;
+  level.m_license = license;
+  level.m_note = note;
+  level.m_tileset = tileset;
+  level.m_target_time = target_time;
+  level.m_suppress_pause_menu = suppress_pause_menu;
+
+  assert(sectors.size() == level.m_sectors.size());
+  for (size_t i = 0; i < sectors.size(); ++i)
+  {
+    auto& sector = *level.m_sectors[i];
+    sector.set_name(sectors[i].name);
+    if (sector.get_gravity() != sectors[i].gravity) {
+      sector.set_gravity(sectors[i].gravity);
+    }
+    sector.set_init_script(sectors[i].init_script);
+  }
+}
+
+size_t
+LevelProperties::get_memory_usage() const
+{
+  size_t result = sizeof(LevelProperties) +
+    name.size() + author.size() + contact.size() + license.size() + note.size() + tileset.size();
+  for (const auto& sector : sectors) {
+    result += sizeof(SectorProperties) + sector.name.size() + sector.init_script.size();
+  }
+  return result;
+}
+
+bool
+LevelProperties::operator==(const LevelProperties& other) const
+{
+  return name == other.name &&
+         author == other.author &&
+         contact == other.contact &&
+         license == other.license &&
+         note == other.note &&
+         tileset == other.tileset &&
+         target_time == other.target_time &&
+         suppress_pause_menu == other.suppress_pause_menu &&
+         sectors == other.sectors;
+}
+
+std::string
+LevelSnapshot::Object::to_string() const
+{
+  std::ostringstream out;
+  out << "(" << class_name << "\n" << data;
+  if (tilemap)
+  {
+    Writer writer(out);
+    writer.write("width", width);
+    writer.write("height", width > 0 ? static_cast<int>(tiles.size()) / width : 0);
+    writer.write("tiles", tiles, width);
+  }
+  out << ")\n";
+  return out.str();
+}
+
+bool
+LevelSnapshot::Object::operator==(const Object& other) const
+{
+  return uid == other.uid &&
+         class_name == other.class_name &&
+         class_index == other.class_index &&
+         data == other.data &&
+         tilemap == other.tilemap &&
+         width == other.width &&
+         tiles == other.tiles;
+}
+
+bool
+LevelSnapshot::SectorState::operator==(const SectorState& other) const
+{
+  return sector == other.sector &&
+         version == other.version &&
+         objects == other.objects;
+}
+
+std::unique_ptr<LevelSnapshot>
+LevelSnapshot::from_level(Level& level)
+{
+  auto state = std::make_unique<LevelSnapshot>();
+  state->level = &level;
+  state->properties = LevelProperties::from_level(level);
+
+  for (const auto& sector : level.m_sectors) {
+    state->sectors.push_back(from_sector(*sector));
+  }
+
+  return state;
+}
+
+LevelSnapshot::SectorState
+LevelSnapshot::from_sector(Sector& sector)
+{
+  BIND_SECTOR(sector);
+
+  SectorState result;
+  result.sector = &sector;
+  result.version = sector.get_object_list_version();
+  result.all_changed = false;
+
+  std::unordered_map<std::string, int> counts;
+  for (const auto& object : sector.get_objects())
+  {
+    if (!object->is_valid() || !object->is_saveable())
+      continue;
+
+    result.positions[object->get_uid()] = result.objects.size();
+    result.objects.push_back(save_object_state(*object, counts[object->get_class()]++));
+  }
+
+  return result;
+}
+
+void
+LevelSnapshot::mark_changed(const Sector& sector, const GameObject& object)
+{
+  for (auto& sector_state : sectors)
+  {
+    if (sector_state.sector == &sector) {
+      sector_state.changed.insert(object.get_uid());
+      return;
+    }
+  }
+}
+
+void
+LevelSnapshot::mark_changed(const Sector& sector)
+{
+  for (auto& sector_state : sectors)
+  {
+    if (sector_state.sector == &sector) {
+      sector_state.all_changed = true;
+      return;
+    }
+  }
+}
+
+bool
+LevelSnapshot::operator==(const LevelSnapshot& other) const
+{
+  return level == other.level &&
+         properties == other.properties &&
+         sectors == other.sectors;
+}
+
+std::unique_ptr<UndoDelta>
+UndoDelta::record(LevelSnapshot& state, Level& level)
+{
+  if (state.level != &level)
+  {
+    log_warning << "undo: recorded state belongs to a different level, starting over" << std::endl;
+    state = std::move(*LevelSnapshot::from_level(level));
+    return {};
+  }
+
+  auto delta = std::make_unique<UndoDelta>();
+  auto properties = LevelProperties::from_level(level);
+
+  // Sectors are matched in order, anything that appears to have moved
+  // is recorded as removed and added again.
+  std::vector<LevelSnapshot::SectorState> sectors;
+  std::vector<bool> kept_sectors(state.sectors.size(), false);
+  int last_sector = -1;
+  for (size_t i = 0; i < level.m_sectors.size(); ++i)
+  {
+    Sector& sector = *level.m_sectors[i];
+
+    int match = -1;
+    for (size_t j = last_sector + 1; j < state.sectors.size(); ++j) {
+      if (state.sectors[j].sector == &sector) {
+        match = static_cast<int>(j);
+        break;
+      }
+    }
+
+    if (match < 0)
+    {
+      auto sector_state = LevelSnapshot::from_sector(sector);
+      delta->m_added_sectors.push_back({ static_cast<int>(i),
+                                         sector_to_string(properties.sectors[i], sector_state) });
+      sectors.push_back(std::move(sector_state));
+      continue;
+    }
+
+    kept_sectors[match] = true;
+    last_sector = match;
+
+    SectorChange change;
+    change.index = static_cast<int>(i);
+    record_sector(state.sectors[match], sector, change);
+
+    if (!change.objects.empty() || !change.tiles.empty()) {
+      delta->m_sectors.push_back(std::move(change));
+    }
+    sectors.push_back(std::move(state.sectors[match]));
+  }
+
+  for (size_t j = 0; j < state.sectors.size(); ++j)
+  {
+    if (!kept_sectors[j]) {
+      delta->m_removed_sectors.push_back({ static_cast<int>(j),
+                                           sector_to_string(state.properties.sectors[j], state.sectors[j]) });
+    }
+  }
+
+  if (state.properties != properties)
+  {
+    delta->m_properties_changed = true;
+    delta->m_before = std::move(state.properties);
+    delta->m_after = properties;
+  }
+
+  state.properties = std::move(properties);
+  state.sectors = std::move(sectors);
+
+  // Changes that were not reported through mark_changed() are missing
+  // from the delta and show up as a difference to a fresh snapshot.
+  assert(state == *LevelSnapshot::from_level(level));
+
+  if (!delta->m_properties_changed &&
+      delta->m_removed_sectors.empty() &&
+      delta->m_added_sectors.empty() &&
+      delta->m_sectors.empty())
+  {
+    return {};
+  }
+
+  return delta;
+}
+
+void
+UndoDelta::record_sector(LevelSnapshot::SectorState& before, Sector& sector, SectorChange& change)
+{
+  BIND_SECTOR(sector);
+
+  if (before.version == sector.get_object_list_version() && !before.all_changed)
+  {
+    // The object list is the same as before, only the objects marked as
+    // changed and the tilemaps with changed tiles have to be looked at.
+    std::vector<std::pair<GameObject*, LevelSnapshot::Object*> > changed;
+    bool removed = false;
+    for (const auto& uid : before.changed)
+    {
+      auto it = before.positions.find(uid);
+      if (it == before.positions.end())
+        continue; // not saveable, or not added yet
+
+      auto* object = sector.get_object_by_uid<GameObject>(uid);
+      if (!object || !object->is_valid()) {
+        removed = true;
+        break;
+      }
+      changed.push_back({ object, &before.objects[it->second] });
+    }
+
+    if (!removed)
+    {
+      for (const auto& entry : changed) {
+        record_object(*entry.first, entry.second->class_index, entry.second, true, change);
+      }
+
+      for (auto* object : sector.get_objects_by_type_index(typeid(TileMap)))
+      {
+        auto& tilemap = static_cast<TileMap&>(*object);
+        if (tilemap.all_tiles_changed() || !tilemap.get_changed_tiles().empty())
+        {
+          auto it = before.positions.find(tilemap.get_uid());
+          if (it != before.positions.end()) {
+            auto& object_state = before.objects[it->second];
+            record_object(tilemap, object_state.class_index, &object_state, false, change);
+          }
+        }
+      }
+
+      before.changed.clear();
+      return;
+    }
+  }
+
+  // Objects were added, removed or moved: walk the object list and match
+  // it against the old one, anything that appears to have moved is
+  // recorded as removed and added again.
+  std::vector<LevelSnapshot::Object> objects;
+  std::unordered_map<UID, size_t> positions;
+  std::unordered_map<std::string, int> counts;
+  std::vector<bool> kept(before.objects.size(), false);
+  int last = -1;
+  for (const auto& object : sector.get_objects())
+  {
+    if (!object->is_valid() || !object->is_saveable())
+      continue;
+
+    const UID uid = object->get_uid();
+    const int class_index = counts[object->get_class()]++;
+
+    auto it = before.positions.find(uid);
+    if (it == before.positions.end() ||
+        static_cast<int>(it->second) <= last ||
+        before.objects[it->second].class_name != object->get_class())
+    {
+      auto object_state = save_object_state(*object, class_index);
+      change.objects.push_back({ object_state.class_name, -1, class_index,
+                                 std::string(), object_state.to_string() });
+      positions[uid] = objects.size();
+      objects.push_back(std::move(object_state));
+      continue;
+    }
+
+    const size_t l = it->second;
+    kept[l] = true;
+    last = static_cast<int>(l);
+
+    auto& object_state = before.objects[l];
+    const bool saved_changed = before.all_changed || before.changed.count(uid) > 0;
+    record_object(*object, class_index, &object_state, saved_changed, change);
+
+    positions[uid] = objects.size();
+    objects.push_back(std::move(object_state));
+  }
+
+  for (size_t l = 0; l < before.objects.size(); ++l)
+  {
+    if (!kept[l]) {
+      change.objects.push_back({ before.objects[l].class_name, before.objects[l].class_index, -1,
+                                 before.objects[l].to_string(), std::string() });
+    }
+  }
+
+  before.version = sector.get_object_list_version();
+  before.objects = std::move(objects);
+  before.positions = std::move(positions);
+  before.changed.clear();
+  before.all_changed = false;
+}
+
+void
+UndoDelta::record_object(GameObject& object, int class_index, LevelSnapshot::Object* before,
+                         bool saved_changed, SectorChange& change)
+{
+  auto* tilemap = dynamic_cast<TileMap*>(&object);
+
+  std::string data;
+  if (saved_changed) {
+    data = save_object(object, tilemap != nullptr);
+  }
+
+  const bool same_size = !tilemap || (tilemap->get_width() == before->width &&
+                                      tilemap->get_tiles().size() == before->tiles.size());
+  if ((!saved_changed || data == before->data) && same_size)
+  {
+    if (tilemap && before->width > 0)
+    {
+      TileChange tiles;
+      tiles.index = class_index;
+      const bool tiles_changed = tilemap->all_tiles_changed() ?
+        TileRegion::diff(before->tiles, tilemap->get_tiles(), before->width, tiles.region) :
+        TileRegion::diff(before->tiles, tilemap->get_tiles(), before->width,
+                         tilemap->get_changed_tiles(), tiles.region);
+      if (tiles_changed)
+      {
+        tiles.region.apply(before->tiles, before->width, true);
+        change.tiles.push_back(std::move(tiles));
+      }
+    }
+    if (tilemap) {
+      tilemap->reset_changed_tiles();
+    }
+    before->class_index = class_index;
+    return;
+  }
+
+  std::string before_string = before->to_string();
+  const int before_index = before->class_index;
+  *before = save_object_state(object, class_index);
+  change.objects.push_back({ before->class_name, before_index, class_index,
+                             std::move(before_string), before->to_string() });
+}
+
+UndoDelta::UndoDelta() :
+  m_properties_changed(false),
+  m_before(),
+  m_after(),
+  m_removed_sectors(),
+  m_added_sectors(),
+  m_sectors()
+{
+}
+
+void
+UndoDelta::undo(Level& level) const
+{
+  for (const auto& change : m_sectors)
+  {
+    assert(change.index < static_cast<int>(level.m_sectors.size()));
+    auto& sector = *level.m_sectors[change.index];
+    apply_tiles(sector, change.tiles, false);
+    apply_objects(sector, change.objects, false);
+  }
+
+  apply_sectors(level, m_added_sectors, m_removed_sectors);
+
+  if (m_properties_changed) {
+    m_before.apply(level);
+  }
+}
+
+void
+UndoDelta::redo(Level& level) const
+{
+  apply_sectors(level, m_removed_sectors, m_added_sectors);
+
+  for (const auto& change : m_sectors)
+  {
+    assert(change.index < static_cast<int>(level.m_sectors.size()));
+    auto& sector = *level.m_sectors[change.index];
+    apply_objects(sector, change.objects, true);
+    apply_tiles(sector, change.tiles, true);
+  }
+
+  if (m_properties_changed) {
+    m_after.apply(level);
+  }
+}
+
+size_t
+UndoDelta::get_memory_usage() const
+{
+  size_t result = sizeof(UndoDelta);
+
+  if (m_properties_changed) {
+    result += m_before.get_memory_usage() + m_after.get_memory_usage();
+  }
+
+  for (const auto& sector : m_removed_sectors) {
+    result += sizeof(SectorData) + sector.data.size();
+  }
+  for (const auto& sector : m_added_sectors) {
+    result += sizeof(SectorData) + sector.data.size();
+  }
+
+  for (const auto& change : m_sectors)
+  {
+    result += sizeof(SectorChange);
+    for (const auto& object : change.objects) {
+      result += sizeof(ObjectChange) + object.class_name.size() + object.before.size() + object.after.size();
+    }
+    for (const auto& tiles : change.tiles) {
+      result += tiles.region.get_memory_usage();
+    }
+  }
+
+  return result;
+}
+
+void
+UndoDelta::apply_sectors(Level& level,
+                         const std::vector<SectorData>& remove,
+                         const std::vector<SectorData>& add)
+{
+  // Both lists are sorted by index
+  for (auto it = remove.rbegin(); it != remove.rend(); ++it)
+  {
+    assert(it->index < static_cast<int>(level.m_sectors.size()));
+    level.m_sectors.erase(level.m_sectors.begin() + it->index);
+  }
+
+  for (const auto& sector_data : add)
+  {
+    std::istringstream in(sector_data.data);
+    auto doc = ReaderDocument::from_stream(in, "<undo>");
+    auto sector = SectorParser::from_reader(level, doc.get_root().get_mapping(), true);
+
+    assert(sector_data.index <= static_cast<int>(level.m_sectors.size()));
+    level.m_sectors.insert(level.m_sectors.begin() + sector_data.index, std::move(sector));
+  }
+}
+
+void
+UndoDelta::apply_objects(Sector& sector, const std::vector<ObjectChange>& changes, bool forward)
+{
+  if (changes.empty())
+    return;
+
+  BIND_SECTOR(sector);
+
+  std::vector<const ObjectChange*> removed;
+  std::vector<const ObjectChange*> added;
+  std::vector<const ObjectChange*> changed;
+  for (const auto& change : changes)
+  {
+    const std::string& from = forward ? change.before : change.after;
+    const std::string& to = forward ? change.after : change.before;
+    if (to.empty())
+      removed.push_back(&change);
+    else if (from.empty())
+      added.push_back(&change);
+    else
+      changed.push_back(&change);
+  }
+
+  // Remove back to front and add front to back, so that the positions
+  // recorded for one object are not shifted by the others.
+  std::sort(removed.begin(), removed.end(),
+            [forward](const ObjectChange* lhs, const ObjectChange* rhs) {
+              return forward ? lhs->before_index > rhs->before_index : lhs->after_index > rhs->after_index;
+            });
+  std::sort(added.begin(), added.end(),
+            [forward](const ObjectChange* lhs, const ObjectChange* rhs) {
+              return forward ? lhs->after_index < rhs->after_index : lhs->before_index < rhs->before_index;
+            });
+
+  for (const auto* change : removed)
+  {
+    const int index = forward ? change->before_index : change->after_index;
+    auto objects = get_objects_of_class(sector, change->class_name);
+    if (index >= static_cast<int>(objects.size())) {
+      log_warning << "undo: no " << change->class_name << " #" << index << " to remove" << std::endl;
+      continue;
+    }
+    objects[index]->remove_me();
+  }
+  sector.flush_game_objects();
+
+  for (const auto* change : added)
+  {
+    const int index = forward ? change->after_index : change->before_index;
+    GameObject& object = sector.add_object(create_object(forward ? change->after : change->before));
+    sector.flush_game_objects();
+
+    auto objects = get_objects_of_class(sector, change->class_name);
+    if (index < static_cast<int>(objects.size()) && objects[index] != &object) {
+      sector.move_object_before(object, objects[index]);
+    }
+  }
+
+  for (const auto* change : changed)
+  {
+    const int index = forward ? change->after_index : change->before_index;
+    auto objects = get_objects_of_class(sector, change->class_name);
+    if (index >= static_cast<int>(objects.size())) {
+      log_warning << "undo: no " << change->class_name << " #" << index << " to change" << std::endl;
+      continue;
+    }
+
+    GameObject& object = sector.add_object(create_object(forward ? change->after : change->before));
+    sector.flush_game_objects();
+    sector.move_object_before(object, objects[index]);
+    objects[index]->remove_me();
+    sector.flush_game_objects();
+  }
+}
+
+void
+UndoDelta::apply_tiles(Sector& sector, const std::vector<TileChange>& changes, bool forward)
+{
+  if (changes.empty())
+    return;
+
+  const auto tilemaps = get_objects_of_class(sector, "tilemap");
+  for (const auto& change : changes)
+  {
+    if (change.index >= static_cast<int>(tilemaps.size())) {
+      log_warning << "undo: no tilemap #" << change.index << std::endl;
+      continue;
+    }
+
+    auto* tilemap = static_cast<TileMap*>(tilemaps[change.index]);
+    const TileRegion& region = change.region;
+    const auto& tiles = forward ? region.after : region.before;
+    for (int y = 0; y < region.height; ++y) {
+      for (int x = 0; x < region.width; ++x) {
+        tilemap->change(region.left + x, region.top + y, tiles[y * region.width + x]);
+      }
+    }
+  }
+}
+
+/* EOF */
@@ -0,0 +1,237 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_EDITOR_UNDO_DELTA_HPP
+#define HEADER_SUPERTUX_EDITOR_UNDO_DELTA_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "editor/tile_region.hpp"
+#include "util/uid.hpp"
+
+class GameObject;
+class Level;
+class Sector;
+
+/** Settings of a level and its sectors that are not stored in objects */
+struct LevelProperties
+{
+  struct SectorProperties
+  {
+    std::string name;
+    float gravity;
+    std::string init_script;
+
+    bool operator==(const SectorProperties& other) const;
+  };
+
+  static LevelProperties from_level(const Level& level);
+
+  void apply(Level& level) const;
+  size_t get_memory_usage() const;
+
+  bool operator==(const LevelProperties& other) const;
+  bool operator!=(const LevelProperties& other) const { return !(*this == other); }
+
+  std::string name;
+  std::string author;
+  std::string contact;
+  std::string license;
+  std::string note;
+  std::string tileset;
+  float target_time;
+  bool suppress_pause_menu;
+  std::vector<SectorProperties> sectors;
+};
+
+/** Copy of everything UndoDelta tracks in a level, kept by the
+    UndoManager to find out what the next change touched.
+
+    Objects are only saved again if they were passed to mark_changed(),
+    tiles only compared where TileMap::get_changed_tiles() says they
+    changed, and the object list is only walked when objects were added,
+    removed or moved, so recording a change costs about as much as the
+    change itself. */
+struct LevelSnapshot
+{
+  struct Object
+  {
+    UID uid;
+    std::string class_name;
+
+    /** Position among the objects of the same class */
+    int class_index;
+
+    /** The saved object, without its tiles for tilemaps */
+    std::string data;
+
+    bool tilemap;
+    int width;
+    std::vector<uint32_t> tiles;
+
+    /** Returns the object in level file syntax, including tiles */
+    std::string to_string() const;
+
+    bool operator==(const Object& other) const;
+  };
+
+  struct SectorState
+  {
+    /** Only used to recognize the sector, never dereferenced */
+    const Sector* sector;
+
+    /** GameObjectManager::get_object_list_version() as of `objects` */
+    uint64_t version;
+
+    /** Saveable objects in the order of Sector::get_objects() */
+    std::vector<Object> objects;
+
+    /** Position of every object in `objects` */
+    std::unordered_map<UID, size_t> positions;
+
+    /** Objects that have to be saved again, see mark_changed() */
+    std::unordered_set<UID> changed;
+    bool all_changed;
+
+    /** Compares the recorded objects, not what is marked as changed */
+    bool operator==(const SectorState& other) const;
+  };
+
+  static std::unique_ptr<LevelSnapshot> from_level(Level& level);
+  static SectorState from_sector(Sector& sector);
+
+  /** Tells the next UndoDelta::record() that `object` changed in a way
+      other than its tiles, which are tracked by the TileMap itself */
+  void mark_changed(const Sector& sector, const GameObject& object);
+
+  /** Tells the next UndoDelta::record() that any object in `sector`
+      may have changed */
+  void mark_changed(const Sector& sector);
+
+  bool operator==(const LevelSnapshot& other) const;
+  bool operator!=(const LevelSnapshot& other) const { return !(*this == other); }
+
+  /** Only used to recognize the level, never dereferenced */
+  const Level* level;
+  LevelProperties properties;
+  std::vector<SectorState> sectors;
+};
+
+/**
+ * A single step of the editor undo history, stored as the difference
+ * between two versions of a level instead of a copy of the whole level.
+ *
+ * Changed tiles are kept as TileRegion rectangles, other objects as the
+ * saved object before and after the change. Objects are addressed by
+ * their position among the objects of the same class in their sector,
+ * which is the order they are saved in, so a delta stays valid when a
+ * change replaces objects or the level is reloaded from a snapshot.
+ */
+class UndoDelta final
+{
+public:
+  /** Records the changes from `state` to `level` and updates `state`
+      to match `level`. Returns nullptr if nothing changed, or if `state`
+      belongs to a different level. */
+  static std::unique_ptr<UndoDelta> record(LevelSnapshot& state, Level& level);
+
+private:
+  struct ObjectChange
+  {
+    std::string class_name;
+
+    /** Position among the objects of the same class, -1 if the object
+        was added or removed in this change */
+    int before_index;
+    int after_index;
+
+    /** The saved object, empty if it was added or removed */
+    std::string before;
+    std::string after;
+  };
+
+  struct TileChange
+  {
+    /** Position among the sector's tilemaps */
+    int index;
+    TileRegion region;
+  };
+
+  struct SectorChange
+  {
+    /** Position of the sector after the change */
+    int index;
+
+    std::vector<ObjectChange> objects;
+    std::vector<TileChange> tiles;
+  };
+
+  struct SectorData
+  {
+    int index;
+    std::string data;
+  };
+
+public:
+  UndoDelta();
+
+  /** Reverts the change, `level` has to be in the state after the change */
+  void undo(Level& level) const;
+
+  /** Repeats the change, `level` has to be in the state before the change */
+  void redo(Level& level) const;
+
+  size_t get_memory_usage() const;
+
+private:
+  static void record_sector(LevelSnapshot::SectorState& before, Sector& sector, SectorChange& change);
+
+  /** Stores the difference between `object` and its `before` state in
+      `change` and updates `before`. The object is only saved again if
+      `saved_changed` is set, otherwise only its tiles are compared. */
+  static void record_object(GameObject& object, int class_index, LevelSnapshot::Object* before,
+                            bool saved_changed, SectorChange& change);
+
+  static void apply_sectors(Level& level,
+                            const std::vector<SectorData>& remove,
+                            const std::vector<SectorData>& add);
+  static void apply_objects(Sector& sector, const std::vector<ObjectChange>& changes, bool forward);
+  static void apply_tiles(Sector& sector, const std::vector<TileChange>& changes, bool forward);
+
+private:
+  bool m_properties_changed;
+  LevelProperties m_before;
+  LevelProperties m_after;
+
+  std::vector<SectorData> m_removed_sectors;
+  std::vector<SectorData> m_added_sectors;
+  std::vector<SectorChange> m_sectors;
+
+private:
+  UndoDelta(const UndoDelta&) = delete;
+  UndoDelta& operator=(const UndoDelta&) = delete;
+};
+
+#endif
+
+/* EOF */
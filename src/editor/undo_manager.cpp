@@ -16,26 +16,70 @@
 
 #include "editor/undo_manager.hpp"
 
+#include <chrono>
 #include <sstream>
 #include <iostream>
 
-#include "editor/editor.hpp"
+#include "editor/undo_delta.hpp"
 #include "supertux/level.hpp"
 #include "supertux/level_parser.hpp"
 #include "util/log.hpp"
 #include "util/reader_mapping.hpp"
 
-UndoManager::UndoManager() :
+namespace {
+
+double elapsed_ms(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+UndoManager::UndoManager(bool use_deltas, size_t max_memory) :
+  m_use_deltas(use_deltas),
   m_max_snapshots(100),
+  m_max_memory(max_memory),
   m_index_pos(),
   m_undo_stack(),
-  m_redo_stack()
+  m_redo_stack(),
+  m_state(),
+  m_undo_deltas(),
+  m_redo_deltas()
+{
+}
+
+UndoManager::~UndoManager()
 {
 }
 
 void
 UndoManager::try_snapshot(Level& level)
 {
+  const auto start = std::chrono::steady_clock::now();
+
+  if (m_use_deltas)
+  {
+    if (!m_state)
+    {
+      m_state = LevelSnapshot::from_level(level);
+      m_index_pos += 1;
+      return;
+    }
+
+    auto delta = UndoDelta::record(*m_state, level);
+    if (!delta)
+    {
+      log_debug << "skipping snapshot as nothing has changed" << std::endl;
+    }
+    else
+    {
+      log_debug << "recorded undo delta in " << elapsed_ms(start) << "ms, "
+                << delta->get_memory_usage() << " bytes" << std::endl;
+      push_undo_stack(std::move(delta));
+    }
+    return;
+  }
+
   std::ostringstream out;
   level.save(out);
   std::string level_snapshot = out.str();
@@ -50,10 +94,28 @@ UndoManager::try_snapshot(Level& level)
   }
   else // level_snapshot changed
   {
+    log_debug << "recorded undo snapshot in " << elapsed_ms(start) << "ms, "
+              << level_snapshot.size() << " bytes" << std::endl;
     push_undo_stack(std::move(level_snapshot));
   }
 }
 
+void
+UndoManager::object_changed(const Sector& sector, const GameObject& object)
+{
+  if (m_state) {
+    m_state->mark_changed(sector, object);
+  }
+}
+
+void
+UndoManager::sector_changed(const Sector& sector)
+{
+  if (m_state) {
+    m_state->mark_changed(sector);
+  }
+}
+
 void
 UndoManager::debug_print(const char* action)
 {
@@ -88,18 +150,106 @@ UndoManager::push_undo_stack(std::string&& level_snapshot)
   debug_print("snapshot");
 }
 
+void
+UndoManager::push_undo_stack(std::unique_ptr<UndoDelta> delta)
+{
+  m_redo_deltas.clear();
+  m_undo_deltas.push_back(std::move(delta));
+  m_index_pos += 1;
+
+  cleanup();
+}
+
 void
 UndoManager::cleanup()
 {
-  while (m_undo_stack.size() > m_max_snapshots) {
-    m_undo_stack.erase(m_undo_stack.end() - m_max_snapshots,
-                       m_undo_stack.end());
+  // Drop the oldest steps, but always keep the last one so that it
+  // can be undone even if it is larger than the limit on its own.
+  if (m_use_deltas)
+  {
+    size_t count = 0;
+    while (m_undo_deltas.size() - count > 1 &&
+           (m_undo_deltas.size() - count > m_max_snapshots || get_memory_usage() > m_max_memory))
+    {
+      m_undo_deltas[count].reset();
+      count += 1;
+    }
+    m_undo_deltas.erase(m_undo_deltas.begin(), m_undo_deltas.begin() + count);
   }
+  else
+  {
+    size_t count = 0;
+    while (m_undo_stack.size() - count > 2 &&
+           (m_undo_stack.size() - count > m_max_snapshots || get_memory_usage() > m_max_memory))
+    {
+      m_undo_stack[count].clear();
+      m_undo_stack[count].shrink_to_fit();
+      count += 1;
+    }
+    m_undo_stack.erase(m_undo_stack.begin(), m_undo_stack.begin() + count);
+  }
+}
+
+size_t
+UndoManager::get_memory_usage() const
+{
+  size_t result = 0;
+  for (const auto& snapshot : m_undo_stack) {
+    result += snapshot.capacity();
+  }
+  for (const auto& snapshot : m_redo_stack) {
+    result += snapshot.capacity();
+  }
+  for (const auto& delta : m_undo_deltas) {
+    if (delta) {
+      result += delta->get_memory_usage();
+    }
+  }
+  for (const auto& delta : m_redo_deltas) {
+    result += delta->get_memory_usage();
+  }
+  return result;
+}
+
+bool
+UndoManager::can_undo() const
+{
+  return m_use_deltas ? !m_undo_deltas.empty() : m_undo_stack.size() >= 2;
+}
+
+bool
+UndoManager::can_redo() const
+{
+  return m_use_deltas ? !m_redo_deltas.empty() : !m_redo_stack.empty();
 }
 
 std::unique_ptr<Level>
-UndoManager::undo()
+UndoManager::undo(Level& level)
 {
+  const auto start = std::chrono::steady_clock::now();
+
+  if (m_use_deltas)
+  {
+    // Make sure the level matches the last step before reverting it
+    try_snapshot(level);
+    if (m_undo_deltas.empty()) return {};
+
+    ReaderMapping::s_translations_enabled = false;
+    m_undo_deltas.back()->undo(level);
+    ReaderMapping::s_translations_enabled = true;
+
+    m_redo_deltas.push_back(std::move(m_undo_deltas.back()));
+    m_undo_deltas.pop_back();
+
+    // Catch up with the reverted change, it is already in the history
+    UndoDelta::record(*m_state, level);
+
+    m_index_pos -= 1;
+
+    log_debug << "undo took " << elapsed_ms(start) << "ms" << std::endl;
+    return {};
+  }
+
   if (m_undo_stack.size() < 2) return {};
 
   m_redo_stack.push_back(std::move(m_undo_stack.back()));
@@ -107,19 +257,42 @@ UndoManager::undo()
 
   std::istringstream in(m_undo_stack.back());
   ReaderMapping::s_translations_enabled = false;
-  auto level = LevelParser::from_stream(in, "<undo_stack>", Editor::current()->get_level()->is_worldmap(), true);
+  auto new_level = LevelParser::from_stream(in, "<undo_stack>", level.is_worldmap(), true);
   ReaderMapping::s_translations_enabled = true;
 
   m_index_pos -= 1;
 
   debug_print("undo");
+  log_debug << "undo took " << elapsed_ms(start) << "ms" << std::endl;
 
-  return level;
+  return new_level;
 }
 
 std::unique_ptr<Level>
-UndoManager::redo()
+UndoManager::redo(Level& level)
 {
+  const auto start = std::chrono::steady_clock::now();
+
+  if (m_use_deltas)
+  {
+    // Unrecorded changes would make the redo history invalid
+    try_snapshot(level);
+    if (m_redo_deltas.empty()) return {};
+
+    ReaderMapping::s_translations_enabled = false;
+    m_redo_deltas.back()->redo(level);
+    ReaderMapping::s_translations_enabled = true;
+
+    m_undo_deltas.push_back(std::move(m_redo_deltas.back()));
+    m_redo_deltas.pop_back();
+    UndoDelta::record(*m_state, level);
+
+    m_index_pos += 1;
+
+    log_debug << "redo took " << elapsed_ms(start) << "ms" << std::endl;
+    return {};
+  }
+
   if (m_redo_stack.empty()) return {};
 
   m_undo_stack.push_back(std::move(m_redo_stack.back()));
@@ -129,12 +302,13 @@ UndoManager::redo()
 
   std::istringstream in(m_undo_stack.back());
   ReaderMapping::s_translations_enabled = false;
-  auto level = LevelParser::from_stream(in, "<redo_stack>", Editor::current()->get_level()->is_worldmap(), true);
+  auto new_level = LevelParser::from_stream(in, "<redo_stack>", level.is_worldmap(), true);
   ReaderMapping::s_translations_enabled = true;
 
   debug_print("redo");
+  log_debug << "redo took " << elapsed_ms(start) << "ms" << std::endl;
 
-  return level;
+  return new_level;
 }
 
 /* EOF */
@@ -21,18 +21,46 @@
 #include <string>
 #include <memory>
 
+class GameObject;
 class Level;
+class Sector;
+struct LevelSnapshot;
+class UndoDelta;
 
+/**
+ * Undo history of the editor.
+ *
+ * In snapshot mode every step is a copy of the whole saved level and
+ * undo/redo parse a new Level from it. In delta mode every step is an
+ * UndoDelta that only contains what changed, undo/redo apply it to the
+ * current level in place.
+ */
 class UndoManager
 {
-private:
 public:
-  UndoManager();
+  UndoManager(bool use_deltas = true, size_t max_memory = 64 * 1024 * 1024);
+  ~UndoManager();
 
   void try_snapshot(Level& level);
 
-  std::unique_ptr<Level> undo();
-  std::unique_ptr<Level> redo();
+  /** Delta mode only: tells the next try_snapshot() which objects were
+      changed, objects that are not reported here are not saved again.
+      Added and removed objects and tile changes are noticed without it. */
+  void object_changed(const Sector& sector, const GameObject& object);
+  void sector_changed(const Sector& sector);
+
+  bool can_undo() const;
+  bool can_redo() const;
+
+  /** In snapshot mode this returns the new level, in delta mode the
+      change is reverted in `level` itself and nullptr is returned. */
+  std::unique_ptr<Level> undo(Level& level);
+  std::unique_ptr<Level> redo(Level& level);
+
+  bool is_using_deltas() const { return m_use_deltas; }
+
+  /** Approximate memory used by the undo and redo history in bytes */
+  size_t get_memory_usage() const;
 
   bool has_unsaved_changes() const
   {
@@ -46,15 +74,23 @@ public:
 
 private:
   void push_undo_stack(std::string&& level_snapshot);
+  void push_undo_stack(std::unique_ptr<UndoDelta> delta);
   void cleanup();
   void debug_print(const char* action);
 
 private:
+  bool m_use_deltas;
   size_t m_max_snapshots;
+  size_t m_max_memory;
   int m_index_pos;
   std::vector<std::string> m_undo_stack;
   std::vector<std::string> m_redo_stack;
 
+  /** Delta mode only, the level as of the last recorded step */
+  std::unique_ptr<LevelSnapshot> m_state;
+  std::vector<std::unique_ptr<UndoDelta> > m_undo_deltas;
+  std::vector<std::unique_ptr<UndoDelta> > m_redo_deltas;
+
 private:
   UndoManager(const UndoManager&) = delete;
   UndoManager& operator=(const UndoManager&) = delete;
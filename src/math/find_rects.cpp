@@ -192,4 +192,8 @@ long long findAll (const InputType* input, int width, int height, int minLength,
 	return findRectsInArea(input, width, minLength, output, Rect(0, 0, width, height));
 }
 
+long long findAllInArea (const InputType* input, int rowWidth, int x, int y, int width, int height, int minLength, OutputType* output) {
+	return findRectsInArea(input, rowWidth, minLength, output, Rect(x, y, width, height));
+}
+
 } /* namespace */
@@ -22,6 +22,13 @@ namespace FindRects {
 	*/
 	long long findAll (const InputType* input, int width, int height, int minLength, OutputType* output);
 
+	/** Same as findAll(), but only looks at the given area of the array
+		@param rowWidth: width of the whole input array
+		@param x, y, width, height: the area to split, input elements outside of it are ignored
+		@param output: output array of the same size as for findAll(), only elements inside the area are written
+	*/
+	long long findAllInArea (const InputType* input, int rowWidth, int x, int y, int width, int height, int minLength, OutputType* output);
+
 }
 
 #endif
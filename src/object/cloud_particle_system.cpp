@@ -29,6 +29,8 @@
 CloudParticleSystem::CloudParticleSystem() :
   ParticleSystem(128),
   ExposedObject<CloudParticleSystem, scripting::Clouds>(this),
+  m_target_alpha(),
+  m_target_time_remaining(),
   cloudimage(Surface::from_file("images/particles/cloud.png")),
 
   m_current_speed(1.f),
@@ -46,6 +48,8 @@ CloudParticleSystem::CloudParticleSystem() :
 CloudParticleSystem::CloudParticleSystem(const ReaderMapping& reader) :
   ParticleSystem(reader, 128),
   ExposedObject<CloudParticleSystem, scripting::Clouds>(this),
+  m_target_alpha(),
+  m_target_time_remaining(),
   cloudimage(Surface::from_file("images/particles/cloud.png")),
 
   m_current_speed(1.f),
@@ -103,46 +107,58 @@ void CloudParticleSystem::update(float dt_sec)
 
   auto& cam = Sector::get().get_singleton_by_type<Camera>();
 
-  for (auto& particle : particles) {
-    auto cloudParticle = dynamic_cast<CloudParticle*>(particle.get());
-    if (!cloudParticle)
-      continue;
-    cloudParticle->pos.x += cloudParticle->speed * dt_sec * m_current_speed;
-    while (cloudParticle->pos.x < cam.get_translation().x - static_cast<float>(cloudParticle->texture->get_width()))
-      cloudParticle->pos.x += virtual_width;
-    while (cloudParticle->pos.x > cam.get_translation().x + static_cast<float>(SCREEN_WIDTH))
-      cloudParticle->pos.x -= virtual_width;
-    while (cloudParticle->pos.y < cam.get_translation().y - static_cast<float>(cloudParticle->texture->get_height()))
-      cloudParticle->pos.y += virtual_height;
-    while (cloudParticle->pos.y > cam.get_translation().y + static_cast<float>(SCREEN_HEIGHT))
-      cloudParticle->pos.y -= virtual_height;
-
-    // Update alpha
-    if (cloudParticle->target_time_remaining > 0.f) {
-      if (dt_sec >= cloudParticle->target_time_remaining) {
-        cloudParticle->alpha = cloudParticle->target_alpha;
-        cloudParticle->target_time_remaining = 0.f;
-        if (cloudParticle->alpha == 0.f) {
-          // Remove this particle
-          // But not right here, else it'd mess with the iterator
-        }
+  move_particles(dt_sec * m_current_speed);
+
+  // All clouds share one texture
+  const float left = cam.get_translation().x - static_cast<float>(cloudimage->get_width());
+  const float right = cam.get_translation().x + static_cast<float>(SCREEN_WIDTH);
+  const float top = cam.get_translation().y - static_cast<float>(cloudimage->get_height());
+  const float bottom = cam.get_translation().y + static_cast<float>(SCREEN_HEIGHT);
+  for (size_t i = 0; i < particles.size(); ++i) {
+    while (particles.x[i] < left)
+      particles.x[i] += virtual_width;
+    while (particles.x[i] > right)
+      particles.x[i] -= virtual_width;
+    while (particles.y[i] < top)
+      particles.y[i] += virtual_height;
+    while (particles.y[i] > bottom)
+      particles.y[i] -= virtual_height;
+  }
+
+  // Update alpha
+  for (size_t i = 0; i < particles.size(); ++i) {
+    if (m_target_time_remaining[i] > 0.f) {
+      if (dt_sec >= m_target_time_remaining[i]) {
+        particles.alpha[i] = m_target_alpha[i];
+        m_target_time_remaining[i] = 0.f;
       } else {
-        float amount = dt_sec / cloudParticle->target_time_remaining;
-        cloudParticle->alpha += (cloudParticle->target_alpha - cloudParticle->alpha) * amount;
-        cloudParticle->target_time_remaining -= dt_sec;
+        float amount = dt_sec / m_target_time_remaining[i];
+        particles.alpha[i] += (m_target_alpha[i] - particles.alpha[i]) * amount;
+        m_target_time_remaining[i] -= dt_sec;
       }
     }
   }
 
   // Clear dead clouds
-  // Scroll through the vector backwards, because removing an element affects
-  //   the index of all elements after it (prevents buggy behavior)
-  for (int i = static_cast<int>(particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    
-    if (particle->target_alpha == 0.f && particle->target_time_remaining == 0.f)
-      particles.erase(particles.begin()+i);
-  }
+  remove_particles_if([this](size_t i) {
+      return m_target_alpha[i] == 0.f && m_target_time_remaining[i] == 0.f;
+    });
+}
+
+void
+CloudParticleSystem::resize_particles(size_t size)
+{
+  ParticleSystem::resize_particles(size);
+  m_target_alpha.resize(size);
+  m_target_time_remaining.resize(size);
+}
+
+void
+CloudParticleSystem::move_particle(size_t from, size_t to)
+{
+  ParticleSystem::move_particle(from, to);
+  m_target_alpha[to] = m_target_alpha[from];
+  m_target_time_remaining[to] = m_target_time_remaining[from];
 }
 
 int CloudParticleSystem::add_clouds(int amount, float fade_time)
@@ -155,18 +171,16 @@ int CloudParticleSystem::add_clouds(int amount, float fade_time)
   int amount_to_add = target_amount - m_current_real_amount;
 
   for (int i = 0; i < amount_to_add; ++i) {
-    auto particle = std::make_unique<CloudParticle>();
     // Don't consider the camera, because the Sector might not exist yet
     // Instead, rely on update() to correct this when it will be called
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(virtual_height);
-    particle->texture = cloudimage;
-    particle->speed = -graphicsRandom.randf(25.0, 54.0);
-    particle->alpha = (fade_time == 0.f) ? 1.f : 0.f;
-    particle->target_alpha = 1.f;
-    particle->target_time_remaining = fade_time;
-
-    particles.push_back(std::move(particle));
+    Vector pos(0.0f, 0.0f);
+    pos.x = graphicsRandom.randf(virtual_width);
+    pos.y = graphicsRandom.randf(virtual_height);
+    const size_t particle = append_particle(pos, cloudimage);
+    particles.speed_x[particle] = -graphicsRandom.randf(25.0, 54.0);
+    particles.alpha[particle] = (fade_time == 0.f) ? 1.f : 0.f;
+    m_target_alpha[particle] = 1.f;
+    m_target_time_remaining[particle] = fade_time;
   }
 
   m_current_real_amount = target_amount;
@@ -185,13 +199,12 @@ int CloudParticleSystem::remove_clouds(int amount, float fade_time)
   int i = 0;
   for (; i < amount_to_remove && i < static_cast<int>(particles.size()); ++i) {
   
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    if (particle->target_alpha != 1.f || particle->target_time_remaining != 0.f) {
+    if (m_target_alpha[i] != 1.f || m_target_time_remaining[i] != 0.f) {
       // Skip that one, it doesn't count
       --i;
     } else {
-      particle->target_alpha = 0.f;
-      particle->target_time_remaining = fade_time;
+      m_target_alpha[i] = 0.f;
+      m_target_time_remaining[i] = fade_time;
     }
   }
 
@@ -238,40 +251,27 @@ void CloudParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
+  auto batches = create_batches();
+
+  // Fading clouds each need their own color
+  std::vector<SurfaceBatch> faded_batches;
 
-    if(!region.contains(particle->pos))
+  for (size_t i = 0; i < particles.size(); ++i) {
+    const Vector pos(particles.x[i], particles.y[i]);
+    if(!region.contains(pos))
       continue;
 
-    if (particle->alpha != 1.f) {
-      const auto& batch_it = batches.emplace(
-          particle->texture->clone(),
-          SurfaceBatch(
-              particle->texture,
-              Color(1.f, 1.f, 1.f, particle->alpha)
-          ));
-      batch_it.first->second.draw(particle->pos, particle->angle);
+    if (particles.alpha[i] != 1.f) {
+      faded_batches.emplace_back(textures[particles.texture[i]],
+                                 Color(1.f, 1.f, 1.f, particles.alpha[i]));
+      faded_batches.back().draw(pos, particles.angle[i]);
     } else {
-      auto it = batches.find(particle->texture);
-      if (it == batches.end()) {
-        const auto& batch_it = batches.emplace(particle->texture,
-          SurfaceBatch(particle->texture));
-        batch_it.first->second.draw(particle->pos, particle->angle);
-      } else {
-        it->second.draw(particle->pos, particle->angle);
-      }
+      batches[particles.texture[i]].draw(pos, particles.angle[i]);
     }
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    // FIXME: What is the colour used for?
-    // RESOLVED : That's the tint and the alpha
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
-  }
+  draw_batches(context, batches);
+  draw_batches(context, faded_batches);
 
   context.pop_transform();
 }
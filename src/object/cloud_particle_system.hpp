@@ -67,20 +67,15 @@ private:
   /** Returns the amount that got removed (In case min_amount got hit) */
   int remove_clouds(int amount, float fade_time);
 
+protected:
+  virtual void resize_particles(size_t size) override;
+  virtual void move_particle(size_t from, size_t to) override;
+
 private:
-  class CloudParticle : public Particle
-  {
-  public:
-    float speed;
-    float target_alpha;
-    float target_time_remaining;
-
-    CloudParticle() :
-      speed(),
-      target_alpha(),
-      target_time_remaining()
-    {}
-  };
+  // Clouds only move horizontally, with the speed in speed_x
+
+  std::vector<float> m_target_alpha;
+  std::vector<float> m_target_time_remaining;
 
   SurfacePtr cloudimage;
 
@@ -16,6 +16,7 @@
 
 #include "object/custom_particle_system.hpp"
 
+#include <algorithm>
 #include <assert.h>
 #include <math.h>
 
@@ -29,7 +30,6 @@
 #include "object/camera.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/fadetoblack.hpp"
-#include "supertux/game_session.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
@@ -46,9 +46,21 @@ CustomParticleSystem::CustomParticleSystem() :
   ExposedObject<CustomParticleSystem, scripting::CustomParticles>(this),
   texture_sum_odds(0.f),
   time_last_remaining(0.f),
+  m_zone_index(),
   script_easings(),
   m_textures(),
+  m_particle_props(),
   custom_particles(),
+  m_acceleration_x(),
+  m_acceleration_y(),
+  m_friction_x(),
+  m_friction_y(),
+  m_feather_factor(),
+  m_angle_speed(),
+  m_angle_acceleration(),
+  m_angle_decceleration(),
+  m_hitbox(),
+  m_collision_box(),
   m_particle_main_texture("/images/engine/editor/sparkle.png"),
   m_max_amount(25),
   m_delay(0.1f),
@@ -90,9 +102,21 @@ CustomParticleSystem::CustomParticleSystem(const ReaderMapping& reader) :
   ExposedObject<CustomParticleSystem, scripting::CustomParticles>(this),
   texture_sum_odds(0.f),
   time_last_remaining(0.f),
+  m_zone_index(),
   script_easings(),
   m_textures(),
+  m_particle_props(),
   custom_particles(),
+  m_acceleration_x(),
+  m_acceleration_y(),
+  m_friction_x(),
+  m_friction_y(),
+  m_feather_factor(),
+  m_angle_speed(),
+  m_angle_acceleration(),
+  m_angle_decceleration(),
+  m_hitbox(),
+  m_collision_box(),
   m_particle_main_texture("/images/engine/editor/sparkle.png"),
   m_max_amount(25),
   m_delay(0.1f),
@@ -558,141 +582,147 @@ CustomParticleSystem::update(float dt_sec)
     }
   }
 
-  // Update existing particles
-  for (auto& it : custom_particles) {
-    auto particle = dynamic_cast<CustomParticle*>(it.get());
-    assert(particle);
+  update_zone_index();
+  const int zone_name_id = m_zone_index.intern(m_name);
 
-    if (particle->birth_time > dt_sec) {
-      switch(particle->birth_mode) {
+  if (Sector::current() && !particles.empty())
+    update_tile_mask(get_particle_bounds());
+
+  // Birth, life and death
+  for (size_t i = 0; i < particles.size(); ++i) {
+    auto& particle = custom_particles[i];
+
+    if (particle.birth_time > dt_sec) {
+      switch(particle.birth_mode) {
       case FadeMode::Shrink:
-        particle->scale = static_cast<float>(
-                          getEasingByName(particle->birth_easing)(
-                            static_cast<double>(
-                              1.f - (particle->birth_time / particle->total_birth)
-                            )
-                          ));
+        particles.scale[i] = static_cast<float>(
+                             getEasingByName(particle.birth_easing)(
+                               static_cast<double>(
+                                 1.f - (particle.birth_time / particle.total_birth)
+                               )
+                             ));
         break;
       case FadeMode::Fade:
-        particle->props = SpriteProperties(particle->original_props,
-                                           1.f - (particle->birth_time /
-                                                  particle->total_birth));
+        particles.alpha[i] = 1.f - (particle.birth_time / particle.total_birth);
         break;
       default:
         break;
       }
-      particle->birth_time -= dt_sec;
-    } else if (particle->birth_time > 0.f) {
-      particle->birth_time = 0.f;
-      switch(particle->birth_mode) {
+      particle.birth_time -= dt_sec;
+    } else if (particle.birth_time > 0.f) {
+      particle.birth_time = 0.f;
+      switch(particle.birth_mode) {
       case FadeMode::Shrink:
-        particle->scale = 1.f;
+        particles.scale[i] = 1.f;
         break;
       case FadeMode::Fade:
-        particle->props = particle->original_props;
+        particles.alpha[i] = 1.f;
         break;
       default:
         break;
       }
     }
 
-    particle->lifetime -= dt_sec;
-    if (particle->lifetime < 0.f) {
-      particle->lifetime = 0.f;
+    particle.lifetime -= dt_sec;
+    if (particle.lifetime < 0.f) {
+      particle.lifetime = 0.f;
     }
 
-    if (particle->birth_time <= 0.f && particle->lifetime <= 0.f) {
-      if (particle->death_time > dt_sec) {
-        switch(particle->death_mode) {
+    if (particle.birth_time <= 0.f && particle.lifetime <= 0.f) {
+      if (particle.death_time > dt_sec) {
+        switch(particle.death_mode) {
         case FadeMode::Shrink:
-          particle->scale = 1.f - static_cast<float>(
-                            getEasingByName(particle->death_easing)(
-                              static_cast<double>(
-                                1.f - (particle->death_time / particle->total_death)
-                              )
-                            ));
+          particles.scale[i] = 1.f - static_cast<float>(
+                               getEasingByName(particle.death_easing)(
+                                 static_cast<double>(
+                                   1.f - (particle.death_time / particle.total_death)
+                                 )
+                               ));
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props,
-                                                   (particle->death_time /
-                                                    particle->total_death));
+          particles.alpha[i] = particle.death_time / particle.total_death;
           break;
         default:
           break;
         }
-        particle->death_time -= dt_sec;
+        particle.death_time -= dt_sec;
       } else {
-        particle->death_time = 0.f;
-        switch(particle->death_mode) {
+        particle.death_time = 0.f;
+        switch(particle.death_mode) {
         case FadeMode::Shrink:
-          particle->scale = 0.f;
+          particles.scale[i] = 0.f;
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props, 0.f);
+          particles.alpha[i] = 0.f;
           break;
         default:
           break;
         }
-        particle->ready_for_deletion = true;
+        particle.ready_for_deletion = true;
       }
     }
+  }
 
-    float abs_x = get_abs_x();
-    float abs_y = get_abs_y();
+  // Offscreen particles
+  const float abs_x = get_abs_x();
+  const float abs_y = get_abs_y();
+  std::vector<unsigned char> on_screen(particles.size());
+  for (size_t i = 0; i < particles.size(); ++i) {
+    on_screen[i] = particles.y[i] <= static_cast<float>(SCREEN_HEIGHT) + abs_y
+                   && particles.y[i] >= abs_y
+                   && particles.x[i] <= static_cast<float>(SCREEN_WIDTH) + abs_x
+                   && particles.x[i] >= abs_x;
+  }
 
-    if (!particle->has_been_on_screen) {
-      if (particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y
-          && particle->pos.y >= abs_y
-          && particle->pos.x <= static_cast<float>(SCREEN_WIDTH) + abs_x
-          && particle->pos.x >= abs_x) {
-        particle->has_been_on_screen = true;
-      }
+  for (size_t i = 0; i < particles.size(); ++i) {
+    auto& particle = custom_particles[i];
+
+    if (on_screen[i]) {
+      particle.has_been_on_screen = true;
     }
 
-    switch(particle->offscreen_mode) {
+    switch(particle.offscreen_mode) {
     case OffscreenMode::Always:
-      if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x) {
-        particle->ready_for_deletion = true;
+      if (!on_screen[i]) {
+        particle.ready_for_deletion = true;
       }
       break;
     case OffscreenMode::OnlyOnExit:
-      if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x)
-          && particle->has_been_on_screen) {
-        particle->ready_for_deletion = true;
+      if (!on_screen[i] && particle.has_been_on_screen) {
+        particle.ready_for_deletion = true;
       }
       break;
     case OffscreenMode::Never:
       break;
     }
+  }
+
+  // Particle zones
+  for (size_t i = 0; i < particles.size(); ++i) {
+    auto& particle = custom_particles[i];
 
     bool is_in_life_zone = false;
-    for (auto& zone : get_zones()) {
-      if (zone.get_rect().contains(particle->pos) && zone.get_particle_name() == m_name) {
-        switch(zone.get_type()) {
+    m_zone_index.for_each_zone_at(zone_name_id, Vector(particles.x[i], particles.y[i]),
+                                  [&particle, &is_in_life_zone](const ParticleZoneIndex::Zone& zone) {
+        switch(zone.type) {
         case ParticleZone::ParticleZoneType::Killer:
-          particle->lifetime = 0.f;
-          particle->birth_time = 0.f;
+          particle.lifetime = 0.f;
+          particle.birth_time = 0.f;
           break;
 
         case ParticleZone::ParticleZoneType::Destroyer:
-          particle->ready_for_deletion = true;
+          particle.ready_for_deletion = true;
           break;
 
         case ParticleZone::ParticleZoneType::LifeClear:
-          particle->last_life_zone_required_instakill = true;
-          particle->has_been_in_life_zone = true;
+          particle.last_life_zone_required_instakill = true;
+          particle.has_been_in_life_zone = true;
           is_in_life_zone = true;
           break;
 
         case ParticleZone::ParticleZoneType::Life:
-          particle->last_life_zone_required_instakill = false;
-          particle->has_been_in_life_zone = true;
+          particle.last_life_zone_required_instakill = false;
+          particle.has_been_in_life_zone = true;
           is_in_life_zone = true;
           break;
 
@@ -700,124 +730,139 @@ CustomParticleSystem::update(float dt_sec)
         case ParticleZone::ParticleZoneType::Spawn:
           break;
         }
-      }
-    } // For each ParticleZone object
+      }); // For each ParticleZone object
 
-    if (!is_in_life_zone && particle->has_been_in_life_zone) {
-      if (particle->last_life_zone_required_instakill) {
-        particle->ready_for_deletion = true;
+    if (!is_in_life_zone && particle.has_been_in_life_zone) {
+      if (particle.last_life_zone_required_instakill) {
+        particle.ready_for_deletion = true;
       } else {
-        particle->lifetime = 0.f;
-        particle->birth_time = 0.f;
+        particle.lifetime = 0.f;
+        particle.birth_time = 0.f;
       }
     }
+  }
 
-    if (!particle->stuck) {
-      particle->speedX += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedY += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedX += particle->accX * dt_sec;
-      particle->speedY += particle->accY * dt_sec;
-      particle->speedX *= 1.f - particle->frictionX * dt_sec;
-      particle->speedY *= 1.f - particle->frictionY * dt_sec;
-
-      if (Sector::current() && collision(particle,
-                    Vector(particle->speedX,particle->speedY) * dt_sec) > 0) {
-        switch(particle->collision_mode) {
-        case CollisionMode::Ignore:
-          particle->pos.x += particle->speedX * dt_sec;
-          particle->pos.y += particle->speedY * dt_sec;
-          break;
-        case CollisionMode::Stick:
-          // Just don't move
-          break;
-        case CollisionMode::StickForever:
-          particle->stuck = true;
-          break;
-        case CollisionMode::BounceHeavy:
-        case CollisionMode::BounceLight:
-          {
-            auto c = get_collision(particle, Vector(particle->speedX, particle->speedY) * dt_sec);
-
-            float speed_angle = atanf(-particle->speedY / particle->speedX);
-            float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
-            if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
-              auto cX = get_collision(particle, Vector(particle->speedX, 0) * dt_sec);
-              if (cX.left != cX.right)
-                particle->speedX *= -1;
-              auto cY = get_collision(particle, Vector(0, particle->speedY) * dt_sec);
-              if (cY.top != cY.bottom)
-                particle->speedY *= -1;
-            } else {
-              float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle
-              float dX = cosf(dest_angle),
-                    dY = sinf(dest_angle);
-
-              float true_speed = static_cast<float>(sqrt(pow(particle->speedY, 2)
-                                                      + pow(particle->speedX, 2)));
-
-              particle->speedX = dX * true_speed;
-              particle->speedY = dY * true_speed;
-            }
-
-            switch(particle->collision_mode) {
-              case CollisionMode::BounceHeavy:
-                particle->speedX *= .2f;
-                particle->speedY *= .2f;
-                break;
-              case CollisionMode::BounceLight:
-                particle->speedX *= .7f;
-                particle->speedY *= .7f;
-                break;
-              default:
-                assert(false);
-            }
-
-            particle->pos.x += particle->speedX * dt_sec;
-            particle->pos.y += particle->speedY * dt_sec;
+  // Speed, stuck particles never use theirs again
+  for (size_t i = 0; i < particles.size(); ++i) {
+    if (!custom_particles[i].stuck) {
+      particles.speed_x[i] += graphicsRandom.randf(-m_feather_factor[i],
+                                                   m_feather_factor[i]) * dt_sec * 1000.f;
+      particles.speed_y[i] += graphicsRandom.randf(-m_feather_factor[i],
+                                                   m_feather_factor[i]) * dt_sec * 1000.f;
+    }
+  }
+
+  for (size_t i = 0; i < particles.size(); ++i) {
+    particles.speed_x[i] += m_acceleration_x[i] * dt_sec;
+    particles.speed_y[i] += m_acceleration_y[i] * dt_sec;
+    particles.speed_x[i] *= 1.f - m_friction_x[i] * dt_sec;
+    particles.speed_y[i] *= 1.f - m_friction_y[i] * dt_sec;
+  }
+
+  // Collisions and rotation, `move` is the time each particle moves
+  std::vector<float> move(particles.size(), 0.f);
+  for (size_t i = 0; i < particles.size(); ++i) {
+    auto& particle = custom_particles[i];
+    if (particle.stuck)
+      continue;
+
+    float& speed_x = particles.speed_x[i];
+    float& speed_y = particles.speed_y[i];
+
+    move[i] = dt_sec;
+    if (Sector::current() && collision(i, Vector(speed_x, speed_y) * dt_sec) > 0) {
+      switch(particle.collision_mode) {
+      case CollisionMode::Ignore:
+        break;
+      case CollisionMode::Stick:
+        // Just don't move
+        move[i] = 0.f;
+        break;
+      case CollisionMode::StickForever:
+        particle.stuck = true;
+        move[i] = 0.f;
+        break;
+      case CollisionMode::BounceHeavy:
+      case CollisionMode::BounceLight:
+        {
+          auto c = get_collision(i, Vector(speed_x, speed_y) * dt_sec);
+
+          float speed_angle = atanf(-speed_y / speed_x);
+          float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
+          if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
+            auto cX = get_collision(i, Vector(speed_x, 0) * dt_sec);
+            if (cX.left != cX.right)
+              speed_x *= -1;
+            auto cY = get_collision(i, Vector(0, speed_y) * dt_sec);
+            if (cY.top != cY.bottom)
+              speed_y *= -1;
+          } else {
+            float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle
+            float dX = cosf(dest_angle),
+                  dY = sinf(dest_angle);
+
+            float true_speed = static_cast<float>(sqrt(pow(speed_y, 2)
+                                                    + pow(speed_x, 2)));
+
+            speed_x = dX * true_speed;
+            speed_y = dY * true_speed;
           }
-          break;
-        case CollisionMode::Destroy:
-          particle->ready_for_deletion = true;
-          break;
-        case CollisionMode::FadeOut:
-          particle->lifetime = 0.f;
-          break;
-        }
-      } else {
-        particle->pos.x += particle->speedX * dt_sec;
-        particle->pos.y += particle->speedY * dt_sec;
-      }
 
-      switch(particle->angle_mode) {
-      case RotationMode::Facing:
-        particle->angle = atanf(particle->speedY / particle->speedX) * 180.f / math::PI;
+          switch(particle.collision_mode) {
+            case CollisionMode::BounceHeavy:
+              speed_x *= .2f;
+              speed_y *= .2f;
+              break;
+            case CollisionMode::BounceLight:
+              speed_x *= .7f;
+              speed_y *= .7f;
+              break;
+            default:
+              assert(false);
+          }
+        }
         break;
-      case RotationMode::Wiggling:
-        particle->angle += graphicsRandom.randf(-particle->angle_speed / 2.f,
-                                            particle->angle_speed / 2.f) * dt_sec;
+      case CollisionMode::Destroy:
+        particle.ready_for_deletion = true;
+        move[i] = 0.f;
+        break;
+      case CollisionMode::FadeOut:
+        particle.lifetime = 0.f;
+        move[i] = 0.f;
         break;
-      case RotationMode::Fixed:
-      default:
-        particle->angle_speed += particle->angle_acc * dt_sec;
-        particle->angle_speed *= 1.f - particle->angle_decc * dt_sec;
-        particle->angle += particle->angle_speed * dt_sec;
       }
     }
 
-  } // For each particle
+    switch(particle.angle_mode) {
+    case RotationMode::Facing:
+      particles.angle[i] = atanf(speed_y / speed_x) * 180.f / math::PI;
+      break;
+    case RotationMode::Wiggling:
+      particles.angle[i] += graphicsRandom.randf(-m_angle_speed[i] / 2.f,
+                                                 m_angle_speed[i] / 2.f) * dt_sec;
+      break;
+    case RotationMode::Fixed:
+    default:
+      m_angle_speed[i] += m_angle_acceleration[i] * dt_sec;
+      m_angle_speed[i] *= 1.f - m_angle_decceleration[i] * dt_sec;
+      particles.angle[i] += m_angle_speed[i] * dt_sec;
+    }
+  }
 
+  for (size_t i = 0; i < particles.size(); ++i) {
+    particles.x[i] += particles.speed_x[i] * move[i];
+    particles.y[i] += particles.speed_y[i] * move[i];
+  }
 
   // Clear dead particles
-  // Scroll through the vector backwards, because removing an element affects
-  //   the index of all elements after it (prevents buggy behavior)
-  for (int i = static_cast<int>(custom_particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CustomParticle*>(custom_particles.at(i).get());
-
-    if (particle->ready_for_deletion) {
-      custom_particles.erase(custom_particles.begin()+i);
-    }
+  remove_particles_if([this](size_t i) {
+      return custom_particles[i].ready_for_deletion;
+    });
+
+  if (particles.empty()) {
+    // Nothing refers to them anymore
+    m_particle_props.clear();
+    textures.clear();
   }
 
   // Add necessary particles
@@ -826,15 +871,9 @@ CustomParticleSystem::update(float dt_sec)
   if (enabled) {
     int real_max = m_max_amount;
     if (!m_cover_screen) {
-      int i = 0;
-      for (auto& zone : get_zones()) {
-        if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn && zone.get_particle_name() == m_name) {
-          i++;
-        }
-      }
-      real_max *= i;
+      real_max *= m_zone_index.count_zones(zone_name_id, ParticleZone::ParticleZoneType::Spawn);
     }
-    while (remaining > m_delay && int(custom_particles.size()) < real_max)
+    while (remaining > m_delay && int(particles.size()) < real_max)
     {
       spawn_particles(remaining);
       remaining -= m_delay;
@@ -858,55 +897,35 @@ CustomParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SpriteProperties*, SurfaceBatch> batches;
-  for (const auto& particle : custom_particles) {
-    auto it = batches.find(&(particle->props));
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(&(particle->props),
-        SurfaceBatch(particle->props.texture, particle->props.color));
-      batch_it.first->second.draw(Rectf(Vector(
-                                               particle->pos.x - particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y - particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
-                                        ),
-                                        Vector(
-                                               particle->pos.x + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
-                                        )
-                                 ), particle->angle);
+  // One batch per sprite properties, fading particles each need their
+  // own color
+  std::vector<SurfaceBatch> batches;
+  std::vector<Vector> half_sizes;
+  for (const auto& props : m_particle_props) {
+    batches.emplace_back(props.texture, props.color);
+    half_sizes.push_back(Vector(static_cast<float>(props.texture->get_width()) * props.scale.x / 2,
+                                static_cast<float>(props.texture->get_height()) * props.scale.y / 2));
+  }
+  std::vector<SurfaceBatch> faded_batches;
+
+  for (size_t i = 0; i < particles.size(); ++i) {
+    const int props = custom_particles[i].props;
+    const Vector half_size = half_sizes[props] * particles.scale[i];
+    const Rectf rect(particles.x[i] - half_size.x, particles.y[i] - half_size.y,
+                     particles.x[i] + half_size.x, particles.y[i] + half_size.y);
+
+    if (particles.alpha[i] != 1.f) {
+      Color color = m_particle_props[props].color;
+      color.alpha *= particles.alpha[i];
+      faded_batches.emplace_back(m_particle_props[props].texture, color);
+      faded_batches.back().draw(rect, particles.angle[i]);
     } else {
-      it->second.draw(Rectf(particle->pos,
-                                        Vector(
-                                               particle->pos.x + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->texture->get_width()
-                                               ) * particle->props.scale.x,
-                                               particle->pos.y + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->texture->get_height()
-                                               ) * particle->props.scale.y
-                                        )
-                                 ), particle->angle);
+      batches[props].draw(rect, particles.angle[i]);
     }
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first->texture;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), it.first->color, z_pos);
-  }
+  draw_batches(context, batches);
+  draw_batches(context, faded_batches);
 
   context.pop_transform();
 }
@@ -914,29 +933,26 @@ CustomParticleSystem::draw(DrawingContext& context)
 // Duplicated from ParticleSystem_Interactive because I intend to bring edits
 // sometime in the future, for even more flexibility with particles. (Semphris)
 int
-CustomParticleSystem::collision(Particle* object, const Vector& movement)
+CustomParticleSystem::collision(size_t particle, const Vector& movement)
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
+  const Rectf& hitbox = m_hitbox[particle];
 
   // calculate rectangle where the object will move
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) / 2
-          + particle->props.hb_offset.x * static_cast<float>(particle->props.texture->get_width());
-  x2 = x1 + particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = particles.x[particle] + hitbox.get_left();
+  x2 = x1 + hitbox.get_width() + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) / 2
-          + particle->props.hb_offset.y * static_cast<float>(particle->props.texture->get_height());
-  y2 = y1 + particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = particles.y[particle] + hitbox.get_top();
+  y2 = y1 + hitbox.get_height() + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
@@ -950,6 +966,9 @@ CustomParticleSystem::collision(Particle* object, const Vector& movement)
   int max_x = int(x2+1);
   int max_y = int(y2+1);
 
+  if (!may_hit_tiles(starttilex, starttiley, max_x, max_y))
+    return -1;
+
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
@@ -1003,27 +1022,26 @@ CustomParticleSystem::collision(Particle* object, const Vector& movement)
 }
 
 CollisionHit
-CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
+CustomParticleSystem::get_collision(size_t particle, const Vector& movement)
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
+  const Rectf& box = m_collision_box[particle];
 
   // calculate rectangle where the object will move
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) / 2;
-  x2 = x1 + particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = particles.x[particle] + box.get_left();
+  x2 = x1 + box.get_width() + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) / 2;
-  y2 = y1 + particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = particles.y[particle] + box.get_top();
+  y2 = y1 + box.get_height() + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
@@ -1036,6 +1054,9 @@ CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
   int max_x = int(x2+1);
   int max_y = int(y2+1);
 
+  if (!may_hit_tiles(starttilex, starttiley, max_x, max_y))
+    return CollisionHit();
+
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
@@ -1086,33 +1107,30 @@ CustomParticleSystem::get_random_texture()
   return m_textures.at(0);
 }
 
-std::vector<ParticleZone::ZoneDetails>
-CustomParticleSystem::get_zones()
+void
+CustomParticleSystem::update_zone_index()
 {
-  std::vector<ParticleZone::ZoneDetails> list;
+  m_zone_index.clear();
 
   //if (!!GameSession::current() && Sector::current()) {
   if (!ParticleEditor::current()) {
 
     // In game or in level editor
-    for (auto& zone : GameSession::current()->get_current_sector().get_objects_by_type<ParticleZone>()) {
-      list.push_back(zone.get_details());
+    for (auto& zone : Sector::get().get_objects_by_type<ParticleZone>()) {
+      m_zone_index.add(zone.get_particle_name(), zone.get_type(), zone.get_rect());
     }
 
   } else {
 
     // In particle editor
-    list.push_back(ParticleZone::ZoneDetails(m_name,
-                                             ParticleZone::ParticleZoneType::Spawn,
-                                             Rectf(virtual_width / 2 - 16.f,
-                                                   virtual_height / 2 - 16.f,
-                                                   virtual_width / 2 + 16.f,
-                                                   virtual_height / 2 + 16.f)
-                                            ));
+    m_zone_index.add(m_name,
+                     ParticleZone::ParticleZoneType::Spawn,
+                     Rectf(virtual_width / 2 - 16.f,
+                           virtual_height / 2 - 16.f,
+                           virtual_width / 2 + 16.f,
+                           virtual_height / 2 + 16.f));
 
   }
-
-  return list;
 }
 
 float
@@ -1134,87 +1152,138 @@ CustomParticleSystem::get_abs_y()
 void
 CustomParticleSystem::add_particle(float lifetime, float x, float y)
 {
-  auto particle = std::make_unique<CustomParticle>();
-  particle->original_props = get_random_texture();
-  particle->props = particle->original_props;
-
-  particle->pos.x = x;
-  particle->pos.y = y;
+  const SpriteProperties props = get_random_texture();
+  const size_t index = append_particle(Vector(x, y), props.texture);
+  auto& particle = custom_particles[index];
+  particle.props = add_particle_props(props);
+
+  // The textures don't change during the life of a particle, so the
+  // collision boxes are computed once here instead of every frame
+  const float width = static_cast<float>(props.texture->get_width());
+  const float height = static_cast<float>(props.texture->get_height());
+  m_hitbox[index] = Rectf(Vector(width * (props.hb_offset.x - props.hb_scale.x / 2),
+                                 height * (props.hb_offset.y - props.hb_scale.y / 2)),
+                          Sizef(width * props.hb_scale.x, height * props.hb_scale.y));
+  m_collision_box[index] = Rectf(Vector(-width * props.scale.x / 2, -height * props.scale.y / 2),
+                                 Sizef(width * props.scale.x, height * props.scale.y));
 
   float life_elapsed = lifetime;
   float birth_delta = m_particle_birth_time_variation / 2;
-  particle->total_birth = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
-  particle->birth_time = particle->total_birth - life_elapsed;
-  if (particle->birth_time < 0.f) {
-    life_elapsed = -particle->birth_time;
-    particle->birth_time = 0.f;
+  particle.total_birth = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
+  particle.birth_time = particle.total_birth - life_elapsed;
+  if (particle.birth_time < 0.f) {
+    life_elapsed = -particle.birth_time;
+    particle.birth_time = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float life_delta = m_particle_lifetime_variation / 2;
-  particle->lifetime = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
-  if (particle->lifetime < 0.f) {
-    life_elapsed = -particle->lifetime;
-    particle->lifetime = 0.f;
+  particle.lifetime = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
+  if (particle.lifetime < 0.f) {
+    life_elapsed = -particle.lifetime;
+    particle.lifetime = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float death_delta = m_particle_death_time_variation / 2;
-  particle->total_death = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
-  particle->death_time = particle->total_death - life_elapsed;
+  particle.total_death = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
+  particle.death_time = particle.total_death - life_elapsed;
 
-  particle->birth_mode = m_particle_birth_mode;
-  particle->death_mode = m_particle_death_mode;
+  particle.birth_mode = m_particle_birth_mode;
+  particle.death_mode = m_particle_death_mode;
 
-  particle->birth_easing = m_particle_birth_easing;
-  particle->death_easing = m_particle_death_easing;
+  particle.birth_easing = m_particle_birth_easing;
+  particle.death_easing = m_particle_death_easing;
 
-  switch(particle->birth_mode) {
+  switch(particle.birth_mode) {
   case FadeMode::Shrink:
-    particle->scale = 0.f;
+    particles.scale[index] = 0.f;
     break;
   default:
     break;
   }
 
   float speedx_delta = m_particle_speed_variation_x / 2;
-  particle->speedX = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
+  particles.speed_x[index] = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
   float speedy_delta = m_particle_speed_variation_y / 2;
-  particle->speedY = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
-  particle->accX = m_particle_acceleration_x;
-  particle->accY = m_particle_acceleration_y;
-  particle->frictionX = m_particle_friction_x;
-  particle->frictionY = m_particle_friction_y;
+  particles.speed_y[index] = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
+  m_acceleration_x[index] = m_particle_acceleration_x;
+  m_acceleration_y[index] = m_particle_acceleration_y;
+  m_friction_x[index] = m_particle_friction_x;
+  m_friction_y[index] = m_particle_friction_y;
 
-  particle->feather_factor = m_particle_feather_factor;
+  m_feather_factor[index] = m_particle_feather_factor;
 
   float angle_delta = m_particle_rotation_variation / 2;
-  particle->angle = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
+  particles.angle[index] = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
   float angle_speed_delta = m_particle_rotation_speed_variation / 2;
-  particle->angle_speed = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
-  particle->angle_acc = m_particle_rotation_acceleration;
-  particle->angle_decc = m_particle_rotation_decceleration;
-  particle->angle_mode = m_particle_rotation_mode;
+  m_angle_speed[index] = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
+  m_angle_acceleration[index] = m_particle_rotation_acceleration;
+  m_angle_decceleration[index] = m_particle_rotation_decceleration;
+  particle.angle_mode = m_particle_rotation_mode;
+
+  particle.collision_mode = m_particle_collision_mode;
+
+  particle.offscreen_mode = m_particle_offscreen_mode;
+}
+
+int
+CustomParticleSystem::add_particle_props(const SpriteProperties& props)
+{
+  for (size_t i = 0; i < m_particle_props.size(); ++i) {
+    if (m_particle_props[i] == props)
+      return static_cast<int>(i);
+  }
 
-  particle->collision_mode = m_particle_collision_mode;
+  m_particle_props.push_back(props);
+  return static_cast<int>(m_particle_props.size()) - 1;
+}
 
-  particle->offscreen_mode = m_particle_offscreen_mode;
+void
+CustomParticleSystem::resize_particles(size_t size)
+{
+  ParticleSystem::resize_particles(size);
+  custom_particles.resize(size);
+  m_acceleration_x.resize(size);
+  m_acceleration_y.resize(size);
+  m_friction_x.resize(size);
+  m_friction_y.resize(size);
+  m_feather_factor.resize(size);
+  m_angle_speed.resize(size);
+  m_angle_acceleration.resize(size);
+  m_angle_decceleration.resize(size);
+  m_hitbox.resize(size);
+  m_collision_box.resize(size);
+}
 
-  custom_particles.push_back(std::move(particle));
+void
+CustomParticleSystem::move_particle(size_t from, size_t to)
+{
+  ParticleSystem::move_particle(from, to);
+  custom_particles[to] = custom_particles[from];
+  m_acceleration_x[to] = m_acceleration_x[from];
+  m_acceleration_y[to] = m_acceleration_y[from];
+  m_friction_x[to] = m_friction_x[from];
+  m_friction_y[to] = m_friction_y[from];
+  m_feather_factor[to] = m_feather_factor[from];
+  m_angle_speed[to] = m_angle_speed[from];
+  m_angle_acceleration[to] = m_angle_acceleration[from];
+  m_angle_decceleration[to] = m_angle_decceleration[from];
+  m_hitbox[to] = m_hitbox[from];
+  m_collision_box[to] = m_collision_box[from];
 }
 
 void
 CustomParticleSystem::spawn_particles(float lifetime)
 {
   if (!m_cover_screen) {
-    for (auto& zone : get_zones()) {
-      if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn && zone.get_particle_name() == m_name) {
-        Rectf rect = zone.get_rect();
+    m_zone_index.for_each_zone(m_zone_index.intern(m_name), ParticleZone::ParticleZoneType::Spawn,
+                               [this, lifetime](const ParticleZoneIndex::Zone& zone) {
+        const Rectf& rect = zone.rect;
         add_particle(lifetime,
                      graphicsRandom.randf(rect.get_width()) + rect.get_left(),
                      graphicsRandom.randf(rect.get_height()) + rect.get_top());
-      }
-    }
+      });
   } else {
     float abs_x = get_abs_x();
     float abs_y = get_abs_y();
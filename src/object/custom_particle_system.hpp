@@ -18,9 +18,11 @@
 #define HEADER_SUPERTUX_OBJECT_CUSTOM_PARTICLE_SYSTEM_HPP
 
 #include "math/easing.hpp"
+#include "math/rectf.hpp"
 #include "math/vector.hpp"
 #include "object/particlesystem_interactive.hpp"
 #include "object/particle_zone.hpp"
+#include "object/particle_zone_index.hpp"
 #include "scripting/custom_particles.hpp"
 #include "video/surface.hpp"
 #include "video/surface_ptr.hpp"
@@ -60,8 +62,11 @@ public:
 
   //void fade_amount(int new_amount, float fade_time);
 protected:
-  virtual int collision(Particle* particle, const Vector& movement) override;
-  CollisionHit get_collision(Particle* particle, const Vector& movement);
+  virtual int collision(size_t particle, const Vector& movement) override;
+  CollisionHit get_collision(size_t particle, const Vector& movement);
+
+  virtual void resize_particles(size_t size) override;
+  virtual void move_particle(size_t from, size_t to) override;
 
 private:
   struct ease_request
@@ -78,7 +83,8 @@ private:
   void add_particle(float lifetime, float x, float y);
   void spawn_particles(float lifetime);
 
-  std::vector<ParticleZone::ZoneDetails> get_zones();
+  /** Rebuilds m_zone_index from the zones of the current sector */
+  void update_zone_index();
 
   float get_abs_x();
   float get_abs_y();
@@ -86,9 +92,11 @@ private:
   float texture_sum_odds;
   float time_last_remaining;
 
+  ParticleZoneIndex m_zone_index;
+
 public:
   // Scripting
-  void clear() { custom_particles.clear(); }
+  void clear() { resize_particles(0); }
   void ease_value(float* value, float target, float time, easing func);
 
 private:
@@ -179,21 +187,22 @@ private:
 
   SpriteProperties get_random_texture();
 
-  class CustomParticle : public Particle
+  /** Returns the index of `props` in m_particle_props, adds it if
+      needed */
+  int add_particle_props(const SpriteProperties& props);
+
+  /** State of a particle that only the branchy parts of update() use,
+      the rest is in the particle columns */
+  class CustomParticle final
   {
   public:
-    SpriteProperties original_props, props;
+    // index into m_particle_props
+    int props;
     float lifetime, birth_time, death_time,
           total_birth, total_death;
     FadeMode birth_mode, death_mode;
     EasingMode birth_easing, death_easing;
     bool ready_for_deletion;
-    float speedX, speedY,
-          accX, accY,
-          frictionX, frictionY;
-    float feather_factor;
-    float angle_speed, angle_acc,
-          angle_decc;
     RotationMode angle_mode;
     CollisionMode collision_mode;
     OffscreenMode offscreen_mode;
@@ -203,7 +212,6 @@ private:
     bool stuck;
 
     CustomParticle() :
-      original_props(),
       props(),
       lifetime(),
       birth_time(),
@@ -215,16 +223,6 @@ private:
       birth_easing(),
       death_easing(),
       ready_for_deletion(false),
-      speedX(),
-      speedY(),
-      accX(),
-      accY(),
-      frictionX(),
-      frictionY(),
-      feather_factor(),
-      angle_speed(),
-      angle_acc(),
-      angle_decc(),
       angle_mode(),
       collision_mode(),
       offscreen_mode(),
@@ -236,7 +234,28 @@ private:
   };
 
   std::vector<SpriteProperties> m_textures;
-  std::vector<std::unique_ptr<CustomParticle> > custom_particles;
+
+  /** Sprite properties of the existing particles, they keep theirs when
+      m_textures changes */
+  std::vector<SpriteProperties> m_particle_props;
+
+  std::vector<CustomParticle> custom_particles;
+  std::vector<float> m_acceleration_x;
+  std::vector<float> m_acceleration_y;
+  std::vector<float> m_friction_x;
+  std::vector<float> m_friction_y;
+  std::vector<float> m_feather_factor;
+  std::vector<float> m_angle_speed;
+  std::vector<float> m_angle_acceleration;
+  std::vector<float> m_angle_decceleration;
+
+  /** Hitbox of each particle relative to its position, used by
+      collision() */
+  std::vector<Rectf> m_hitbox;
+
+  /** Scaled texture area of each particle relative to its position,
+      used by get_collision() */
+  std::vector<Rectf> m_collision_box;
 
   std::string m_particle_main_texture;
   int m_max_amount;
@@ -32,6 +32,8 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  /** The light is a lot larger than the explosion sprite */
+  virtual float get_draw_margin() const override { return 512.0f; }
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
   virtual bool is_saveable() const override { return false; }
 
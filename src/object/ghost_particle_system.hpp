@@ -40,15 +40,7 @@ public:
   }
 
 private:
-  class GhostParticle : public Particle
-  {
-  public:
-    float speed;
-
-    GhostParticle() :
-      speed()
-    {}
-  };
+  // Ghosts fly diagonally, the speed columns hold the same speed
 
   SurfacePtr ghosts[2];
 
@@ -31,6 +31,8 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  /** The infobox above the block can get arbitrarily tall */
+  virtual float get_draw_margin() const override { return -1.0f; }
 
   virtual std::string get_class() const override { return "infoblock"; }
   virtual std::string get_display_name() const override { return _("Info Block"); }
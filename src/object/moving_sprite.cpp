@@ -121,6 +121,13 @@ MovingSprite::set_action(const std::string& action, int loops)
   m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
 }
 
+void
+MovingSprite::set_action(const ActionId& action, int loops)
+{
+  m_sprite->set_action(action, loops);
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+}
+
 void
 MovingSprite::set_action_centered(const std::string& action, int loops)
 {
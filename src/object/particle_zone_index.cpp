@@ -0,0 +1,114 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "object/particle_zone_index.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+namespace {
+
+/** Clamps cell coordinates so that zones at absurd positions can't
+    overflow the cell keys. */
+const float MAX_CELL_COORD = 1048576.0f;
+
+} // namespace
+
+bool ParticleZoneIndex::s_use_grid = true;
+
+ParticleZoneIndex::ParticleZoneIndex(float cell_size) :
+  m_cell_size(cell_size),
+  m_name_ids(),
+  m_zones(),
+  m_cells(),
+  m_oversized()
+{
+  assert(m_cell_size > 0.0f);
+}
+
+void
+ParticleZoneIndex::clear()
+{
+  m_zones.clear();
+  for (auto& cell : m_cells) {
+    cell.second.clear();
+  }
+  m_oversized.clear();
+}
+
+int
+ParticleZoneIndex::intern(const std::string& particle_name)
+{
+  auto it = m_name_ids.find(particle_name);
+  if (it != m_name_ids.end())
+    return it->second;
+
+  const int id = static_cast<int>(m_name_ids.size());
+  m_name_ids[particle_name] = id;
+  return id;
+}
+
+void
+ParticleZoneIndex::add(const std::string& particle_name, ParticleZone::ParticleZoneType type, const Rectf& rect)
+{
+  const uint32_t idx = static_cast<uint32_t>(m_zones.size());
+  m_zones.push_back(Zone{ intern(particle_name), type, rect });
+
+  const int left = to_cell(std::min(rect.get_left(), rect.get_right()));
+  const int right = to_cell(std::max(rect.get_left(), rect.get_right()));
+  const int top = to_cell(std::min(rect.get_top(), rect.get_bottom()));
+  const int bottom = to_cell(std::max(rect.get_top(), rect.get_bottom()));
+
+  const int64_t cell_count = (static_cast<int64_t>(right) - left + 1) *
+                             (static_cast<int64_t>(bottom) - top + 1);
+  if (cell_count > MAX_CELLS_PER_ZONE) {
+    m_oversized.push_back(idx);
+    return;
+  }
+
+  for (int y = top; y <= bottom; ++y) {
+    for (int x = left; x <= right; ++x) {
+      m_cells[cell_key(x, y)].push_back(idx);
+    }
+  }
+}
+
+int
+ParticleZoneIndex::count_zones(int name_id, ParticleZone::ParticleZoneType type) const
+{
+  int count = 0;
+  for (const auto& zone : m_zones) {
+    if (zone.name_id == name_id && zone.type == type) {
+      count += 1;
+    }
+  }
+  return count;
+}
+
+int
+ParticleZoneIndex::to_cell(float v) const
+{
+  const float cell = floorf(v / m_cell_size);
+  if (!(cell > -MAX_CELL_COORD))
+    return -static_cast<int>(MAX_CELL_COORD);
+  if (!(cell < MAX_CELL_COORD))
+    return static_cast<int>(MAX_CELL_COORD);
+  return static_cast<int>(cell);
+}
+
+/* EOF */
@@ -0,0 +1,155 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_OBJECT_PARTICLE_ZONE_INDEX_HPP
+#define HEADER_SUPERTUX_OBJECT_PARTICLE_ZONE_INDEX_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "math/vector.hpp"
+#include "object/particle_zone.hpp"
+
+/**
+ * Snapshot of the ParticleZones of a sector, rebuilt once per frame so
+ * that particles can be tested against the zones without copying them
+ * per particle.
+ *
+ * Particle names are interned to integer ids, the ids stay valid when
+ * the index is cleared. Zones are binned into a uniform grid, point
+ * queries only look at the zones of one cell.
+ */
+class ParticleZoneIndex final
+{
+public:
+  struct Zone
+  {
+    int name_id;
+    ParticleZone::ParticleZoneType type;
+    Rectf rect;
+  };
+
+  /** Zones touching more cells than this are tested by every query. */
+  static const int MAX_CELLS_PER_ZONE = 256;
+
+  /** Whether point queries use the grid, benchmarks turn it off to
+      compare against testing every zone */
+  static bool s_use_grid;
+
+public:
+  ParticleZoneIndex(float cell_size = 256.0f);
+
+  /** Removes all zones */
+  void clear();
+
+  void add(const std::string& particle_name, ParticleZone::ParticleZoneType type, const Rectf& rect);
+
+  /** Returns the id of `particle_name`, interning it if needed */
+  int intern(const std::string& particle_name);
+
+  /** Calls `func` for every zone of `name_id` that contains `pos`, in
+      the order in which the zones were added */
+  template<typename F>
+  void for_each_zone_at(int name_id, const Vector& pos, F func) const;
+
+  /** Calls `func` for every zone of `name_id` and `type` */
+  template<typename F>
+  void for_each_zone(int name_id, ParticleZone::ParticleZoneType type, F func) const;
+
+  int count_zones(int name_id, ParticleZone::ParticleZoneType type) const;
+
+  size_t size() const { return m_zones.size(); }
+
+private:
+  int to_cell(float v) const;
+
+  static uint64_t cell_key(int x, int y)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+            static_cast<uint64_t>(static_cast<uint32_t>(y));
+  }
+
+private:
+  float m_cell_size;
+  std::unordered_map<std::string, int> m_name_ids;
+  std::vector<Zone> m_zones;
+
+  /** Zone indices per cell, cells are kept when clearing to avoid
+      reallocating them every frame */
+  std::unordered_map<uint64_t, std::vector<uint32_t> > m_cells;
+  std::vector<uint32_t> m_oversized;
+
+private:
+  ParticleZoneIndex(const ParticleZoneIndex&) = delete;
+  ParticleZoneIndex& operator=(const ParticleZoneIndex&) = delete;
+};
+
+template<typename F>
+void
+ParticleZoneIndex::for_each_zone_at(int name_id, const Vector& pos, F func) const
+{
+  static const std::vector<uint32_t> s_empty;
+
+  if (!s_use_grid) {
+    for (const auto& zone : m_zones) {
+      if (zone.name_id == name_id && zone.rect.contains(pos)) {
+        func(zone);
+      }
+    }
+    return;
+  }
+
+  auto it = m_cells.find(cell_key(to_cell(pos.x), to_cell(pos.y)));
+  const std::vector<uint32_t>& cell = (it == m_cells.end()) ? s_empty : it->second;
+
+  // Both lists are sorted, merge them to keep the insertion order
+  auto i = cell.begin();
+  auto j = m_oversized.begin();
+  while (i != cell.end() || j != m_oversized.end())
+  {
+    uint32_t idx;
+    if (j == m_oversized.end() || (i != cell.end() && *i < *j)) {
+      idx = *i++;
+    } else {
+      idx = *j++;
+    }
+
+    const Zone& zone = m_zones[idx];
+    if (zone.name_id == name_id && zone.rect.contains(pos)) {
+      func(zone);
+    }
+  }
+}
+
+template<typename F>
+void
+ParticleZoneIndex::for_each_zone(int name_id, ParticleZone::ParticleZoneType type, F func) const
+{
+  for (const auto& zone : m_zones) {
+    if (zone.name_id == name_id && zone.type == type) {
+      func(zone);
+    }
+  }
+}
+
+#endif
+
+/* EOF */
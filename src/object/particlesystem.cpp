@@ -16,6 +16,8 @@
 
 #include "object/particlesystem.hpp"
 
+#include <algorithm>
+#include <assert.h>
 #include <math.h>
 
 #include "supertux/globals.hpp"
@@ -30,12 +32,25 @@
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
+ParticleSystem::ParticleColumns::ParticleColumns() :
+  x(),
+  y(),
+  speed_x(),
+  speed_y(),
+  angle(),
+  alpha(),
+  scale(),
+  texture()
+{
+}
+
 ParticleSystem::ParticleSystem(const ReaderMapping& reader, float max_particle_size_) :
   GameObject(reader),
   ExposedObject<ParticleSystem, scripting::ParticleSystem>(this),
   max_particle_size(max_particle_size_),
   z_pos(LAYER_BACKGROUND1),
   particles(),
+  textures(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
   enabled(true)
@@ -50,6 +65,7 @@ ParticleSystem::ParticleSystem(float max_particle_size_) :
   max_particle_size(max_particle_size_),
   z_pos(LAYER_BACKGROUND1),
   particles(),
+  textures(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
   enabled(true)
@@ -84,51 +100,153 @@ ParticleSystem::draw(DrawingContext& context)
   float scrollx = context.get_translation().x;
   float scrolly = context.get_translation().y;
   const auto& region = Sector::current()->get_active_region();
+  const Vector& camera = Sector::get().get_camera().get_translation();
 
   context.push_transform();
   context.set_translation(Vector(max_particle_size,max_particle_size));
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles)
-  {
-    // remap x,y coordinates onto screencoordinates
-    Vector pos(0.0f, 0.0f);
+  std::vector<float> texture_widths;
+  for (const auto& texture : textures)
+    texture_widths.push_back(static_cast<float>(texture->get_width()));
 
+  // remap x,y coordinates onto screencoordinates
+  const size_t count = particles.size();
+  std::vector<float> screen_x(count);
+  std::vector<float> screen_y(count);
+  for (size_t i = 0; i < count; ++i)
+  {
     // horizontal wrap when particle goes off screen to the left
-    const int particle_width = particle->texture->get_width();
-    pos.x = fmodf(particle->pos.x - scrollx, virtual_width);
-    if ((pos.x + static_cast<float>(particle_width)) < 0) pos.x += virtual_width;
+    float x = fmodf(particles.x[i] - scrollx, virtual_width);
+    screen_x[i] = (x + texture_widths[particles.texture[i]] < 0) ? x + virtual_width : x;
 
-    pos.y = fmodf(particle->pos.y - scrolly, virtual_height);
-    if (pos.y < 0) pos.y += virtual_height;
+    float y = fmodf(particles.y[i] - scrolly, virtual_height);
+    screen_y[i] = (y < 0) ? y + virtual_height : y;
+  }
 
-    if(!region.contains(pos + Sector::get().get_camera().get_translation()))
+  auto batches = create_batches();
+  for (size_t i = 0; i < count; ++i)
+  {
+    const Vector pos(screen_x[i], screen_y[i]);
+    if(!region.contains(pos + camera))
       continue;
 
-    //if(pos.x > virtual_width) pos.x -= virtual_width;
-    //if(pos.y > virtual_height) pos.y -= virtual_height;
+    batches[particles.texture[i]].draw(pos, particles.angle[i]);
+  }
+
+  draw_batches(context, batches);
+
+  context.pop_transform();
+}
+
+size_t
+ParticleSystem::append_particle(const Vector& pos, const SurfacePtr& texture)
+{
+  const size_t index = particles.size();
+  resize_particles(index + 1);
+  particles.x[index] = pos.x;
+  particles.y[index] = pos.y;
+  particles.alpha[index] = 1.0f;
+  particles.scale[index] = 1.0f;
+  particles.texture[index] = add_texture(texture);
+  return index;
+}
+
+void
+ParticleSystem::resize_particles(size_t size)
+{
+  particles.x.resize(size);
+  particles.y.resize(size);
+  particles.speed_x.resize(size);
+  particles.speed_y.resize(size);
+  particles.angle.resize(size);
+  particles.alpha.resize(size);
+  particles.scale.resize(size);
+  particles.texture.resize(size);
+}
+
+void
+ParticleSystem::move_particle(size_t from, size_t to)
+{
+  particles.x[to] = particles.x[from];
+  particles.y[to] = particles.y[from];
+  particles.speed_x[to] = particles.speed_x[from];
+  particles.speed_y[to] = particles.speed_y[from];
+  particles.angle[to] = particles.angle[from];
+  particles.alpha[to] = particles.alpha[from];
+  particles.scale[to] = particles.scale[from];
+  particles.texture[to] = particles.texture[from];
+}
 
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture, SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(pos, particle->angle);
-    } else {
-      it->second.draw(pos, particle->angle);
-    }
+void
+ParticleSystem::move_particles(float factor)
+{
+  const size_t count = particles.size();
+  float* x = particles.x.data();
+  float* y = particles.y.data();
+  const float* speed_x = particles.speed_x.data();
+  const float* speed_y = particles.speed_y.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    x[i] += speed_x[i] * factor;
+    y[i] += speed_y[i] * factor;
+  }
+}
+
+Rectf
+ParticleSystem::get_particle_bounds() const
+{
+  assert(!particles.empty());
+
+  float left = particles.x[0];
+  float right = particles.x[0];
+  float top = particles.y[0];
+  float bottom = particles.y[0];
+  for (size_t i = 1; i < particles.size(); ++i)
+  {
+    left = std::min(left, particles.x[i]);
+    right = std::max(right, particles.x[i]);
+    top = std::min(top, particles.y[i]);
+    bottom = std::max(bottom, particles.y[i]);
   }
+  return Rectf(left, top, right, bottom);
+}
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface,
+int
+ParticleSystem::add_texture(const SurfacePtr& texture)
+{
+  auto it = std::find(textures.begin(), textures.end(), texture);
+  if (it != textures.end())
+    return static_cast<int>(it - textures.begin());
+
+  textures.push_back(texture);
+  return static_cast<int>(textures.size()) - 1;
+}
+
+std::vector<SurfaceBatch>
+ParticleSystem::create_batches() const
+{
+  std::vector<SurfaceBatch> batches;
+  batches.reserve(textures.size());
+  for (const auto& texture : textures) {
+    batches.emplace_back(texture);
+  }
+  return batches;
+}
+
+void
+ParticleSystem::draw_batches(DrawingContext& context, std::vector<SurfaceBatch>& batches) const
+{
+  for (auto& batch : batches) {
+    if (batch.empty())
+      continue;
+
+    context.color().draw_surface_batch(batch.get_surface(),
                                        batch.move_srcrects(),
                                        batch.move_dstrects(),
                                        batch.move_angles(),
                                        batch.get_color(),
                                        z_pos);
   }
-
-  context.pop_transform();
 }
 
 void
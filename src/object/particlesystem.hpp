@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "math/rectf.hpp"
 #include "math/vector.hpp"
 #include "squirrel/exposed_object.hpp"
 #include "scripting/particlesystem.hpp"
@@ -26,6 +27,7 @@
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
+class SurfaceBatch;
 
 /**
   This is the base class for particle systems. It is responsible for
@@ -63,36 +65,88 @@ public:
   int get_layer() const { return z_pos; }
 
 protected:
-  class Particle
+  /** The particles of a system as a structure of arrays, all columns
+      have one entry per particle. Subclasses keep their additional
+      columns in sync by overriding resize_particles() and
+      move_particle(). */
+  class ParticleColumns final
   {
   public:
-    Particle() :
-      pos(0.0f, 0.0f),
-      angle(),
-      texture(),
-      alpha(),
-      scale(1.f) // This currently only works in the custom particle system
-    {}
-
-    virtual ~Particle()
-    {}
-
-    Vector pos;
+    ParticleColumns();
+
+    size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+
+    std::vector<float> x;
+    std::vector<float> y;
+    // distance per second, see move_particles()
+    std::vector<float> speed_x;
+    std::vector<float> speed_y;
     // angle at which to draw particle
-    float angle;
-    SurfacePtr texture;
-    float alpha;
-    float scale; // see initializer
+    std::vector<float> angle;
+    std::vector<float> alpha;
+    std::vector<float> scale; // This currently only works in the custom particle system
+    // index into ParticleSystem::textures
+    std::vector<int> texture;
 
   private:
-    Particle(const Particle&) = delete;
-    Particle& operator=(const Particle&) = delete;
+    ParticleColumns(const ParticleColumns&) = delete;
+    ParticleColumns& operator=(const ParticleColumns&) = delete;
   };
 
+protected:
+  /** Appends a particle at `pos` drawn with `texture`, returns its
+      index. Its speed and angle are zero, its alpha and scale one. */
+  size_t append_particle(const Vector& pos, const SurfacePtr& texture);
+
+  /** Sets the number of particles, new ones are zero in all columns */
+  virtual void resize_particles(size_t size);
+
+  /** Overwrites particle `to` with particle `from` */
+  virtual void move_particle(size_t from, size_t to);
+
+  /** Removes every particle `i` for which `dead(i)` is true, keeping
+      the order of the others */
+  template<typename F>
+  void remove_particles_if(F dead)
+  {
+    size_t count = 0;
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+      if (dead(i))
+        continue;
+      if (count != i)
+        move_particle(i, count);
+      count += 1;
+    }
+    resize_particles(count);
+  }
+
+  /** Moves every particle by its speed times `factor` */
+  void move_particles(float factor);
+
+  /** Smallest rectangle containing the positions of all particles,
+      there have to be some */
+  Rectf get_particle_bounds() const;
+
+  /** Registers `texture` for use by particles, returns its index in
+      `textures`. */
+  int add_texture(const SurfacePtr& texture);
+
+  /** Creates one empty batch per entry of `textures` */
+  std::vector<SurfaceBatch> create_batches() const;
+
+  /** Submits all non-empty batches */
+  void draw_batches(DrawingContext& context, std::vector<SurfaceBatch>& batches) const;
+
 protected:
   float max_particle_size;
   int z_pos;
-  std::vector<std::unique_ptr<Particle> > particles;
+  ParticleColumns particles;
+
+  /** Textures used by the particles, shared so that drawing can batch
+      by index instead of hashing a SurfacePtr per particle */
+  std::vector<SurfacePtr> textures;
   float virtual_width;
   float virtual_height;
   bool enabled;
@@ -16,9 +16,12 @@
 
 #include "object/particlesystem_interactive.hpp"
 
+#include <math.h>
+
 #include "collision/collision.hpp"
 #include "editor/editor.hpp"
 #include "math/aatriangle.hpp"
+#include "object/camera.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/sector.hpp"
@@ -31,8 +34,36 @@
 //TODO: Find a way to make rain collide with objects like bonus blocks
 //      Add an option to set rain strength
 //      Fix rain being "respawned" over solid tiles
+namespace {
+
+/** Particles may move and extend this far beyond the area passed to
+    update_tile_mask() */
+const float TILE_MASK_MARGIN = 96.0f;
+
+/** First x with x * 32 >= max_x */
+int end_tile(int max_x)
+{
+  int end = max_x / 32;
+  if (end * 32 < max_x)
+    end += 1;
+  return end;
+}
+
+Rect to_tiles(const Rectf& area)
+{
+  return Rect(static_cast<int>(floorf(area.get_left() / 32.0f)),
+              static_cast<int>(floorf(area.get_top() / 32.0f)),
+              static_cast<int>(ceilf(area.get_right() / 32.0f)),
+              static_cast<int>(ceilf(area.get_bottom() / 32.0f)));
+}
+
+} // namespace
+
+bool ParticleSystem_Interactive::s_use_tile_mask = true;
+
 ParticleSystem_Interactive::ParticleSystem_Interactive() :
-  ParticleSystem()
+  ParticleSystem(),
+  tile_mask()
 {
   virtual_width = static_cast<float>(SCREEN_WIDTH);
   virtual_height = static_cast<float>(SCREEN_HEIGHT);
@@ -42,7 +73,8 @@ ParticleSystem_Interactive::ParticleSystem_Interactive() :
 }
 
 ParticleSystem_Interactive::ParticleSystem_Interactive(const ReaderMapping& mapping) :
-  ParticleSystem(mapping)
+  ParticleSystem(mapping),
+  tile_mask()
 {
   virtual_width = static_cast<float>(SCREEN_WIDTH);
   virtual_height = static_cast<float>(SCREEN_HEIGHT);
@@ -63,34 +95,74 @@ ParticleSystem_Interactive::draw(DrawingContext& context)
 
   context.push_transform();
   const auto& region = Sector::current()->get_active_region();
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
-    if(!region.contains(particle->pos))
+  auto batches = create_batches();
+  for (size_t i = 0; i < particles.size(); ++i) {
+    const Vector pos(particles.x[i], particles.y[i]);
+    if(!region.contains(pos))
       continue;
 
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture,
-        SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(particle->pos, particle->angle);
-    } else {
-      it->second.draw(particle->pos, particle->angle);
-    }
+    batches[particles.texture[i]].draw(pos, particles.angle[i]);
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    // FIXME: What is the colour used for?
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), Color::WHITE, z_pos);
-  }
+  draw_batches(context, batches);
 
   context.pop_transform();
 }
 
+void
+ParticleSystem_Interactive::update_tile_mask(const Rectf& area)
+{
+  if (!s_use_tile_mask) {
+    tile_mask.reset(Rect());
+    return;
+  }
+
+  Rect tiles = to_tiles(area.grown(TILE_MASK_MARGIN));
+  if (static_cast<int64_t>(tiles.get_width()) * tiles.get_height() > MAX_MASK_TILES)
+  {
+    const Rectf view(Sector::get().get_camera().get_translation(),
+                     Sizef(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)));
+    const Rect view_tiles = to_tiles(view.grown(TILE_MASK_MARGIN));
+    tiles = Rect(std::max(tiles.left, view_tiles.left),
+                 std::max(tiles.top, view_tiles.top),
+                 std::min(tiles.right, view_tiles.right),
+                 std::min(tiles.bottom, view_tiles.bottom));
+  }
+
+  tile_mask.reset(tiles);
+  const Rect& rect = tile_mask.get_rect();
+  if (static_cast<int64_t>(rect.get_width()) * rect.get_height() > MAX_MASK_TILES) {
+    // Huge screen, don't use the mask at all
+    tile_mask.reset(Rect());
+    return;
+  }
+
+  // Indexed like collision() does it, so the mask answers exactly for
+  // the tiles collision() would look at
+  for (const auto& solids : Sector::get().get_solid_tilemaps()) {
+    for (int y = rect.top; y < rect.bottom; ++y) {
+      for (int x = rect.left; x < rect.right; ++x) {
+        if (solids->get_tile(x, y).get_attributes() & (Tile::WATER | Tile::SOLID))
+          tile_mask.set(x, y);
+      }
+    }
+  }
+}
+
+bool
+ParticleSystem_Interactive::may_hit_tiles(int starttilex, int starttiley, int max_x, int max_y) const
+{
+  const int endtilex = std::max(starttilex, end_tile(max_x));
+  const int endtiley = std::max(starttiley, end_tile(max_y));
+
+  if (!tile_mask.covers(starttilex, starttiley, endtilex, endtiley))
+    return true;
+
+  return tile_mask.any(starttilex, starttiley, endtilex, endtiley);
+}
+
 int
-ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
+ParticleSystem_Interactive::collision(size_t particle, const Vector& movement)
 {
   using namespace collision;
 
@@ -98,18 +170,18 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x;
+  x1 = particles.x[particle];
   x2 = x1 + 32 + movement.x;
   if (x2 < x1) {
     x1 = x2;
-    x2 = object->pos.x;
+    x2 = particles.x[particle];
   }
 
-  y1 = object->pos.y;
+  y1 = particles.y[particle];
   y2 = y1 + 32 + movement.y;
   if (y2 < y1) {
     y1 = y2;
-    y2 = object->pos.y;
+    y2 = particles.y[particle];
   }
   bool water = false;
 
@@ -119,6 +191,9 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   int max_x = int(x2+1);
   int max_y = int(y2+1);
 
+  if (!may_hit_tiles(starttilex, starttiley, max_x, max_y))
+    return -1;
+
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
@@ -19,6 +19,7 @@
 
 #include "object/particlesystem.hpp"
 
+#include "collision/tile_collision_mask.hpp"
 #include "math/fwd.hpp"
 
 /**
@@ -48,8 +49,33 @@ public:
     return _("Interactive particle system");
   }
 
+public:
+  /** Whether update_tile_mask() builds the mask, benchmarks turn it
+      off to compare against testing the tiles directly */
+  static bool s_use_tile_mask;
+
+protected:
+  /** Tests `particle` moving by `movement` against the solid tiles:
+      -1 without collision, 0 for water, 1 from above, 2 from the side */
+  virtual int collision(size_t particle, const Vector& movement);
+
+  /** Rebuilds `tile_mask` from the solid tilemaps of the current
+      sector. `area` should contain all particles, collision tests
+      outside of it fall back to looking at the tiles. Call once per
+      frame before the collision tests. */
+  void update_tile_mask(const Rectf& area);
+
+  /** Whether the tiles walked by the collision tests, tile x from
+      `starttilex` while x * 32 < `max_x` and likewise for y, may
+      contain something solid */
+  bool may_hit_tiles(int starttilex, int starttiley, int max_x, int max_y) const;
+
 protected:
-  virtual int collision(Particle* particle, const Vector& movement);
+  TileCollisionMask tile_mask;
+
+private:
+  /** Larger tile masks are limited to the camera view */
+  static const int MAX_MASK_TILES = 128 * 128;
 
 private:
   ParticleSystem_Interactive(const ParticleSystem_Interactive&) = delete;
@@ -66,13 +66,78 @@ const unsigned int IDLE_STAGE_COUNT = 5;
  * animation
  */
 const int IDLE_TIME[] = { 5000, 0, 2500, 0, 2500 };
+/** Actions of Tux's sprite, named "<bonus>-<action>-<left|right>" */
+enum TuxAction
+{
+  TUX_STAND,
+  TUX_IDLE,
+  TUX_WALK,
+  TUX_RUN,
+  TUX_JUMP,
+  TUX_FALL,
+  TUX_SKID,
+  TUX_KICK,
+  TUX_DUCK,
+  TUX_BACKFLIP,
+  TUX_BUTTJUMP,
+  TUX_WALLJUMP,
+  TUX_CLIMBING,
+  TUX_FLOATING,
+  TUX_SWIMJUMP,
+  TUX_SWIMMING,
+  TUX_ACTION_COUNT
+};
+
+const char* const TUX_ACTION_NAMES[] =
+{ "stand", "idle", "walk", "run", "jump", "fall", "skid", "kick", "duck",
+  "backflip", "buttjump", "walljump", "climbing", "floating", "swimjump", "swimming" };
+
+/** Action name prefixes of Tux's bonus states */
+enum TuxBonus
+{
+  TUX_SMALL,
+  TUX_BIG,
+  TUX_FIRE,
+  TUX_SANTA,
+  TUX_ICE,
+  TUX_AIR,
+  TUX_EARTH,
+  TUX_BONUS_COUNT
+};
+
+const char* const TUX_BONUS_NAMES[] =
+{ "small", "big", "fire", "santa", "ice", "air", "earth" };
+
+/** Returns the id of "<bonus>-<action>-<left|right>". The ids are
+    interned once instead of building the names every frame. */
+const ActionId& get_tux_action(TuxBonus bonus, TuxAction action, bool right)
+{
+  struct Table
+  {
+    Table() :
+      ids()
+    {
+      for (int b = 0; b < TUX_BONUS_COUNT; ++b)
+        for (int a = 0; a < TUX_ACTION_COUNT; ++a)
+          for (int r = 0; r < 2; ++r)
+            ids[b][a][r] = ActionId(std::string(TUX_BONUS_NAMES[b]) + "-" + TUX_ACTION_NAMES[a] +
+                                    (r ? "-right" : "-left"));
+    }
+
+    ActionId ids[TUX_BONUS_COUNT][TUX_ACTION_COUNT][2];
+  };
+
+  static const Table table;
+  return table.ids[bonus][action][right ? 1 : 0];
+}
+
 /** idle stages */
-const std::string IDLE_STAGES[] =
-{ "stand",
-  "idle",
-  "stand",
-  "idle",
-  "stand" };
+const TuxAction IDLE_STAGES[] =
+{ TUX_STAND,
+  TUX_IDLE,
+  TUX_STAND,
+  TUX_IDLE,
+  TUX_STAND };
 
 /** acceleration in horizontal direction when walking
  * (all accelerations are in  pixel/s^2) */
@@ -1575,33 +1640,32 @@ Player::draw(DrawingContext& context)
     context.color().draw_surface(m_airarrow, Vector(px, py), LAYER_HUD - 1);
   }
 
-  std::string sa_prefix = "";
-  std::string sa_postfix = "";
+  TuxBonus bonus;
+  bool right;
 
   if (m_player_status.bonus == GROWUP_BONUS)
-    sa_prefix = "big";
+    bonus = TUX_BIG;
   else if (m_player_status.bonus == FIRE_BONUS)
     if (g_config->christmas_mode)
-      sa_prefix = "santa";
+      bonus = TUX_SANTA;
     else
-      sa_prefix = "fire";
+      bonus = TUX_FIRE;
   else if (m_player_status.bonus == ICE_BONUS)
-    sa_prefix = "ice";
+    bonus = TUX_ICE;
   else if (m_player_status.bonus == AIR_BONUS)
-    sa_prefix = "air";
+    bonus = TUX_AIR;
   else if (m_player_status.bonus == EARTH_BONUS)
-    sa_prefix = "earth";
+    bonus = TUX_EARTH;
   else
-    sa_prefix = "small";
+    bonus = TUX_SMALL;
   if (!m_swimming && !m_water_jump)
   {
-    sa_postfix = (m_dir == Direction::RIGHT) ? "-right" : "-left";
+    right = (m_dir == Direction::RIGHT);
   }
   else
   {
-    sa_postfix = ((std::abs(m_swimming_angle) <= math::PI_2)
-      || (m_water_jump && std::abs(m_physic.get_velocity_x()) < 10.f))
-      ? "-right" : "-left";
+    right = ((std::abs(m_swimming_angle) <= math::PI_2)
+      || (m_water_jump && std::abs(m_physic.get_velocity_x()) < 10.f));
   }
 
   /* Set Tux sprite action */
@@ -1611,7 +1675,8 @@ Player::draw(DrawingContext& context)
   else if (m_growing)
   {
     m_sprite->set_action_continued(m_swimming || m_water_jump ?
-      "swimgrow"+sa_postfix : "grow"+sa_postfix);
+      std::string("swimgrow") + (right ? "-right" : "-left") :
+      std::string("grow") + (right ? "-right" : "-left"));
     // while growing, do not change action
     // do_duck() will take care of cancelling growing manually
     // update() will take care of cancelling when growing completed
@@ -1620,30 +1685,30 @@ Player::draw(DrawingContext& context)
     m_sprite->set_action(m_sprite->get_action()+"-stone");
   }
   else if (m_climbing) {
-    m_sprite->set_action(sa_prefix+"-climbing"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_CLIMBING, right));
 
     // Avoid flickering briefly after growing on ladder
     if ((m_physic.get_velocity_x()==0)&&(m_physic.get_velocity_y()==0))
       m_sprite->stop_animation();
   }
   else if (m_backflipping) {
-    m_sprite->set_action(sa_prefix+"-backflip"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_BACKFLIP, right));
   }
   else if (m_duck && is_big() && !m_swimming) {
-    m_sprite->set_action(sa_prefix+"-duck"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_DUCK, right));
   }
   else if (m_skidding_timer.started() && !m_skidding_timer.check() && !m_swimming) {
-    m_sprite->set_action(sa_prefix+"-skid"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_SKID, right));
   }
   else if (m_kick_timer.started() && !m_kick_timer.check() && !m_swimming && !m_water_jump) {
-    m_sprite->set_action(sa_prefix+"-kick"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_KICK, right));
   }
   else if ((m_wants_buttjump || m_does_buttjump) && is_big() && !m_water_jump) {
-    m_sprite->set_action(sa_prefix+"-buttjump"+sa_postfix, 1);
+    m_sprite->set_action(get_tux_action(bonus, TUX_BUTTJUMP, right), 1);
   }
   else if ((m_controller->hold(Control::LEFT) || m_controller->hold(Control::RIGHT)) && m_can_walljump)
   {
-    m_sprite->set_action(sa_prefix+"-walljump"+(m_on_left_wall ? "-left" : "-right"), 1);
+    m_sprite->set_action(get_tux_action(bonus, TUX_WALLJUMP, !m_on_left_wall), 1);
   }
   else if (!on_ground() || m_fall_mode != ON_GROUND)
   {
@@ -1654,18 +1719,18 @@ Player::draw(DrawingContext& context)
         if (m_water_jump && m_dir != m_old_dir)
           log_debug << "Obracanko (:" << std::endl;
         if (glm::length(m_physic.get_velocity()) < 50.f)
-          m_sprite->set_action(sa_prefix + "-floating" + sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, TUX_FLOATING, right));
         else if (m_water_jump)
-          m_sprite->set_action(sa_prefix + "-swimjump" + sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, TUX_SWIMJUMP, right));
         else
-          m_sprite->set_action(sa_prefix + "-swimming" + sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, TUX_SWIMMING, right));
       }
       else
       {
         if (m_physic.get_velocity_y() > 0)
-          m_sprite->set_action(sa_prefix + "-fall" + sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, TUX_FALL, right));
         else if (m_physic.get_velocity_y() <= 0)
-          m_sprite->set_action(sa_prefix + "-jump" + sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, TUX_JUMP, right));
       }
     }
   }
@@ -1677,7 +1742,7 @@ Player::draw(DrawingContext& context)
         m_idle_stage = 0;
         m_idle_timer.start(static_cast<float>(IDLE_TIME[m_idle_stage]) / 1000.0f);
 
-        m_sprite->set_action_continued(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+        m_sprite->set_action_continued(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], right));
       }
       else if (m_idle_timer.check() || (IDLE_TIME[m_idle_stage] == 0 && m_sprite->animation_done())) {
         m_idle_stage++;
@@ -1687,19 +1752,19 @@ Player::draw(DrawingContext& context)
         m_idle_timer.start(static_cast<float>(IDLE_TIME[m_idle_stage]) / 1000.0f);
 
         if (IDLE_TIME[m_idle_stage] == 0)
-          m_sprite->set_action(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix, 1);
+          m_sprite->set_action(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], right), 1);
         else
-          m_sprite->set_action(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], right));
       }
       else {
-        m_sprite->set_action_continued(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+        m_sprite->set_action_continued(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], right));
       }
     }
     else {
       if (fabsf(m_physic.get_velocity_x()) > MAX_WALK_XM && !is_big()) {
-        m_sprite->set_action(sa_prefix+"-run"+sa_postfix);
+        m_sprite->set_action(get_tux_action(bonus, TUX_RUN, right));
       } else {
-        m_sprite->set_action(sa_prefix+"-walk"+sa_postfix);
+        m_sprite->set_action(get_tux_action(bonus, TUX_WALK, right));
       }
     }
   }
@@ -1707,7 +1772,7 @@ Player::draw(DrawingContext& context)
   /* Set Tux powerup sprite action */
   if (m_player_status.has_hat_sprite())
   {
-    m_powersprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_action_id());
     if (m_powersprite->get_frames() == m_sprite->get_frames())
     {
       m_powersprite->set_frame(m_sprite->get_current_frame());
@@ -1715,7 +1780,7 @@ Player::draw(DrawingContext& context)
     }
     if (m_player_status.bonus == EARTH_BONUS)
     {
-      m_lightsprite->set_action(m_sprite->get_action());
+      m_lightsprite->set_action(m_sprite->get_action_id());
       if (m_lightsprite->get_frames() == m_sprite->get_frames())
       {
         m_lightsprite->set_frame(m_sprite->get_current_frame());
@@ -16,6 +16,7 @@
 
 #include "object/rain_particle_system.hpp"
 
+#include <algorithm>
 #include <assert.h>
 #include <math.h>
 
@@ -33,6 +34,7 @@
 
 RainParticleSystem::RainParticleSystem() :
   ExposedObject<RainParticleSystem, scripting::Rain>(this),
+  m_speed(),
   m_current_speed(1.f),
   m_target_speed(1.f),
   m_speed_fade_time_remaining(0.f),
@@ -55,6 +57,7 @@ RainParticleSystem::RainParticleSystem() :
 RainParticleSystem::RainParticleSystem(const ReaderMapping& reader) :
   ParticleSystem_Interactive(reader),
   ExposedObject<RainParticleSystem, scripting::Rain>(this),
+  m_speed(),
   m_current_speed(1.f),
   m_target_speed(1.f),
   m_speed_fade_time_remaining(0.f),
@@ -118,20 +121,18 @@ void RainParticleSystem::set_amount(float amount)
   
   if (delta > 0) {
     for (int i=0; i<delta; ++i) {
-      auto particle = std::make_unique<RainParticle>();
-      particle->pos.x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
-      particle->pos.y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
+      Vector pos(0.0f, 0.0f);
+      pos.x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
+      pos.y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
       int rainsize = graphicsRandom.rand(2);
-      particle->texture = rainimages[rainsize];
+      const size_t particle = append_particle(pos, rainimages[rainsize]);
       do {
-        particle->speed = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
-      } while(particle->speed < 1);
-      particles.push_back(std::move(particle));
+        m_speed[particle] = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
+      } while(m_speed[particle] < 1);
+      update_direction(particle);
     }
   } else if (delta < 0) {
-    for (int i=0; i>delta; --i) {
-      particles.pop_back();
-    }
+    resize_particles(particles.size() - std::min(particles.size(), static_cast<size_t>(-delta)));
   }
 
   m_current_real_amount = real_amount;
@@ -139,8 +140,29 @@ void RainParticleSystem::set_amount(float amount)
 
 void RainParticleSystem::set_angle(float angle)
 {
-  for (auto& particle : particles)
-    particle->angle = angle;
+  for (size_t i = 0; i < particles.size(); ++i) {
+    particles.angle[i] = angle;
+    update_direction(i);
+  }
+}
+
+void RainParticleSystem::update_direction(size_t particle)
+{
+  const float angle = (particles.angle[particle] + 45.f) * 3.14159265f / 180.f;
+  particles.speed_x[particle] = -m_speed[particle] * sinf(angle);
+  particles.speed_y[particle] = m_speed[particle] * cosf(angle);
+}
+
+void RainParticleSystem::resize_particles(size_t size)
+{
+  ParticleSystem::resize_particles(size);
+  m_speed.resize(size);
+}
+
+void RainParticleSystem::move_particle(size_t from, size_t to)
+{
+  ParticleSystem::move_particle(from, to);
+  m_speed[to] = m_speed[from];
 }
 
 void RainParticleSystem::update(float dt_sec)
@@ -201,38 +223,38 @@ void RainParticleSystem::update(float dt_sec)
   float abs_x = cam_translation.x;
   float abs_y = cam_translation.y;
 
-  for (auto& it : particles) {
-    auto particle = dynamic_cast<RainParticle*>(it.get());
-    assert(particle);
+  if (!particles.empty())
+    update_tile_mask(get_particle_bounds());
+
+  move_particles(movement_multiplier);
 
-    float movement = particle->speed * movement_multiplier;
-    particle->pos.y += movement * cosf((particle->angle + 45.f) * 3.14159265f / 180.f);
-    particle->pos.x -= movement * sinf((particle->angle + 45.f) * 3.14159265f / 180.f);
-    int col = collision(particle, Vector(-movement, movement));
-    if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
+  for (size_t i = 0; i < particles.size(); ++i) {
+    float movement = m_speed[i] * movement_multiplier;
+    int col = collision(i, Vector(-movement, movement));
+    if ((particles.y[i] > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
       //Create rainsplash
-      if ((particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
+      if ((particles.y[i] <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
         bool vertical = (col == 2);
         if (!vertical) { //check if collision happened from above
           int splash_x, splash_y; // move outside if statement when
                                   // uncommenting the else statement below.
-          splash_x = int(particle->pos.x);
-          splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
+          splash_x = int(particles.x[i]);
+          splash_y = int(particles.y[i]) - (int(particles.y[i]) % 32) + 32;
           Sector::get().add<RainSplash>(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)),
                                              vertical);
         }
         // Uncomment the following to display vertical splashes, too
         /* else {
-           splash_x = int(particle->pos.x) - (int(particle->pos.x) % 32) + 32;
-           splash_y = int(particle->pos.y);
+           splash_x = int(particles.x[i]) - (int(particles.x[i]) % 32) + 32;
+           splash_y = int(particles.y[i]);
            Sector::get().add<RainSplash>(Vector(splash_x, splash_y),vertical);
            } */
       }
       int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
       int new_y = 0;
       //FIXME: Don't move particles over solid tiles
-      particle->pos.x = static_cast<float>(new_x);
-      particle->pos.y = static_cast<float>(new_y);
+      particles.x[i] = static_cast<float>(new_x);
+      particles.y[i] = static_cast<float>(new_y);
     }
   }
 }
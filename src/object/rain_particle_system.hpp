@@ -66,20 +66,19 @@ public:
     ExposedObject<RainParticleSystem, scripting::Rain>::unexpose(vm, table_idx);
   }
 
+protected:
+  virtual void resize_particles(size_t size) override;
+  virtual void move_particle(size_t from, size_t to) override;
+
 private:
   void set_amount(float amount);
   void set_angle(float angle);
 
+  /** Points the speed columns of `particle` along its angle */
+  void update_direction(size_t particle);
+
 private:
-  class RainParticle : public Particle
-  {
-  public:
-    float speed;
-
-    RainParticle() :
-      speed()
-    {}
-  };
+  std::vector<float> m_speed;
 
   SurfacePtr rainimages[2];
 
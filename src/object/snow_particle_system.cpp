@@ -37,6 +37,10 @@ static const float WOBBLE_FACTOR = 4 * .005f; //wobble approaches drift_speed by
 }
 
 SnowParticleSystem::SnowParticleSystem() :
+  m_anchor_x(),
+  m_drift_speed(),
+  m_spin_speed(),
+  m_flake_size(),
   state(RELEASING),
   timer(),
   gust_onset(0),
@@ -47,6 +51,10 @@ SnowParticleSystem::SnowParticleSystem() :
 
 SnowParticleSystem::SnowParticleSystem(const ReaderMapping& reader) :
   ParticleSystem(reader),
+  m_anchor_x(),
+  m_drift_speed(),
+  m_spin_speed(),
+  m_flake_size(),
   state(RELEASING),
   timer(),
   gust_onset(0),
@@ -72,29 +80,48 @@ void SnowParticleSystem::init()
   // create some random snowflakes
   int snowflakecount = static_cast<int>(virtual_width / 10.0f);
   for (int i = 0; i < snowflakecount; ++i) {
-    auto particle = std::make_unique<SnowParticle>();
     int snowsize = graphicsRandom.rand(3);
 
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
-    particle->anchorx = particle->pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16);
+    Vector pos(0.0f, 0.0f);
+    pos.x = graphicsRandom.randf(virtual_width);
+    pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    const size_t particle = append_particle(pos, snowimages[snowsize]);
+    m_anchor_x[particle] = pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16);
     // drift will change with wind gusts
-    particle->drift_speed = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
-    particle->wobble = 0.0;
+    m_drift_speed[particle] = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
+    // wobble
+    particles.speed_x[particle] = 0.0;
 
-    particle->texture = snowimages[snowsize];
-    particle->flake_size = static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)); // since it ranges from 0 to 2
+    m_flake_size[particle] = static_cast<float>(static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f))); // since it ranges from 0 to 2
 
-    particle->speed = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
+    particles.speed_y[particle] = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
 
     // Spinning
-    particle->angle = graphicsRandom.randf(360.0);
-    particle->spin_speed = graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED);
-
-    particles.push_back(std::move(particle));
+    particles.angle[particle] = graphicsRandom.randf(360.0);
+    m_spin_speed[particle] = graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED);
   }
 }
 
+void
+SnowParticleSystem::resize_particles(size_t size)
+{
+  ParticleSystem::resize_particles(size);
+  m_anchor_x.resize(size);
+  m_drift_speed.resize(size);
+  m_spin_speed.resize(size);
+  m_flake_size.resize(size);
+}
+
+void
+SnowParticleSystem::move_particle(size_t from, size_t to)
+{
+  ParticleSystem::move_particle(from, to);
+  m_anchor_x[to] = m_anchor_x[from];
+  m_drift_speed[to] = m_drift_speed[from];
+  m_spin_speed[to] = m_spin_speed[from];
+  m_flake_size[to] = m_flake_size[from];
+}
+
 void SnowParticleSystem::update(float dt_sec)
 {
   if (!enabled)
@@ -137,26 +164,22 @@ void SnowParticleSystem::update(float dt_sec)
 
   float sq_g = sqrtf(Sector::get().get_gravity());
 
-  for (auto& part : particles) {
-    auto particle = dynamic_cast<SnowParticle*>(part.get());
-    if (!particle)
-      continue;
-
-    float anchor_delta;
+  // Falling and wobbling
+  move_particles(dt_sec * sq_g);
 
-    // Falling
-    particle->pos.y += particle->speed * dt_sec * sq_g;
+  for (size_t i = 0; i < particles.size(); ++i) {
     // Drifting (speed approaches wind at a rate dependent on flake size)
-    particle->drift_speed += (gust_current_velocity - particle->drift_speed) / static_cast<float>(particle->flake_size) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->anchorx += particle->drift_speed * dt_sec;
+    m_drift_speed[i] += (gust_current_velocity - m_drift_speed[i]) / m_flake_size[i] + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    m_anchor_x[i] += m_drift_speed[i] * dt_sec;
     // Wobbling (particle approaches anchorx)
-    particle->pos.x += particle->wobble * dt_sec * sq_g;
-    anchor_delta = (particle->anchorx - particle->pos.x);
-    particle->wobble += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->wobble *= SNOW::WOBBLE_DECAY;
-    // Spinning
-    particle->angle += particle->spin_speed * dt_sec;
-    particle->angle = fmodf(particle->angle, 360.0);
+    float anchor_delta = (m_anchor_x[i] - particles.x[i]);
+    particles.speed_x[i] += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    particles.speed_x[i] *= SNOW::WOBBLE_DECAY;
+  }
+
+  // Spinning
+  for (size_t i = 0; i < particles.size(); ++i) {
+    particles.angle[i] = fmodf(particles.angle[i] + m_spin_speed[i] * dt_sec, 360.0);
   }
 }
 
@@ -40,30 +40,21 @@ public:
 
   void init();
 
+protected:
+  virtual void resize_particles(size_t size) override;
+  virtual void move_particle(size_t from, size_t to) override;
+
 private:
-  class SnowParticle : public Particle
-  {
-  public:
-    float speed;
-    float wobble;
-    float anchorx;
-    float drift_speed;
-
-    // Turning speed
-    float spin_speed;
-
-    // for inertia
-    unsigned int flake_size;
-
-    SnowParticle() :
-      speed(),
-      wobble(),
-      anchorx(),
-      drift_speed(),
-      spin_speed(),
-      flake_size()
-    {}
-  };
+  // The speed columns hold the falling speed and the wobble
+
+  std::vector<float> m_anchor_x;
+  std::vector<float> m_drift_speed;
+
+  // Turning speed
+  std::vector<float> m_spin_speed;
+
+  // for inertia
+  std::vector<float> m_flake_size;
 
   // Wind is simulated in discrete "gusts"
 
@@ -44,6 +44,8 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  /** The light and light cone reach far out of the bounding box */
+  virtual float get_draw_margin() const override { return 512.0f; }
 
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit_) override;
 
@@ -16,6 +16,7 @@
 
 #include "object/tilemap.hpp"
 
+#include <algorithm>
 #include <physfs.h>
 #include <tuple>
 
@@ -49,6 +50,15 @@ TileMap::TileMap(const TileSet *new_tileset) :
   m_tiles(),
   tiles_draw_rects(),
   draw_rects_update(true),
+  m_draw_rects_input(),
+  m_draw_rects_visited(),
+  m_draw_rects_owner(),
+  m_collect_changed_tiles(false),
+  m_changed_tiles(),
+  m_all_tiles_changed(false),
+  m_draw_chunks(),
+  m_draw_chunks_width(0),
+  m_draw_chunks_height(0),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -86,6 +96,15 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_tiles(),
   tiles_draw_rects(),
   draw_rects_update(true),
+  m_draw_rects_input(),
+  m_draw_rects_visited(),
+  m_draw_rects_owner(),
+  m_collect_changed_tiles(false),
+  m_changed_tiles(),
+  m_all_tiles_changed(false),
+  m_draw_chunks(),
+  m_draw_chunks_width(0),
+  m_draw_chunks_height(0),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -217,6 +236,8 @@ TileMap::finish_construction()
 
 TileMap::~TileMap()
 {
+  if (m_ground_movement_manager)
+    m_ground_movement_manager->untrack_bottom_collisions(*this);
 }
 
 void
@@ -450,54 +471,100 @@ TileMap::draw(DrawingContext& context)
   context.set_translation(Vector(trans_x * (normal_speed ? 1.0f : m_speed_x),
                                  trans_y * (normal_speed ? 1.0f : m_speed_y)));
 
-  Rectf draw_rect = context.get_cliprect();
-  draw_rect.set_left(0.0f);
-  draw_rect.set_top(0.0f);
-  Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
-
-  Rectf screen_edge_rect = context.get_cliprect();
-  Rect t_screen_edge_rect = get_tiles_overlapping(screen_edge_rect);
-  int screen_start_x = t_screen_edge_rect.left;
-  int screen_start_y = t_screen_edge_rect.top;
-
-  Vector pos(0.0f, 0.0f);
-  int tx, ty;
+  Canvas& canvas = context.get_canvas(m_draw_target);
 
   std::unordered_map<SurfacePtr,
                      std::tuple<std::vector<Rectf>,
                                 std::vector<Rectf>,
                                 std::vector<Size>>> batches;
 
-  for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
-
-      if (tiles_draw_rects[index * 2] == 0) continue;
-      if (tx + tiles_draw_rects[index * 2] < screen_start_x || ty + tiles_draw_rects[index * 2 + 1] < screen_start_y) continue;
-
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
+  auto add_to_batch = [this, &batches](const SurfacePtr& surface, const Vector& pos, int index) {
+    std::get<0>(batches[surface]).emplace_back(Vector(0.0f, 0.0f),
+                                               Sizef(static_cast<float>(surface->get_width()),
+                                                     static_cast<float>(surface->get_height())));
+    std::get<1>(batches[surface]).emplace_back(pos,
+                                               Sizef(static_cast<float>(surface->get_width()),
+                                                     static_cast<float>(surface->get_height())));
+    std::get<2>(batches[surface]).emplace_back(Size(tiles_draw_rects[index * 2], tiles_draw_rects[index * 2 + 1]));
+  };
+
+  if (draw_chunks_enabled())
+  {
+    if (m_draw_chunks_width != (m_width + DRAW_CHUNK_SIZE - 1) / DRAW_CHUNK_SIZE ||
+        m_draw_chunks_height != (m_height + DRAW_CHUNK_SIZE - 1) / DRAW_CHUNK_SIZE)
+    {
+      invalidate_draw_chunks();
+    }
 
-      if (g_debug.show_collision_rects) {
-        tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
+    // Rectangles only extend to the right and down, so every chunk up
+    // to the lower right corner of the screen may reach into it.
+    const Rect t_screen_rect = get_tiles_overlapping(context.get_cliprect());
+    if (t_screen_rect.left < t_screen_rect.right && t_screen_rect.top < t_screen_rect.bottom)
+    {
+      const int chunks_right = (t_screen_rect.right - 1) / DRAW_CHUNK_SIZE + 1;
+      const int chunks_bottom = (t_screen_rect.bottom - 1) / DRAW_CHUNK_SIZE + 1;
+
+      for (int cy = 0; cy < chunks_bottom; ++cy) {
+        for (int cx = 0; cx < chunks_right; ++cx) {
+          DrawChunk& chunk = m_draw_chunks[cy * m_draw_chunks_width + cx];
+          if (chunk.dirty) rebuild_draw_chunk(cx, cy);
+
+          if (chunk.right <= t_screen_rect.left || chunk.bottom <= t_screen_rect.top) continue;
+
+          for (const auto& batch : chunk.batches) {
+            canvas.draw_cached_batch(batch.first, *batch.second, m_offset, m_current_tint, m_z_pos);
+          }
+
+          for (const int index : chunk.animated_tiles) {
+            const SurfacePtr surface = m_tileset->get(m_tiles[index]).get_current_surface();
+            if (surface) {
+              add_to_batch(surface, get_tile_position(index % m_width, index / m_width), index);
+            }
+          }
+        }
       }
+    }
+  }
+  else
+  {
+    Rectf draw_rect = context.get_cliprect();
+    draw_rect.set_left(0.0f);
+    draw_rect.set_top(0.0f);
+    Rect t_draw_rect = get_tiles_overlapping(draw_rect);
+    Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
+
+    Rectf screen_edge_rect = context.get_cliprect();
+    Rect t_screen_edge_rect = get_tiles_overlapping(screen_edge_rect);
+    int screen_start_x = t_screen_edge_rect.left;
+    int screen_start_y = t_screen_edge_rect.top;
+
+    Vector pos(0.0f, 0.0f);
+    int tx, ty;
+
+    for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
+      for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
+        int index = ty*m_width + tx;
+        assert (index >= 0);
+        assert (index < (m_width * m_height));
+
+        if (tiles_draw_rects[index * 2] == 0) continue;
+        if (tx + tiles_draw_rects[index * 2] < screen_start_x || ty + tiles_draw_rects[index * 2 + 1] < screen_start_y) continue;
+
+        if (m_tiles[index] == 0) continue;
+        const Tile& tile = m_tileset->get(m_tiles[index]);
+
+        if (g_debug.show_collision_rects) {
+          tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
+        }
 
-      const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
-      if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
-                                                   Sizef(static_cast<float>(surface->get_width()),
-                                                         static_cast<float>(surface->get_height())));
-        std::get<2>(batches[surface]).emplace_back(Size(tiles_draw_rects[index * 2], tiles_draw_rects[index * 2 + 1]));
+        const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
+        if (surface) {
+          add_to_batch(surface, pos, index);
+        }
       }
     }
   }
 
-  Canvas& canvas = context.get_canvas(m_draw_target);
-
   for (auto& it : batches)
   {
     const SurfacePtr& surface = it.first;
@@ -558,6 +625,7 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   for (const auto& tile : m_tiles)
     m_tileset->get(tile);
 
+  set_all_tiles_changed();
   calculateDrawRects();
 }
 
@@ -608,6 +676,7 @@ TileMap::resize(int new_width, int new_height, int fill_id,
   if (!offset_finished_y)
     apply_offset_y(fill_id, yoffset);
 
+  set_all_tiles_changed();
   calculateDrawRects();
 }
 
@@ -632,12 +701,19 @@ void
 TileMap::hits_object_bottom(CollisionObject& object)
 {
   m_objects_hit_bottom.insert(&object);
+  if (m_ground_movement_manager)
+    m_ground_movement_manager->track_bottom_collisions(*this);
 }
 
-void
-TileMap::notify_object_removal(CollisionObject* other)
+bool
+TileMap::notify_object_removal(const std::vector<CollisionObject*>& removed)
 {
-  m_objects_hit_bottom.erase(other);
+  for (auto* other : removed) {
+    if (m_objects_hit_bottom.empty())
+      break;
+    m_objects_hit_bottom.erase(other);
+  }
+  return !m_objects_hit_bottom.empty();
 }
 
 void
@@ -699,9 +775,9 @@ TileMap::change(int x, int y, uint32_t newtile)
   assert(x >= 0 && x < m_width && y >= 0 && y < m_height);
   if (m_tiles[y*m_width + x] != newtile)
   {
-    uint32_t oldtile = m_tiles[y*m_width + x];
     m_tiles[y*m_width + x] = newtile;
-    calculateDrawRects(oldtile, newtile);
+    add_changed_tile(x, y);
+    calculateDrawRects(x, y);
   }
 }
 
@@ -724,7 +800,8 @@ TileMap::change_all(uint32_t oldtile, uint32_t newtile)
     }
   }
 
-  calculateDrawRects(oldtile, newtile);
+  set_all_tiles_changed();
+  calculateDrawRects();
 }
 
 void
@@ -734,19 +811,19 @@ TileMap::autotile(int x, int y, uint32_t tile)
     return;
 
   uint32_t current_tile = m_tiles[y*m_width + x];
+  AutotileSet* tile_set = m_tileset->get_autotileset_from_tile(tile);
   AutotileSet* curr_set;
   if (current_tile == 0)
   {
     // Special case 1 : If the tile is empty, check if we can use a non-solid
     // tile from the currently selected tile's autotile set (if any).
-    curr_set = m_tileset->get_autotileset_from_tile(tile);
+    curr_set = tile_set;
   }
-  else if (m_tileset->get_autotileset_from_tile(tile) != nullptr &&
-      m_tileset->get_autotileset_from_tile(tile)->is_member(current_tile))
+  else if (tile_set != nullptr && tile_set->is_member(current_tile))
   {
     // Special case 2 : If the tile is in multiple autotilesets, check if it
     // is in the same tileset as the selected tile. (Example : tile 47)
-    curr_set = m_tileset->get_autotileset_from_tile(tile);
+    curr_set = tile_set;
   }
   else
   {
@@ -772,7 +849,12 @@ TileMap::autotile(int x, int y, uint32_t tile)
     curr_set->is_solid(get_tile_id(x+1, y+1)),
     x, y);
 
-  m_tiles[y*m_width + x] = realtile;
+  if (m_tiles[y*m_width + x] != realtile)
+  {
+    m_tiles[y*m_width + x] = realtile;
+    add_changed_tile(x, y);
+    calculateDrawRects(x, y);
+  }
 }
 
 void
@@ -781,21 +863,17 @@ TileMap::autotile_corner(int x, int y, uint32_t tile, AutotileCornerOperation op
   if (x < 0 || x >= m_width || y < 0 || y >= m_height)
     return;
 
-  if (!m_tileset->get_autotileset_from_tile(tile)->is_corner())
-    return;
-
   AutotileSet* curr_set = m_tileset->get_autotileset_from_tile(tile);
 
   // If tile is not autotileable, abort
-  if (curr_set == nullptr)
+  if (curr_set == nullptr || !curr_set->is_corner())
   {
     return;
   }
 
   // If tile is not empty or already of the appropriate tileset, abort
   uint32_t current_tile = m_tiles[y*m_width + x];
-  if (current_tile != 0 && (m_tileset->get_autotileset_from_tile(tile) != nullptr
-      && !m_tileset->get_autotileset_from_tile(tile)->is_member(current_tile)))
+  if (current_tile != 0 && !curr_set->is_member(current_tile))
   {
     return;
   }
@@ -823,7 +901,12 @@ TileMap::autotile_corner(int x, int y, uint32_t tile, AutotileCornerOperation op
     (mask & 0x01) != 0,
     x, y);
 
-  m_tiles[y*m_width + x] = realtile;
+  if (m_tiles[y*m_width + x] != realtile)
+  {
+    m_tiles[y*m_width + x] = realtile;
+    add_changed_tile(x, y);
+    calculateDrawRects(x, y);
+  }
 }
 
 bool
@@ -860,7 +943,12 @@ TileMap::autotile_erase(const Vector& pos, const Vector& corner_pos)
   else
   {
     int x = static_cast<int>(pos.x), y = static_cast<int>(pos.y);
-    m_tiles[y*m_width + x] = 0;
+    if (m_tiles[y*m_width + x] != 0)
+    {
+      m_tiles[y*m_width + x] = 0;
+      add_changed_tile(x, y);
+      calculateDrawRects(x, y);
+    }
 
     if (x - 1 >= 0 && y - 1 >= 0 && !is_corner(m_tiles[(y-1)*m_width + x-1])) {
       if (m_tiles[y*m_width + x] == 0)
@@ -981,6 +1069,41 @@ void
 TileMap::set_tileset(const TileSet* new_tileset)
 {
   m_tileset = new_tileset;
+  invalidate_draw_chunks();
+}
+
+void
+TileMap::reset_changed_tiles()
+{
+  m_collect_changed_tiles = true;
+  m_changed_tiles.clear();
+  m_all_tiles_changed = false;
+}
+
+void
+TileMap::add_changed_tile(int x, int y)
+{
+  if (!m_collect_changed_tiles || m_all_tiles_changed)
+    return;
+
+  // Past this point a full compare is cheaper than the list
+  if (m_changed_tiles.size() >= m_tiles.size())
+  {
+    set_all_tiles_changed();
+    return;
+  }
+
+  m_changed_tiles.push_back(y * m_width + x);
+}
+
+void
+TileMap::set_all_tiles_changed()
+{
+  if (!m_collect_changed_tiles)
+    return;
+
+  m_changed_tiles.clear();
+  m_all_tiles_changed = true;
 }
 
 void
@@ -994,31 +1117,181 @@ TileMap::draw_rects_update_enabled(bool enabled)
 }
 
 void
-TileMap::calculateDrawRects(uint32_t oldtile, uint32_t newtile)
+TileMap::calculateDrawRectsForArea(int x, int y, std::vector<int>& cells)
 {
-  if (!draw_rects_update)
+  const uint32_t tileid = m_tiles[y * m_width + x];
+  const size_t first_cell = cells.size();
+
+  int left = x;
+  int right = x;
+  int top = y;
+  int bottom = y;
+
+  // flood fill the 4-connected area of equal tiles, rectangles can't
+  // extend beyond it
+  cells.push_back(y * m_width + x);
+  m_draw_rects_visited[y * m_width + x] = 1;
+  for (size_t i = first_cell; i < cells.size(); ++i)
   {
-    return;
+    const int index = cells[i];
+    const int cx = index % m_width;
+    const int cy = index / m_width;
+
+    m_draw_rects_input[index] = 1;
+    tiles_draw_rects[index * 2] = 0;
+    tiles_draw_rects[index * 2 + 1] = 0;
+
+    left = std::min(left, cx);
+    right = std::max(right, cx);
+    top = std::min(top, cy);
+    bottom = std::max(bottom, cy);
+
+    const int neighbours[4][2] = { { cx - 1, cy }, { cx + 1, cy }, { cx, cy - 1 }, { cx, cy + 1 } };
+    for (const auto& n : neighbours)
+    {
+      if (n[0] < 0 || n[0] >= m_width || n[1] < 0 || n[1] >= m_height)
+        continue;
+
+      const int n_index = n[1] * m_width + n[0];
+      if (m_draw_rects_visited[n_index] || m_tiles[n_index] != tileid)
+        continue;
+
+      m_draw_rects_visited[n_index] = 1;
+      cells.push_back(n_index);
+    }
   }
-  std::vector<unsigned char> inputRects(m_tiles.size(), 0);
-  for (Tiles::size_type i = 0; i < m_tiles.size(); ++i)
+
+  FindRects::findAllInArea(m_draw_rects_input.data(), m_width,
+                           left, top, right - left + 1, bottom - top + 1,
+                           1, tiles_draw_rects.data());
+  invalidate_draw_chunks(left, top, right, bottom);
+
+  for (size_t i = first_cell; i < cells.size(); ++i)
   {
-    if (m_tiles[i] == newtile || m_tiles[i] == oldtile)
+    m_draw_rects_input[cells[i]] = 0;
+  }
+}
+
+void
+TileMap::set_draw_rect_owner(int index)
+{
+  const int left = index % m_width;
+  const int top = index / m_width;
+  const int right = left + tiles_draw_rects[index * 2];
+  const int bottom = top + tiles_draw_rects[index * 2 + 1];
+  for (int y = top; y < bottom; ++y)
+  {
+    for (int x = left; x < right; ++x)
     {
-      tiles_draw_rects[i * 2] = 0;
-      tiles_draw_rects[i * 2 + 1] = 0;
+      m_draw_rects_owner[y * m_width + x] = index;
     }
-    if (m_tiles[i] == newtile)
+  }
+}
+
+void
+TileMap::update_draw_rect_owners()
+{
+  m_draw_rects_owner.assign(m_tiles.size(), -1);
+  for (int index = 0; index < static_cast<int>(m_tiles.size()); ++index)
+  {
+    if (tiles_draw_rects[index * 2] != 0)
+      set_draw_rect_owner(index);
+  }
+}
+
+void
+TileMap::calculateDrawRects(int x, int y)
+{
+  if (!draw_rects_update)
+  {
+    return;
+  }
+
+  const int index = y * m_width + x;
+  invalidate_draw_chunks(x, y, x, y);
+
+  // The rectangle that covered the old tile has to be split up, the new
+  // tile might join the rectangles of neighbours with the new id. The
+  // rest of the map keeps its rectangles.
+  std::vector<int> rects;
+  auto add_rect = [this, &rects](int cell) {
+    const int owner = m_draw_rects_owner[cell];
+    if (owner >= 0 && std::find(rects.begin(), rects.end(), owner) == rects.end())
+      rects.push_back(owner);
+  };
+
+  add_rect(index);
+  const int neighbours[4][2] = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+  for (const auto& n : neighbours)
+  {
+    if (n[0] < 0 || n[0] >= m_width || n[1] < 0 || n[1] >= m_height)
+      continue;
+
+    const int n_index = n[1] * m_width + n[0];
+    if (m_tiles[n_index] == m_tiles[index])
+      add_rect(n_index);
+  }
+
+  std::vector<int> cells;
+  for (const int rect : rects)
+  {
+    const int left = rect % m_width;
+    const int top = rect / m_width;
+    const int right = left + tiles_draw_rects[rect * 2];
+    const int bottom = top + tiles_draw_rects[rect * 2 + 1];
+    tiles_draw_rects[rect * 2] = 0;
+    tiles_draw_rects[rect * 2 + 1] = 0;
+
+    for (int cy = top; cy < bottom; ++cy)
     {
-      inputRects[i] = 1;
+      for (int cx = left; cx < right; ++cx)
+      {
+        const int cell = cy * m_width + cx;
+        m_draw_rects_owner[cell] = -1;
+        if (cell != index)
+          cells.push_back(cell);
+      }
     }
   }
-  FindRects::findAll(inputRects.data(), m_width, m_height, 1, tiles_draw_rects.data());
-  for (Tiles::size_type i = 0; i < m_tiles.size(); ++i)
+  if (m_tiles[index] != 0)
+    cells.push_back(index);
+
+  // Merge the freed tiles again, one tile id at a time
+  while (!cells.empty())
   {
-    inputRects[i] = (m_tiles[i] == oldtile) ? 1 : 0;
+    const uint32_t tileid = m_tiles[cells.front()];
+    const auto other = std::partition(cells.begin(), cells.end(),
+                                      [this, tileid](int cell) { return m_tiles[cell] == tileid; });
+
+    int left = m_width;
+    int right = -1;
+    int top = m_height;
+    int bottom = -1;
+    for (auto it = cells.begin(); it != other; ++it)
+    {
+      const int cx = *it % m_width;
+      const int cy = *it / m_width;
+      left = std::min(left, cx);
+      right = std::max(right, cx);
+      top = std::min(top, cy);
+      bottom = std::max(bottom, cy);
+      m_draw_rects_input[*it] = 1;
+    }
+
+    FindRects::findAllInArea(m_draw_rects_input.data(), m_width,
+                             left, top, right - left + 1, bottom - top + 1,
+                             1, tiles_draw_rects.data());
+    invalidate_draw_chunks(left, top, right, bottom);
+
+    for (auto it = cells.begin(); it != other; ++it)
+    {
+      m_draw_rects_input[*it] = 0;
+      if (tiles_draw_rects[*it * 2] != 0)
+        set_draw_rect_owner(*it);
+    }
+
+    cells.erase(cells.begin(), other);
   }
-  FindRects::findAll(inputRects.data(), m_width, m_height, 1, tiles_draw_rects.data());
 }
 
 void
@@ -1029,8 +1302,11 @@ TileMap::calculateDrawRects(bool useCache)
     return;
   }
   //log_warning << "TileMap::calculateDrawRects long" << std::endl;
+  invalidate_draw_chunks();
   fill(tiles_draw_rects.begin(), tiles_draw_rects.end(), 0);
   tiles_draw_rects.resize(m_tiles.size() * 2, 0);
+  m_draw_rects_input.assign(m_tiles.size(), 0);
+  m_draw_rects_visited.assign(m_tiles.size(), 0);
 
   std::string fname;
   if (useCache)
@@ -1046,31 +1322,30 @@ TileMap::calculateDrawRects(bool useCache)
       PHYSFS_close(file);
       if (size == static_cast<long long>(m_tiles.size()) * 2)
       {
+        update_draw_rect_owners();
         return;
       }
     }
     //ScreenManager::current()->draw_loading_screen();
   }
 
-  std::vector<unsigned char> inputRects(m_tiles.size(), 0);
-  for (uint32_t tileid = 0; tileid < m_tileset->get_max_tileid(); tileid++)
+  // Every area of equal, connected tiles is merged on its own, so each
+  // tile is only looked at by the rectangle search of its own area.
+  std::vector<int> cells;
+  for (int y = 0; y < m_height; ++y)
   {
-    bool skip = true;
-    std::vector<unsigned char>::iterator ir = inputRects.begin();
-    for (Tiles::const_iterator i = m_tiles.begin(); i != m_tiles.end(); ++i, ++ir)
+    for (int x = 0; x < m_width; ++x)
     {
-      if (*i == tileid)
-      {
-        skip = false;
-        *ir = 1;
-      }
-    }
-    if (!skip)
-    {
-      FindRects::findAll(inputRects.data(), m_width, m_height, 1, tiles_draw_rects.data());
-      fill(inputRects.begin(), inputRects.end(), 0);
+      const int index = y * m_width + x;
+      if (m_tiles[index] == 0 || m_draw_rects_visited[index])
+        continue;
+
+      cells.clear();
+      calculateDrawRectsForArea(x, y, cells);
     }
   }
+  fill(m_draw_rects_visited.begin(), m_draw_rects_visited.end(), 0);
+  update_draw_rect_owners();
 
   if (useCache)
   {
@@ -1087,4 +1362,93 @@ TileMap::calculateDrawRects(bool useCache)
   }
 }
 
+bool
+TileMap::draw_chunks_enabled() const
+{
+  return !Editor::is_active() && !g_debug.show_collision_rects && draw_rects_update;
+}
+
+void
+TileMap::invalidate_draw_chunks()
+{
+  m_draw_chunks_width = (m_width + DRAW_CHUNK_SIZE - 1) / DRAW_CHUNK_SIZE;
+  m_draw_chunks_height = (m_height + DRAW_CHUNK_SIZE - 1) / DRAW_CHUNK_SIZE;
+
+  m_draw_chunks.clear();
+  m_draw_chunks.resize(m_draw_chunks_width * m_draw_chunks_height);
+}
+
+void
+TileMap::invalidate_draw_chunks(int left, int top, int right, int bottom)
+{
+  const int chunk_right = std::min(right / DRAW_CHUNK_SIZE, m_draw_chunks_width - 1);
+  const int chunk_bottom = std::min(bottom / DRAW_CHUNK_SIZE, m_draw_chunks_height - 1);
+
+  for (int cy = top / DRAW_CHUNK_SIZE; cy <= chunk_bottom; ++cy)
+  {
+    for (int cx = left / DRAW_CHUNK_SIZE; cx <= chunk_right; ++cx)
+    {
+      m_draw_chunks[cy * m_draw_chunks_width + cx].dirty = true;
+    }
+  }
+}
+
+void
+TileMap::rebuild_draw_chunk(int chunk_x, int chunk_y)
+{
+  DrawChunk& chunk = m_draw_chunks[chunk_y * m_draw_chunks_width + chunk_x];
+
+  chunk.dirty = false;
+  chunk.right = 0;
+  chunk.bottom = 0;
+  chunk.batches.clear();
+  chunk.animated_tiles.clear();
+
+  std::unordered_map<SurfacePtr, CachedTextureBatch*> batches;
+
+  const int left = chunk_x * DRAW_CHUNK_SIZE;
+  const int top = chunk_y * DRAW_CHUNK_SIZE;
+  const int right = std::min(left + DRAW_CHUNK_SIZE, m_width);
+  const int bottom = std::min(top + DRAW_CHUNK_SIZE, m_height);
+
+  for (int y = top; y < bottom; ++y)
+  {
+    for (int x = left; x < right; ++x)
+    {
+      const int index = y * m_width + x;
+      const int width = tiles_draw_rects[index * 2];
+      const int height = tiles_draw_rects[index * 2 + 1];
+      if (width == 0 || m_tiles[index] == 0)
+        continue;
+
+      chunk.right = std::max(chunk.right, x + width);
+      chunk.bottom = std::max(chunk.bottom, y + height);
+
+      const Tile& tile = m_tileset->get(m_tiles[index]);
+      if (tile.is_animated())
+      {
+        chunk.animated_tiles.push_back(index);
+        continue;
+      }
+
+      const SurfacePtr surface = tile.get_current_surface();
+      if (!surface)
+        continue;
+
+      CachedTextureBatch*& batch = batches[surface];
+      if (!batch)
+      {
+        chunk.batches.emplace_back(surface, std::make_unique<CachedTextureBatch>());
+        batch = chunk.batches.back().second.get();
+      }
+
+      batch->add(surface->get_region(),
+                 Rectf(Vector(static_cast<float>(x), static_cast<float>(y)) * 32.0f,
+                       Sizef(static_cast<float>(surface->get_width()),
+                             static_cast<float>(surface->get_height()))),
+                 Size(width, height));
+    }
+  }
+}
+
 /* EOF */
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_OBJECT_TILEMAP_HPP
 
 #include <algorithm>
+#include <memory>
 #include <unordered_set>
 
 #include "math/rect.hpp"
@@ -29,9 +30,11 @@
 #include "scripting/tilemap.hpp"
 #include "supertux/autotile.hpp"
 #include "supertux/game_object.hpp"
+#include "video/cached_texture_batch.hpp"
 #include "video/color.hpp"
 #include "video/flip.hpp"
 #include "video/drawing_target.hpp"
+#include "video/surface_ptr.hpp"
 
 class DrawingContext;
 class CollisionObject;
@@ -133,7 +136,10 @@ public:
   /** Called by the collision mechanism to indicate that this tilemap has been hit on
       the top, i.e. has hit a moving object on the bottom of its collision rectangle. */
   void hits_object_bottom(CollisionObject& object);
-  void notify_object_removal(CollisionObject* other);
+
+  /** Forgets the removed objects, returns false if no object is left
+      touching the top of this tilemap */
+  bool notify_object_removal(const std::vector<CollisionObject*>& removed);
 
   int get_layer() const { return m_z_pos; }
   void set_layer(int layer_) { m_z_pos = layer_; }
@@ -206,6 +212,19 @@ public:
 
   const std::vector<uint32_t>& get_tiles() const { return m_tiles; }
 
+  /** Starts collecting the tiles changed from now on, replacing the
+      ones collected so far. Used by the editor undo history. */
+  void reset_changed_tiles();
+
+  /** Indices into get_tiles() of the tiles changed since the last
+      reset_changed_tiles(), possibly with duplicates. Only valid if
+      all_tiles_changed() is false. */
+  const std::vector<int>& get_changed_tiles() const { return m_changed_tiles; }
+
+  /** true if the tiles were replaced wholesale, or too many changed
+      to keep track of them one by one */
+  bool all_tiles_changed() const { return m_all_tiles_changed; }
+
 private:
   void update_effective_solid();
   void float_channel(float target, float &current, float remaining_time, float dt_sec);
@@ -215,6 +234,10 @@ private:
   void apply_offset_x(int fill_id, int xoffset);
   void apply_offset_y(int fill_id, int yoffset);
 
+  /** Adds tile x, y to the changed tiles, if they are collected */
+  void add_changed_tile(int x, int y);
+  void set_all_tiles_changed();
+
 public:
   bool m_editor_active;
 
@@ -228,6 +251,50 @@ private:
   TilesDrawRects tiles_draw_rects; /**< Tiles draw cache, with adjacent tiles merged into big rectangles */
   bool draw_rects_update;
 
+  /** Scratch buffers for calculateDrawRects(), all zero between calls */
+  std::vector<unsigned char> m_draw_rects_input;
+  std::vector<unsigned char> m_draw_rects_visited;
+
+  /** Index of the top left tile of the draw rectangle covering each
+      tile, -1 if none does, so a changed tile can find its rectangle */
+  std::vector<int> m_draw_rects_owner;
+
+  /** See get_changed_tiles(), only collected after reset_changed_tiles() */
+  bool m_collect_changed_tiles;
+  std::vector<int> m_changed_tiles;
+  bool m_all_tiles_changed;
+
+  /** Geometry of the draw rectangles starting in a square of
+      DRAW_CHUNK_SIZE x DRAW_CHUNK_SIZE tiles, kept between frames */
+  struct DrawChunk
+  {
+    DrawChunk() :
+      dirty(true),
+      right(0),
+      bottom(0),
+      batches(),
+      animated_tiles()
+    {}
+
+    bool dirty;
+
+    /** Tiles covered by the rectangles of this chunk end here, exclusive */
+    int right;
+    int bottom;
+
+    /** Positions relative to m_offset */
+    std::vector<std::pair<SurfacePtr, std::unique_ptr<CachedTextureBatch> > > batches;
+
+    /** Animated tiles change their surface, they are batched every frame */
+    std::vector<int> animated_tiles;
+  };
+
+  static const int DRAW_CHUNK_SIZE = 16;
+
+  std::vector<DrawChunk> m_draw_chunks;
+  int m_draw_chunks_width;
+  int m_draw_chunks_height;
+
   /* read solid: In *general*, is this a solid layer? effective solid:
      is the layer *currently* solid? A generally solid layer may be
      not solid when its alpha is low. See `is_solid' above. */
@@ -274,8 +341,35 @@ private:
   TileMap(const TileMap&) = delete;
   TileMap& operator=(const TileMap&) = delete;
 
+  /** Rebuilds the whole draw cache, one pass over the tiles */
   void calculateDrawRects(bool useCache = false);
-  void calculateDrawRects(uint32_t oldtile, uint32_t newtile);
+
+  /** Rebuilds only the rectangle that covered the changed tile at x, y
+      and the rectangles of its new id next to it */
+  void calculateDrawRects(int x, int y);
+
+  /** Merges the area of equal tiles connected to x, y into rectangles.
+      The cells of the area are appended to `cells` and marked as
+      visited. */
+  void calculateDrawRectsForArea(int x, int y, std::vector<int>& cells);
+
+  /** Sets the owner of all tiles of the draw rectangle starting at index */
+  void set_draw_rect_owner(int index);
+
+  /** Sets the owners of all tiles from tiles_draw_rects */
+  void update_draw_rect_owners();
+
+  /** Whether the cached draw chunks can be used, they don't know about
+      editor surfaces, debug drawing and disabled draw rect updates */
+  bool draw_chunks_enabled() const;
+
+  /** Marks all draw chunks as dirty and resizes them to the map */
+  void invalidate_draw_chunks();
+
+  /** Marks the draw chunks overlapping the given tiles, inclusive, as dirty */
+  void invalidate_draw_chunks(int left, int top, int right, int bottom);
+
+  void rebuild_draw_chunk(int chunk_x, int chunk_y);
 };
 
 #endif
@@ -33,6 +33,8 @@ public:
   Torch(const ReaderMapping& reader);
 
   virtual void draw(DrawingContext& context) override;
+  /** The flame light is a lot larger than the torch */
+  virtual float get_draw_margin() const override { return 512.0f; }
   virtual void update(float) override;
 
   virtual HitResponse collision(GameObject& other, const CollisionHit& ) override;
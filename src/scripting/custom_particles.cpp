@@ -42,6 +42,7 @@ void CustomParticles::spawn_particles(int amount, bool instantly)
   SCRIPT_GUARD_VOID;
   if (instantly)
   {
+    object.update_zone_index();
     for (int i  = 0; i < amount; i++)
     {
       object.spawn_particles(0.f);
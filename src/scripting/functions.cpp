@@ -21,6 +21,7 @@
 #include "object/camera.hpp"
 #include "object/player.hpp"
 #include "physfs/ifile_stream.hpp"
+#include "physfs/ofile_stream.hpp"
 #include "supertux/console.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/game_manager.hpp"
@@ -32,6 +33,8 @@
 #include "supertux/shrinkfade.hpp"
 #include "supertux/textscroller_screen.hpp"
 #include "supertux/tile.hpp"
+#include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/renderer.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
@@ -295,6 +298,20 @@ void debug_worldmap_ghost(bool enable)
   tux.set_ghost_mode(enable);
 }
 
+#ifdef ENABLE_PROFILER
+void debug_show_profiler(bool enable)
+{
+  g_debug.show_profiler = enable;
+}
+
+void debug_dump_profile(const std::string& filename)
+{
+  OFileStream out(filename);
+  g_profiler.write_chrome_trace(out);
+  log_info << "Wrote " << g_profiler.get_frame_count() << " frames to '" << filename << "'" << std::endl;
+}
+#endif
+
 void save_state()
 {
   auto worldmap = worldmap::WorldMap::current();
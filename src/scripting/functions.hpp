@@ -17,12 +17,15 @@
 #ifndef HEADER_SUPERTUX_SCRIPTING_FUNCTIONS_HPP
 #define HEADER_SUPERTUX_SCRIPTING_FUNCTIONS_HPP
 
+#include "config.h"
+
 #ifndef SCRIPTING_API
 #include <squirrel.h>
 #include <string>
 
 #define __suspend
 #define __custom(x)
+#define __ifdef(x)
 #endif
 
 namespace scripting {
@@ -97,6 +100,14 @@ void debug_draw_editor_images(bool enable);
 /** enable/disable worldmap ghost mode */
 void debug_worldmap_ghost(bool enable);
 
+#if defined(ENABLE_PROFILER) || defined(SCRIPTING_API)
+/** enable/disable the frame profiler overlay */
+void debug_show_profiler(bool enable) __ifdef("ENABLE_PROFILER");
+
+/** Writes the recently profiled frames as Chrome trace events to filename in the user directory */
+void debug_dump_profile(const std::string& filename) __ifdef("ENABLE_PROFILER");
+#endif
+
 /** Changes music to musicfile */
 void play_music(const std::string& musicfile);
 
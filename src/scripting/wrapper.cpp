@@ -11653,6 +11653,56 @@ static SQInteger debug_worldmap_ghost_wrapper(HSQUIRRELVM vm)
 
 }
 
+#ifdef ENABLE_PROFILER
+static SQInteger debug_show_profiler_wrapper(HSQUIRRELVM vm)
+{
+  SQBool arg0;
+  if(SQ_FAILED(sq_getbool(vm, 2, &arg0))) {
+    sq_throwerror(vm, _SC("Argument 1 not a bool"));
+    return SQ_ERROR;
+  }
+
+  try {
+    scripting::debug_show_profiler(arg0 == SQTrue);
+
+    return 0;
+
+  } catch(std::exception& e) {
+    sq_throwerror(vm, e.what());
+    return SQ_ERROR;
+  } catch(...) {
+    sq_throwerror(vm, _SC("Unexpected exception while executing function 'debug_show_profiler'"));
+    return SQ_ERROR;
+  }
+
+}
+#endif
+
+#ifdef ENABLE_PROFILER
+static SQInteger debug_dump_profile_wrapper(HSQUIRRELVM vm)
+{
+  const SQChar* arg0;
+  if(SQ_FAILED(sq_getstring(vm, 2, &arg0))) {
+    sq_throwerror(vm, _SC("Argument 1 not a string"));
+    return SQ_ERROR;
+  }
+
+  try {
+    scripting::debug_dump_profile(arg0);
+
+    return 0;
+
+  } catch(std::exception& e) {
+    sq_throwerror(vm, e.what());
+    return SQ_ERROR;
+  } catch(...) {
+    sq_throwerror(vm, _SC("Unexpected exception while executing function 'debug_dump_profile'"));
+    return SQ_ERROR;
+  }
+
+}
+#endif
+
 static SQInteger play_music_wrapper(HSQUIRRELVM vm)
 {
   const SQChar* arg0;
@@ -13216,6 +13266,24 @@ void register_supertux_wrapper(HSQUIRRELVM v)
     throw SquirrelError(v, "Couldn't register function 'debug_worldmap_ghost'");
   }
 
+#ifdef ENABLE_PROFILER
+  sq_pushstring(v, "debug_show_profiler", -1);
+  sq_newclosure(v, &debug_show_profiler_wrapper, 0);
+  sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|tb");
+  if(SQ_FAILED(sq_createslot(v, -3))) {
+    throw SquirrelError(v, "Couldn't register function 'debug_show_profiler'");
+  }
+#endif
+
+#ifdef ENABLE_PROFILER
+  sq_pushstring(v, "debug_dump_profile", -1);
+  sq_newclosure(v, &debug_dump_profile_wrapper, 0);
+  sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|ts");
+  if(SQ_FAILED(sq_createslot(v, -3))) {
+    throw SquirrelError(v, "Couldn't register function 'debug_dump_profile'");
+  }
+#endif
+
   sq_pushstring(v, "play_music", -1);
   sq_newclosure(v, &play_music_wrapper, 0);
   sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|ts");
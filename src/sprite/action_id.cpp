@@ -0,0 +1,75 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "sprite/action_id.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/** Function local, so that ids can be created during static
+    initialization */
+struct Registry
+{
+  std::unordered_map<std::string, uint32_t> ids;
+  std::vector<const std::string*> names;
+};
+
+Registry& get_registry()
+{
+  static Registry registry;
+  return registry;
+}
+
+} // namespace
+
+ActionId::ActionId(const std::string& name) :
+  m_value(INVALID)
+{
+  Registry& registry = get_registry();
+  auto it = registry.ids.find(name);
+  if (it == registry.ids.end())
+  {
+    it = registry.ids.insert(std::make_pair(name, static_cast<uint32_t>(registry.names.size()))).first;
+    registry.names.push_back(&it->first);
+  }
+  m_value = it->second;
+}
+
+ActionId
+ActionId::find(const std::string& name)
+{
+  const Registry& registry = get_registry();
+  auto it = registry.ids.find(name);
+
+  ActionId id;
+  if (it != registry.ids.end())
+    id.m_value = it->second;
+  return id;
+}
+
+const std::string&
+ActionId::get_name() const
+{
+  static const std::string empty;
+  if (!is_valid())
+    return empty;
+  return *get_registry().names[m_value];
+}
+
+/* EOF */
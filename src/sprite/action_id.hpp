@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SPRITE_ACTION_ID_HPP
+#define HEADER_SUPERTUX_SPRITE_ACTION_ID_HPP
+
+#include <stdint.h>
+#include <string>
+
+/**
+ * Interned name of a sprite action. Ids are shared by all sprites, so
+ * an id can be resolved once, for example in a constructor, and then
+ * be passed to Sprite::set_action() without any string handling.
+ */
+class ActionId final
+{
+public:
+  ActionId() : m_value(INVALID) {}
+
+  /** Interns `name`, the id stays valid for the lifetime of the program */
+  explicit ActionId(const std::string& name);
+
+  /** Returns the id of `name` if it was interned before, an invalid
+      id otherwise. Doesn't intern `name`. */
+  static ActionId find(const std::string& name);
+
+  bool is_valid() const { return m_value != INVALID; }
+  uint32_t get_value() const { return m_value; }
+  const std::string& get_name() const;
+
+  bool operator==(const ActionId& other) const { return m_value == other.m_value; }
+  bool operator!=(const ActionId& other) const { return m_value != other.m_value; }
+
+private:
+  static const uint32_t INVALID = 0xffffffffu;
+
+private:
+  uint32_t m_value;
+};
+
+#endif
+
+/* EOF */
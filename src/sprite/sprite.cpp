@@ -32,10 +32,8 @@ Sprite::Sprite(SpriteData& newdata) :
   m_alpha(1.0f),
   m_color(1.0f, 1.0f, 1.0f, 1.0f),
   m_blend(),
-  m_action(m_data.get_action("normal"))
+  m_action(m_data.get_default_action())
 {
-  if (!m_action)
-    m_action = m_data.actions.begin()->second.get();
   m_last_ticks = g_game_time;
 }
 
@@ -75,11 +73,32 @@ Sprite::set_action(const std::string& name, int loops)
     return;
   }
 
+  switch_action(newaction, loops);
+}
+
+void
+Sprite::set_action(const ActionId& id, int loops)
+{
+  if (m_action && m_action->id == id)
+    return;
+
+  const SpriteData::Action* newaction = m_data.get_action(id);
+  if (!newaction) {
+    log_debug << "Action '" << id.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  switch_action(newaction, loops);
+}
+
+void
+Sprite::switch_action(const SpriteData::Action* newaction, int loops)
+{
   // If the new action has a loops property,
   // we prefer that over the parameter.
   m_animation_loops = newaction->has_custom_loops ? newaction->loops : loops;
 
-  if (!m_action || m_action->family_name != newaction->family_name)
+  if (!m_action || m_action->family != newaction->family)
   {
     m_frame = 0;
     m_frameidx = 0;
@@ -104,6 +123,22 @@ Sprite::set_action_continued(const std::string& name)
   update();
 }
 
+void
+Sprite::set_action_continued(const ActionId& id)
+{
+  if (m_action && m_action->id == id)
+    return;
+
+  const SpriteData::Action* newaction = m_data.get_action(id);
+  if (!newaction) {
+    log_debug << "Action '" << id.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  m_action = newaction;
+  update();
+}
+
 bool
 Sprite::animation_done() const
 {
@@ -30,6 +30,7 @@
 
 SpriteData::Action::Action() :
   name(),
+  id(),
   x_offset(0),
   y_offset(0),
   hitbox_w(0),
@@ -38,12 +39,14 @@ SpriteData::Action::Action() :
   loops(-1),
   has_custom_loops(false),
   family_name(),
+  family(),
   surfaces()
 {
 }
 
 SpriteData::SpriteData(const ReaderMapping& mapping) :
   actions(),
+  action_table(),
   name()
 {
   auto iter = mapping.get_iter();
@@ -168,7 +171,7 @@ SpriteData::parse_action(const ReaderMapping& mapping)
       float max_w = 0;
       float max_h = 0;
       for (const auto& image : images) {
-        auto surface = Surface::from_file(FileSystem::join(mapping.get_doc().get_directory(), image));
+        auto surface = Surface::from_file_atlased(FileSystem::join(mapping.get_doc().get_directory(), image));
         max_w = std::max(max_w, static_cast<float>(surface->get_width()));
         max_h = std::max(max_h, static_cast<float>(surface->get_height()));
         action->surfaces.push_back(surface);
@@ -211,17 +214,78 @@ SpriteData::parse_action(const ReaderMapping& mapping)
       throw std::runtime_error(msg.str());
     }
   }
-  actions[action->name] = std::move(action);
+
+  // Set last, clone-action copies the whole action
+  action->id = ActionId(action->name);
+  action->family = ActionId(action->family_name);
+  add_action(std::move(action));
+}
+
+void
+SpriteData::add_action(std::unique_ptr<Action> action)
+{
+  // Doubling the table when it would get more than half full keeps
+  // adding all actions of a sprite linear.
+  if (action_table.size() < (actions.size() + 1) * 2)
+    rebuild_action_table(std::max<size_t>(8, action_table.size() * 2));
+
+  const size_t slot = find_slot(action->id);
+  if (action_table[slot])
+  {
+    // Replace the action of the same name
+    const Action* old_action = action_table[slot];
+    auto it = std::find_if(actions.begin(), actions.end(),
+                           [old_action](const std::unique_ptr<Action>& other) {
+                             return other.get() == old_action;
+                           });
+    action_table[slot] = action.get();
+    *it = std::move(action);
+  }
+  else
+  {
+    action_table[slot] = action.get();
+    actions.push_back(std::move(action));
+  }
+}
+
+void
+SpriteData::rebuild_action_table(size_t size)
+{
+  action_table.assign(size, nullptr);
+  for (const auto& action : actions)
+    action_table[find_slot(action->id)] = action.get();
+}
+
+size_t
+SpriteData::find_slot(const ActionId& id) const
+{
+  const size_t mask = action_table.size() - 1;
+  size_t i = hash(id) & mask;
+  while (action_table[i] && action_table[i]->id != id)
+    i = (i + 1) & mask;
+  return i;
 }
 
 const SpriteData::Action*
 SpriteData::get_action(const std::string& act) const
 {
-  Actions::const_iterator i = actions.find(act);
-  if (i == actions.end()) {
-    return nullptr;
+  return get_action(ActionId::find(act));
+}
+
+const SpriteData::Action*
+SpriteData::get_default_action() const
+{
+  static const ActionId normal("normal");
+  if (const Action* action = get_action(normal))
+    return action;
+
+  const Action* first = nullptr;
+  for (const auto& action : actions)
+  {
+    if (!first || action->name < first->name)
+      first = action.get();
   }
-  return i->second.get();
+  return first;
 }
 
 /* EOF */
@@ -17,10 +17,11 @@
 #ifndef HEADER_SUPERTUX_SPRITE_SPRITE_DATA_HPP
 #define HEADER_SUPERTUX_SPRITE_SPRITE_DATA_HPP
 
-#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "sprite/action_id.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -44,6 +45,7 @@ private:
     Action();
 
     std::string name;
+    ActionId id;
 
     /** Position correction */
     float x_offset;
@@ -70,17 +72,53 @@ private:
         (aka not reset when switching from one
         to another) */
     std::string family_name;
+    ActionId family;
 
     std::vector<SurfacePtr> surfaces;
   };
 
-  typedef std::map <std::string, std::unique_ptr<Action> > Actions;
+  /** Actions in the order they were defined, looked up through
+      action_table */
+  typedef std::vector<std::unique_ptr<Action> > Actions;
 
   void parse_action(const ReaderMapping& mapping);
+  /** Adds `action`, replacing an action of the same name */
+  void add_action(std::unique_ptr<Action> action);
+
+  /** Fills a new action_table of `size` slots with all actions */
+  void rebuild_action_table(size_t size);
+
+  /** Slot of the action with `id` in action_table, or the empty slot
+      where it would be inserted */
+  size_t find_slot(const ActionId& id) const;
+
   /** Get an action */
   const Action* get_action(const std::string& act) const;
+  const Action* get_action(const ActionId& id) const
+  {
+    if (!id.is_valid() || action_table.empty())
+      return nullptr;
+
+    const size_t mask = action_table.size() - 1;
+    for (size_t i = hash(id) & mask; action_table[i]; i = (i + 1) & mask)
+    {
+      if (action_table[i]->id == id)
+        return action_table[i];
+    }
+    return nullptr;
+  }
+
+  /** Returns "normal", or the first action by name if there is none */
+  const Action* get_default_action() const;
+
+  static size_t hash(const ActionId& id) { return static_cast<size_t>(id.get_value()) * 2654435761u; }
 
   Actions actions;
+
+  /** Open addressing hash table of the actions, keyed by ActionId.
+      Its size is a power of two and it is at most half full. */
+  std::vector<const Action*> action_table;
+
   std::string name;
 };
 
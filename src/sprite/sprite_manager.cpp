@@ -49,6 +49,12 @@ SpriteManager::create(const std::string& name)
   return SpritePtr(new Sprite(*data));
 }
 
+bool
+SpriteManager::is_loaded(const std::string& filename) const
+{
+  return sprites.find(filename) != sprites.end();
+}
+
 SpriteData*
 SpriteManager::load(const std::string& filename)
 {
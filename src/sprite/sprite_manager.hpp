@@ -38,6 +38,8 @@ public:
   /** loads a sprite. */
   SpritePtr create(const std::string& filename);
 
+  bool is_loaded(const std::string& filename) const;
+
 private:
   SpriteData* load(const std::string& filename);
 };
@@ -27,12 +27,30 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** The cache is flushed when it grows beyond this, levels which
+    generate their scripts on the fly shouldn't pile up closures. */
+const size_t MAX_COMPILED_SCRIPTS = 1024;
+
+size_t hash_script(const std::string& script, const std::string& sourcename)
+{
+  size_t hash = std::hash<std::string>()(script);
+  hash ^= std::hash<std::string>()(sourcename) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+} // namespace
+
 SquirrelEnvironment::SquirrelEnvironment(SquirrelVM& vm, const std::string& name) :
   m_vm(vm),
   m_table(),
   m_name(name),
   m_scripts(),
-  m_scheduler(std::make_unique<SquirrelScheduler>(m_vm))
+  m_scheduler(std::make_unique<SquirrelScheduler>(m_vm)),
+  m_compiled_scripts(),
+  m_script_cache_hits(0),
+  m_script_cache_misses(0)
 {
   // garbage collector has to be invoked manually
   sq_collectgarbage(m_vm.get_vm());
@@ -53,6 +71,10 @@ SquirrelEnvironment::SquirrelEnvironment(SquirrelVM& vm, const std::string& name
 
 SquirrelEnvironment::~SquirrelEnvironment()
 {
+  log_debug << "Script cache of '" << m_name << "': " << m_script_cache_hits << " hits, "
+            << m_script_cache_misses << " misses" << std::endl;
+  clear_script_cache();
+
   for (auto& script: m_scripts)
   {
     sq_release(m_vm.get_vm(), &script);
@@ -124,8 +146,18 @@ SquirrelEnvironment::run_script(const std::string& script, const std::string& so
 {
   if (script.empty()) return;
 
-  std::istringstream stream(script);
-  run_script(stream, sourcename);
+  garbage_collect();
+
+  try
+  {
+    HSQUIRRELVM vm = create_script_thread();
+    push_compiled_script(vm, script, sourcename);
+    run_compiled_script(vm);
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Error running script: " << e.what() << std::endl;
+  }
 }
 
 void
@@ -153,23 +185,74 @@ SquirrelEnvironment::run_script(std::istream& in, const std::string& sourcename)
 
   try
   {
-    HSQOBJECT object = m_vm.create_thread();
-    m_scripts.push_back(object);
+    HSQUIRRELVM vm = create_script_thread();
+    compile_and_run(vm, in, sourcename);
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Error running script: " << e.what() << std::endl;
+  }
+}
 
-    HSQUIRRELVM vm = object_to_vm(object);
+HSQUIRRELVM
+SquirrelEnvironment::create_script_thread()
+{
+  HSQOBJECT object = m_vm.create_thread();
+  m_scripts.push_back(object);
 
-    sq_setforeignptr(vm, this);
+  HSQUIRRELVM vm = object_to_vm(object);
 
-    // set root table
-    sq_pushobject(vm, m_table);
-    sq_setroottable(vm);
+  sq_setforeignptr(vm, this);
 
-    compile_and_run(vm, in, sourcename);
+  // set root table
+  sq_pushobject(vm, m_table);
+  sq_setroottable(vm);
+
+  return vm;
+}
+
+void
+SquirrelEnvironment::push_compiled_script(HSQUIRRELVM vm, const std::string& script, const std::string& sourcename)
+{
+  const size_t hash = hash_script(script, sourcename);
+
+  auto range = m_compiled_scripts.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second.source == script && it->second.sourcename == sourcename)
+    {
+      m_script_cache_hits += 1;
+      sq_pushobject(vm, it->second.closure);
+      return;
+    }
   }
-  catch(const std::exception& e)
+
+  m_script_cache_misses += 1;
+
+  // compiled on the script's thread, so the closure is bound to m_table
+  std::istringstream stream(script);
+  compile_script(vm, stream, sourcename);
+
+  if (m_compiled_scripts.size() >= MAX_COMPILED_SCRIPTS)
+    clear_script_cache();
+
+  HSQOBJECT closure;
+  sq_resetobject(&closure);
+  if (SQ_FAILED(sq_getstackobj(vm, -1, &closure)))
+    throw SquirrelError(vm, "Couldn't get compiled script");
+  sq_addref(m_vm.get_vm(), &closure);
+
+  m_compiled_scripts.emplace(hash, CompiledScript{ script, sourcename, closure });
+}
+
+void
+SquirrelEnvironment::clear_script_cache()
+{
+  for (auto& entry : m_compiled_scripts)
   {
-    log_warning << "Error running script: " << e.what() << std::endl;
+    sq_release(m_vm.get_vm(), &entry.second.closure);
   }
+  m_compiled_scripts.clear();
 }
 
 void
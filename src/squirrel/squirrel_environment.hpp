@@ -19,6 +19,7 @@
 #define HEADER_SUPERTUX_SQUIRREL_SQUIRREL_ENVIRONMENT_HPP
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <squirrel.h>
@@ -62,7 +63,8 @@ public:
   void unexpose(const std::string& name);
 
   /** Convenience function that takes an std::string instead of an
-      std::istream& */
+      std::istream&. The compiled script is cached, so running the
+      same script again only needs a new thread. */
   void run_script(const std::string& script, const std::string& sourcename);
 
   /** Runs a script in the context of the SquirrelEnvironment (m_table will
@@ -75,9 +77,32 @@ public:
   void wait_for_seconds(HSQUIRRELVM vm, float seconds);
   void skippable_wait_for_seconds(HSQUIRRELVM vm, float seconds);
 
+  int get_script_cache_hits() const { return m_script_cache_hits; }
+  int get_script_cache_misses() const { return m_script_cache_misses; }
+  size_t get_script_cache_size() const { return m_compiled_scripts.size(); }
+
+private:
+  /** A script compiled by run_script(). Closures remember the root
+      table they were compiled with, so the cache can't be shared
+      between environments. */
+  struct CompiledScript
+  {
+    std::string source;
+    std::string sourcename;
+    HSQOBJECT closure;
+  };
+
 private:
   void garbage_collect();
 
+  /** Creates a thread running in this environment */
+  HSQUIRRELVM create_script_thread();
+
+  /** Pushes the closure of the script onto the stack of vm, the
+      script is only compiled if it is not in the cache yet. */
+  void push_compiled_script(HSQUIRRELVM vm, const std::string& script, const std::string& sourcename);
+  void clear_script_cache();
+
 private:
   SquirrelVM& m_vm;
   HSQOBJECT m_table;
@@ -85,6 +110,11 @@ private:
   std::vector<HSQOBJECT> m_scripts;
   std::unique_ptr<SquirrelScheduler> m_scheduler;
 
+  /** Compiled scripts by hash of source and sourcename */
+  std::unordered_multimap<size_t, CompiledScript> m_compiled_scripts;
+  int m_script_cache_hits;
+  int m_script_cache_misses;
+
 private:
   SquirrelEnvironment(const SquirrelEnvironment&) = delete;
   SquirrelEnvironment& operator=(const SquirrelEnvironment&) = delete;
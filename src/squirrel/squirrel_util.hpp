@@ -41,6 +41,10 @@ void compile_script(HSQUIRRELVM vm, std::istream& in,
 void compile_and_run(HSQUIRRELVM vm, std::istream& in,
                      const std::string& sourcename);
 
+/** Calls the closure on top of the stack with the roottable as
+    'this', the closure is popped unless the script got suspended */
+void run_compiled_script(HSQUIRRELVM vm);
+
 template<typename T>
 void expose_object(HSQUIRRELVM vm, SQInteger table_idx,
                    std::unique_ptr<T> object, const std::string& name)
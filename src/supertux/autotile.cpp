@@ -141,8 +141,49 @@ AutotileSet::AutotileSet(std::vector<Autotile*> tiles, uint32_t default_tile, st
   m_autotiles(std::move(tiles)),
   m_default(default_tile),
   m_name(std::move(name)),
-  m_corner(corner)
+  m_corner(corner),
+  m_tile_autotiles(),
+  m_mask_autotiles()
 {
+  build_lookup();
+}
+
+void
+AutotileSet::build_lookup()
+{
+  m_mask_autotiles.fill(nullptr);
+  for (int mask = 0; mask < 256; ++mask)
+  {
+    for (const bool center : { false, true })
+    {
+      const size_t index = get_mask_index(static_cast<uint8_t>(mask), center);
+      for (const auto* autotile : m_autotiles)
+      {
+        if (autotile->matches(static_cast<uint8_t>(mask), center))
+        {
+          m_mask_autotiles[index] = autotile;
+          break;
+        }
+      }
+    }
+  }
+
+  m_tile_autotiles.clear();
+  for (const auto* autotile : m_autotiles)
+  {
+    std::vector<uint32_t> tile_ids = { autotile->get_tile_id() };
+    for (const auto& pair : autotile->get_all_tile_ids())
+      tile_ids.push_back(pair.first);
+
+    for (const uint32_t tile_id : tile_ids)
+    {
+      if (tile_id >= m_tile_autotiles.size())
+        m_tile_autotiles.resize(tile_id + 1, nullptr);
+
+      if (!m_tile_autotiles[tile_id])
+        m_tile_autotiles[tile_id] = autotile;
+    }
+  }
 }
 
 /*
@@ -210,12 +251,10 @@ AutotileSet::get_autotile(uint32_t tile_id,
     if (top_left)     num_mask = static_cast<uint8_t>(num_mask + 0x80);
   }
 
-  for (auto& autotile : m_autotiles)
+  const Autotile* autotile = m_mask_autotiles[get_mask_index(num_mask, center)];
+  if (autotile)
   {
-    if (autotile->matches(num_mask, center))
-    {
-      return autotile->pick_tile(x, y);
-    }
+    return autotile->pick_tile(x, y);
   }
 
   return center ? get_default_tile() : 0;
@@ -229,26 +268,19 @@ AutotileSet::get_default_tile() const
   return m_default;
 }
 
+uint32_t
+AutotileSet::get_max_tile_id() const
+{
+  const uint32_t max_member = m_tile_autotiles.empty() ? 0 : static_cast<uint32_t>(m_tile_autotiles.size() - 1);
+  return std::max(max_member, m_default);
+}
+
 bool
 AutotileSet::is_member(uint32_t tile_id) const
 {
-  for (auto& tile : m_autotiles)
-  {
-    if (tile->get_tile_id() == tile_id)
-    {
-      return true;
-    }
-    else
-    {
-      for (auto& pair : tile->get_all_tile_ids())
-      {
-        if (pair.first == tile_id)
-        {
-          return true;
-        }
-      }
-    }
-  }
+  if (tile_id < m_tile_autotiles.size() && m_tile_autotiles[tile_id])
+    return true;
+
   // m_default should *never* be 0 (always a valid solid tile,
   //   even if said tile isn't part of the tileset)
   return tile_id == m_default && m_default != 0;
@@ -257,28 +289,8 @@ AutotileSet::is_member(uint32_t tile_id) const
 bool
 AutotileSet::is_solid(uint32_t tile_id) const
 {
-  if (!is_member(tile_id))
-    return false;
-
-  for (auto& tile : m_autotiles)
-  {
-    if (tile->get_tile_id() == tile_id)
-    {
-      return tile->is_solid();
-    }
-    else
-    {
-      for (auto& pair : tile->get_all_tile_ids())
-      {
-        if (pair.first == tile_id)
-        {
-          return tile->is_solid();
-        }
-      }
-    }
-  }
-
-  //log_warning << "Called AutotileSet::is_solid() with a tile_id that isn't in the Autotileset, yet that returns is_member() = true." << std::endl;
+  if (tile_id < m_tile_autotiles.size() && m_tile_autotiles[tile_id])
+    return m_tile_autotiles[tile_id]->is_solid();
 
   // m_default should *never* be 0 (always a valid solid tile,
   //   even if said tile isn't part of the tileset)
@@ -288,12 +300,9 @@ AutotileSet::is_solid(uint32_t tile_id) const
 uint8_t
 AutotileSet::get_mask_from_tile(uint32_t tile) const
 {
-  for (auto& autotile : m_autotiles)
-  {
-    if (autotile->is_amongst(tile)) {
-      return autotile->get_first_mask();
-    }
-  }
+  if (tile < m_tile_autotiles.size() && m_tile_autotiles[tile])
+    return m_tile_autotiles[tile]->get_first_mask();
+
   return static_cast<uint8_t>(0);
 }
 
@@ -17,6 +17,7 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_AUTOTILE_HPP
 #define HEADER_SUPERTUX_SUPERTUX_AUTOTILE_HPP
 
+#include <array>
 #include <memory>
 #include <stdint.h>
 #include <string>
@@ -122,7 +123,10 @@ public:
 
   /** true if this is a corner-based autotileset */
   bool is_corner() const { return m_corner; }
-  
+
+  /** Highest tile ID for which is_member() can be true */
+  uint32_t get_max_tile_id() const;
+
   /** Returns the first mask corresponding to the current tile
    *  (useful for corners-based autotilesets)
    */
@@ -135,12 +139,28 @@ public:
 public:
   static std::vector<AutotileSet*>* m_autotilesets;
 
+private:
+  /** Fills the lookup tables, the autotiles are searched in order so
+      that the first match wins, like a plain scan would do */
+  void build_lookup();
+
+  static size_t get_mask_index(uint8_t mask, bool center)
+  {
+    return (center ? 256 : 0) + mask;
+  }
+
 private:
   std::vector<Autotile*> m_autotiles;
   uint32_t m_default;
   std::string m_name;
   bool m_corner;
 
+  /** The autotile each tile ID belongs to, indexed by tile ID */
+  std::vector<const Autotile*> m_tile_autotiles;
+
+  /** The autotile matching each mask, see get_mask_index() */
+  std::array<const Autotile*, 512> m_mask_autotiles;
+
 private:
   AutotileSet(const AutotileSet&) = delete;
   AutotileSet& operator=(const AutotileSet&) = delete;
@@ -0,0 +1,259 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/benchmark.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdio.h>
+
+#include "supertux/game_session.hpp"
+#include "util/profiler.hpp"
+
+namespace {
+
+/** Upper bounds of the frame time histogram buckets in milliseconds,
+    steps taking longer end up in a final overflow bucket. */
+const double HISTOGRAM_BOUNDS[] = { 0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0 };
+
+struct Stats
+{
+  double total;
+  double mean;
+  double p50;
+  double p99;
+  double max;
+};
+
+/** Nearest-rank percentile, `values` must be sorted */
+double percentile(const std::vector<double>& values, double p)
+{
+  if (values.empty())
+    return 0.0;
+
+  const size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(values.size()) + 0.5);
+  return values[std::min(std::max<size_t>(rank, 1), values.size()) - 1];
+}
+
+Stats get_stats(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+
+  Stats stats;
+  stats.total = std::accumulate(values.begin(), values.end(), 0.0);
+  stats.mean = values.empty() ? 0.0 : stats.total / static_cast<double>(values.size());
+  stats.p50 = percentile(values, 50.0);
+  stats.p99 = percentile(values, 99.0);
+  stats.max = values.empty() ? 0.0 : values.back();
+  return stats;
+}
+
+std::string ms(double us)
+{
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.4f", us / 1000.0);
+  return buf;
+}
+
+std::string quote(const std::string& text)
+{
+  std::string result = "\"";
+  for (const char c : text)
+  {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      result += buf;
+    } else {
+      result += c;
+    }
+  }
+  result += '"';
+  return result;
+}
+
+void write_stats(std::ostream& out, const Stats& stats)
+{
+  out << "{ \"total_ms\": " << ms(stats.total)
+      << ", \"mean_ms\": " << ms(stats.mean)
+      << ", \"p50_ms\": " << ms(stats.p50)
+      << ", \"p99_ms\": " << ms(stats.p99)
+      << ", \"max_ms\": " << ms(stats.max) << " }";
+}
+
+} // namespace
+
+Benchmark::Zones::Zones() :
+  m_names(),
+  m_steps()
+{
+}
+
+void
+Benchmark::Zones::add(const std::string& name, size_t step, double us)
+{
+  auto it = std::find(m_names.begin(), m_names.end(), name);
+  if (it == m_names.end())
+  {
+    m_names.push_back(name);
+    m_steps.push_back(std::vector<double>());
+    it = m_names.end() - 1;
+  }
+
+  auto& zone = m_steps[it - m_names.begin()];
+  if (zone.size() <= step)
+    zone.resize(step + 1, 0.0);
+  zone[step] += us;
+}
+
+void
+Benchmark::Zones::write_json(std::ostream& out, size_t steps) const
+{
+  out << "{";
+  for (size_t zone = 0; zone < m_steps.size(); ++zone)
+  {
+    // Steps in which a zone wasn't entered count as zero
+    std::vector<double> values = m_steps[zone];
+    values.resize(steps, 0.0);
+
+    out << (zone == 0 ? "\n" : ",\n")
+        << "    " << quote(m_names[zone]) << ": ";
+    write_stats(out, get_stats(values));
+  }
+  out << (m_steps.empty() ? "}" : "\n  }");
+}
+
+Benchmark::Benchmark(const std::string& level, const std::string& demo) :
+  m_level(level),
+  m_demo(demo),
+  m_steps(),
+  m_zones(),
+  m_profiler_zones()
+{
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+void
+Benchmark::add_time(const char* zone, clock::duration duration)
+{
+  m_zones.add(zone, m_steps.size(), std::chrono::duration<double, std::micro>(duration).count());
+}
+
+void
+Benchmark::end_step(clock::duration duration)
+{
+#ifdef ENABLE_PROFILER
+  if (g_profiler.get_frame_count() != 0)
+  {
+    for (const auto& zone : g_profiler.get_frame(0).zones)
+      m_profiler_zones.add(zone.name, m_steps.size(), static_cast<double>(zone.end - zone.start) / 1000.0);
+  }
+#endif
+
+  m_steps.push_back(std::chrono::duration<double, std::micro>(duration).count());
+}
+
+bool
+Benchmark::is_finished() const
+{
+  const GameSession* session = GameSession::current();
+  return !session || session->is_demo_finished();
+}
+
+void
+Benchmark::write_json(std::ostream& out) const
+{
+  const Stats step_stats = get_stats(m_steps);
+
+  out << "{\n"
+      << "  \"level\": " << quote(m_level) << ",\n"
+      << "  \"demo\": " << quote(m_demo) << ",\n"
+      << "  \"steps\": " << m_steps.size() << ",\n"
+      << "  \"wall_time_ms\": " << ms(step_stats.total) << ",\n"
+      << "  \"step\": ";
+  write_stats(out, step_stats);
+  out << ",\n";
+
+  const size_t bucket_count = sizeof(HISTOGRAM_BOUNDS) / sizeof(HISTOGRAM_BOUNDS[0]);
+  std::vector<size_t> buckets(bucket_count + 1, 0);
+  for (const double us : m_steps)
+  {
+    const double* bound = std::lower_bound(HISTOGRAM_BOUNDS, HISTOGRAM_BOUNDS + bucket_count, us / 1000.0);
+    buckets[bound - HISTOGRAM_BOUNDS] += 1;
+  }
+
+  out << "  \"histogram\": [\n";
+  for (size_t i = 0; i < buckets.size(); ++i)
+  {
+    out << "    { \"le_ms\": ";
+    if (i < bucket_count) {
+      out << HISTOGRAM_BOUNDS[i];
+    } else {
+      out << "null";
+    }
+    out << ", \"count\": " << buckets[i] << " }" << (i + 1 < buckets.size() ? "," : "") << "\n";
+  }
+  out << "  ],\n";
+
+  out << "  \"zones\": ";
+  m_zones.write_json(out, m_steps.size());
+  out << ",\n"
+      << "  \"profiler_zones\": ";
+  m_profiler_zones.write_json(out, m_steps.size());
+  out << "\n"
+      << "}" << std::endl;
+}
+
+BenchmarkCaseResult::BenchmarkCaseResult() :
+  m_names(),
+  m_runs()
+{
+}
+
+void
+BenchmarkCaseResult::measure(const std::string& name, int runs, const std::function<void ()>& function)
+{
+  m_names.push_back(name);
+  m_runs.push_back(std::vector<double>());
+  for (int run = 0; run < runs; ++run)
+  {
+    const auto start = Benchmark::clock::now();
+    function();
+    m_runs.back().push_back(std::chrono::duration<double, std::micro>(Benchmark::clock::now() - start).count());
+  }
+}
+
+void
+BenchmarkCaseResult::write_json(std::ostream& out) const
+{
+  out << "{";
+  for (size_t i = 0; i < m_names.size(); ++i)
+  {
+    out << (i == 0 ? "\n" : ",\n")
+        << "      " << quote(m_names[i]) << ": ";
+    write_stats(out, get_stats(m_runs[i]));
+  }
+  out << (m_names.empty() ? "}" : "\n    }");
+}
+
+/* EOF */
@@ -0,0 +1,160 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+#define HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+/**
+ * Collects the timings of a headless demo playback, see the
+ * --benchmark command line option.
+ *
+ * While a Benchmark exists, the ScreenManager runs one logical step
+ * and one frame per iteration without any frame pacing. The time
+ * spent in the subsystems is collected through BenchmarkTimer, builds
+ * with ENABLE_PROFILER also report the totals of every profiler zone.
+ */
+class Benchmark final : public Currenton<Benchmark>
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+public:
+  Benchmark(const std::string& level, const std::string& demo);
+  ~Benchmark() override;
+
+  /** Adds `duration` to the time spent in `zone` during the current
+      step, see BenchmarkTimer */
+  void add_time(const char* zone, clock::duration duration);
+
+  /** Finishes a logical step that took `duration` of wall time, the
+      profiler frame of the step has to be complete already */
+  void end_step(clock::duration duration);
+
+  /** True once the demo is played back or the GameSession is gone */
+  bool is_finished() const;
+
+  void write_json(std::ostream& out) const;
+
+private:
+  /** Time spent in named zones per step in microseconds, in order of
+      first appearance */
+  class Zones final
+  {
+  public:
+    Zones();
+
+    void add(const std::string& name, size_t step, double us);
+
+    /** Writes the stats over the first `steps` steps of every zone */
+    void write_json(std::ostream& out, size_t steps) const;
+
+  private:
+    std::vector<std::string> m_names;
+    std::vector<std::vector<double> > m_steps;
+  };
+
+private:
+  const std::string m_level;
+  const std::string m_demo;
+
+  /** Durations of all finished steps in microseconds */
+  std::vector<double> m_steps;
+
+  /** Zones timed by BenchmarkTimer */
+  Zones m_zones;
+
+  /** Zones of the profiler, only filled with ENABLE_PROFILER */
+  Zones m_profiler_zones;
+
+private:
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+};
+
+/**
+ * Adds the time until it goes out of scope to `zone` of the current
+ * Benchmark. Unlike the profiler zones these are always compiled in,
+ * without a Benchmark they only cost the check for one.
+ */
+class BenchmarkTimer final
+{
+public:
+  explicit BenchmarkTimer(const char* zone) :
+    m_benchmark(Benchmark::current()),
+    m_zone(zone),
+    m_start(m_benchmark ? Benchmark::clock::now() : Benchmark::clock::time_point())
+  {
+  }
+
+  ~BenchmarkTimer()
+  {
+    if (m_benchmark)
+      m_benchmark->add_time(m_zone, Benchmark::clock::now() - m_start);
+  }
+
+private:
+  Benchmark* const m_benchmark;
+  const char* const m_zone;
+  const Benchmark::clock::time_point m_start;
+
+private:
+  BenchmarkTimer(const BenchmarkTimer&) = delete;
+  BenchmarkTimer& operator=(const BenchmarkTimer&) = delete;
+};
+
+/**
+ * Timings of a micro benchmark, see the --benchmark-case command line
+ * option and benchmark_cases.cpp. A case prepares its input and hands
+ * the code to be timed to measure().
+ */
+class BenchmarkCaseResult final
+{
+public:
+  BenchmarkCaseResult();
+
+  /** Runs `function` `runs` times and reports the durations of the
+      runs as `name` */
+  void measure(const std::string& name, int runs, const std::function<void ()>& function);
+
+  void write_json(std::ostream& out) const;
+
+private:
+  std::vector<std::string> m_names;
+
+  /** Durations of the runs in microseconds */
+  std::vector<std::vector<double> > m_runs;
+
+private:
+  BenchmarkCaseResult(const BenchmarkCaseResult&) = delete;
+  BenchmarkCaseResult& operator=(const BenchmarkCaseResult&) = delete;
+};
+
+/** Runs the micro benchmark `name`, or every one for "all", and
+    prints the timings as JSON. Throws if there is no such case. */
+void run_benchmark_cases(const std::string& name, std::ostream& out);
+
+#endif
+
+/* EOF */
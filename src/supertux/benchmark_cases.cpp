@@ -0,0 +1,708 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include <sexp/value.hpp>
+
+#include "collision/collision.hpp"
+#include "collision/collision_hit.hpp"
+#include "collision/collision_listener.hpp"
+#include "collision/collision_object.hpp"
+#include "collision/collision_spatial_grid.hpp"
+#include "collision/collision_system.hpp"
+#include "editor/editor.hpp"
+#include "editor/undo_delta.hpp"
+#include "object/custom_particle_system.hpp"
+#include "object/particle_zone_index.hpp"
+#include "object/particlesystem_interactive.hpp"
+#include "object/rain_particle_system.hpp"
+#include "object/tilemap.hpp"
+#include "squirrel/squirrel_environment.hpp"
+#include "squirrel/squirrel_vm.hpp"
+#include "supertux/game_object.hpp"
+#include "supertux/level.hpp"
+#include "supertux/level_header.hpp"
+#include "supertux/level_parser.hpp"
+#include "supertux/levelset.hpp"
+#include "supertux/sector.hpp"
+#include "supertux/tile.hpp"
+#include "supertux/tile_manager.hpp"
+#include "supertux/tile_set.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "video/drawing_request.hpp"
+#include "video/null/null_texture.hpp"
+#include "video/request_sorter.hpp"
+
+namespace {
+
+/** An object that collides with everything and ignores the hits. The
+    collision system passes the listeners on as GameObjects. */
+class BenchmarkCollisionObject final : public GameObject,
+                                       public CollisionListener
+{
+public:
+  BenchmarkCollisionObject(CollisionGroup group, const Rectf& bbox) :
+    m_col(group, *this)
+  {
+    m_col.m_bbox = bbox;
+  }
+
+  void update(float) override {}
+  void draw(DrawingContext&) override {}
+
+  void collision_solid(const CollisionHit&) override {}
+  bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  HitResponse collision(GameObject&, const CollisionHit&) override { return CONTINUE; }
+  void collision_tile(uint32_t) override {}
+  bool listener_is_valid() const override { return true; }
+
+public:
+  CollisionObject m_col;
+
+private:
+  BenchmarkCollisionObject(const BenchmarkCollisionObject&) = delete;
+  BenchmarkCollisionObject& operator=(const BenchmarkCollisionObject&) = delete;
+};
+
+/** All levels shipped in data/levels */
+std::vector<std::string>
+get_level_filenames()
+{
+  const Levelset levelset("levels", true);
+  std::vector<std::string> filenames;
+  for (int i = 0; i < levelset.get_num_levels(); ++i)
+    filenames.push_back(FileSystem::join("levels", levelset.get_level_filename(i)));
+  return filenames;
+}
+
+/** Reads the names of all shipped levels with the header reader, as
+    the level index does, and by parsing the whole documents */
+void
+benchmark_level_header(BenchmarkCaseResult& result)
+{
+  const std::vector<std::string> filenames = get_level_filenames();
+
+  result.measure("header_" + std::to_string(filenames.size()) + "_levels", 5,
+                 [&filenames]
+  {
+    for (const auto& filename : filenames)
+      LevelHeader::from_file(filename);
+  });
+
+  result.measure("document_" + std::to_string(filenames.size()) + "_levels", 5,
+                 [&filenames]
+  {
+    for (const auto& filename : filenames)
+    {
+      auto doc = ReaderDocument::from_file(filename);
+      std::string name;
+      doc.get_root().get_mapping().get("name", name);
+    }
+  });
+}
+
+/** A mapping of a level together with the keys an object constructor
+    would look up: the (key value) pairs present and a few missing ones */
+struct ReaderBenchmarkMapping
+{
+  const sexp::Value* sx;
+  std::vector<std::string> keys;
+};
+
+/** Collects all mappings of a level, that is every list whose items
+    are all lists starting with a symbol */
+void
+collect_mappings(const sexp::Value& sx, std::vector<ReaderBenchmarkMapping>& mappings)
+{
+  if (!sx.is_array() || sx.as_array().empty())
+    return;
+
+  const auto& arr = sx.as_array();
+  bool is_mapping = arr[0].is_symbol() && arr.size() > 1;
+  for (size_t i = 1; i < arr.size(); ++i)
+  {
+    const auto& item = arr[i];
+    if (!item.is_array() || item.as_array().empty() || !item.as_array()[0].is_symbol())
+      is_mapping = false;
+    collect_mappings(item, mappings);
+  }
+
+  if (!is_mapping)
+    return;
+
+  ReaderBenchmarkMapping mapping{ &sx, {} };
+  for (size_t i = 1; i < arr.size(); ++i)
+  {
+    if (arr[i].as_array().size() == 2)
+      mapping.keys.push_back(arr[i].as_array()[0].as_string());
+  }
+  for (const char* key : { "missing-a", "missing-b", "missing-c", "missing-d", "missing-e", "missing-f" })
+    mapping.keys.push_back(key);
+
+  mappings.push_back(std::move(mapping));
+}
+
+/** Parses all shipped levels and looks up the keys of all of their
+    mappings through ReaderMapping */
+void
+benchmark_reader(BenchmarkCaseResult& result)
+{
+  const std::vector<std::string> filenames = get_level_filenames();
+
+  result.measure("parse_" + std::to_string(filenames.size()) + "_levels", 5,
+                 [&filenames]
+  {
+    for (const auto& filename : filenames)
+      ReaderDocument::from_file(filename);
+  });
+
+  std::vector<ReaderDocument> docs;
+  std::vector<std::vector<ReaderBenchmarkMapping> > mappings;
+  size_t lookups = 0;
+  for (const auto& filename : filenames)
+  {
+    docs.push_back(ReaderDocument::from_file(filename));
+    mappings.push_back(std::vector<ReaderBenchmarkMapping>());
+  }
+  for (size_t i = 0; i < docs.size(); ++i)
+  {
+    collect_mappings(docs[i].get_sexp(), mappings[i]);
+    for (const auto& mapping : mappings[i])
+      lookups += mapping.keys.size();
+  }
+
+  result.measure("lookup_" + std::to_string(lookups) + "_keys", 5,
+                 [&docs, &mappings]
+  {
+    for (size_t i = 0; i < docs.size(); ++i)
+    {
+      for (const auto& mapping : mappings[i])
+      {
+        ReaderMapping reader_mapping(docs[i], *mapping.sx);
+        sexp::Value value;
+        for (const auto& key : mapping.keys)
+          reader_mapping.get(key.c_str(), value);
+      }
+    }
+  });
+}
+
+/** Paints a random blob with the default tile of the first autotileset
+    of the level tileset and autotiles it cell by cell, like painting in
+    the editor does */
+void
+benchmark_autotile(BenchmarkCaseResult& result)
+{
+  const TileSet* tileset = TileManager::current()->get_tileset("images/tiles.strf");
+  const AutotileSet* autotileset = nullptr;
+  for (const auto* set : *tileset->m_autotilesets)
+  {
+    if (!set->is_corner())
+    {
+      autotileset = set;
+      break;
+    }
+  }
+  if (!autotileset)
+  {
+    log_warning << "No autotileset to benchmark" << std::endl;
+    return;
+  }
+  const uint32_t tile = autotileset->get_default_tile();
+
+  for (const int size : { 64, 256 })
+  {
+    std::mt19937 rng(42);
+    std::bernoulli_distribution paint(0.8);
+    std::vector<bool> blob(size * size);
+    for (size_t i = 0; i < blob.size(); ++i)
+      blob[i] = paint(rng);
+
+    TileMap tilemap(tileset);
+    tilemap.resize(size, size);
+    result.measure("autotile_" + std::to_string(size) + "x" + std::to_string(size), 5,
+                   [&tilemap, &blob, size, tile]
+    {
+      for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+          tilemap.change(x, y, blob[y * size + x] ? tile : 0);
+
+      for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+          tilemap.autotile(x, y, tile);
+    });
+  }
+}
+
+/** One frame of the collision broad-phase: every object moves a bit,
+    gets rebinned and looks up the objects it might touch. The pairwise
+    test of all objects is the baseline, CollisionSystem::update() the
+    whole frame of collision detection and response. */
+void
+benchmark_collision_grid(BenchmarkCaseResult& result)
+{
+  for (const int count : { 100, 1000, 5000 })
+  {
+    // Roughly the density of a large level: 200x30 tiles per 100 objects
+    const float world_size = 32.0f * std::sqrt(static_cast<float>(count) * 60.0f);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-world_size / 2.0f, world_size / 2.0f);
+    std::uniform_real_distribution<float> size(8.0f, 96.0f);
+    std::uniform_real_distribution<float> step(-8.0f, 8.0f);
+    std::uniform_int_distribution<int> group(0, 9);
+
+    std::vector<std::unique_ptr<BenchmarkCollisionObject> > owners;
+    std::vector<CollisionObject*> objects;
+    std::vector<Vector> movements;
+    for (int i = 0; i < count; ++i)
+    {
+      // Every tenth object is static, like platforms and blocks
+      const bool is_static = group(rng) == 0;
+      const float x = pos(rng);
+      const float y = pos(rng);
+      const float width = size(rng);
+      const float height = size(rng);
+      owners.push_back(std::make_unique<BenchmarkCollisionObject>(is_static ? COLGROUP_STATIC : COLGROUP_MOVING,
+                                                                  Rectf(Vector(x, y), Sizef(width, height))));
+      objects.push_back(&owners.back()->m_col);
+      const float step_x = step(rng);
+      const float step_y = step(rng);
+      movements.push_back(is_static ? Vector(0.0f, 0.0f) : Vector(step_x, step_y));
+    }
+    std::vector<Rectf> bboxes;
+    for (const auto* object : objects)
+      bboxes.push_back(object->get_bbox());
+
+    const auto reset = [&objects, &bboxes]
+    {
+      for (size_t i = 0; i < objects.size(); ++i)
+        objects[i]->m_bbox = bboxes[i];
+    };
+
+    int pairs = 0;
+    result.measure("pairwise_" + std::to_string(count), count > 1000 ? 10 : 100,
+                   [&objects, &movements, &pairs]
+    {
+      for (size_t i = 0; i < objects.size(); ++i)
+        objects[i]->m_bbox.move(movements[i]);
+
+      for (auto i = objects.begin(); i != objects.end(); ++i)
+      {
+        for (auto i2 = i + 1; i2 != objects.end(); ++i2)
+        {
+          if (collision::intersects((*i)->get_bbox(), (*i2)->get_bbox()))
+            pairs += 1;
+        }
+      }
+    });
+    log_debug << count << " objects: " << pairs << " overlapping pairs" << std::endl;
+    reset();
+
+    CollisionSpatialGrid grid;
+    for (auto* object : objects)
+      grid.insert(*object, object->get_bbox());
+
+    std::vector<CollisionObject*> candidates;
+    pairs = 0;
+    result.measure("collision_grid_" + std::to_string(count), 100,
+                   [&grid, &objects, &movements, &candidates, &pairs]
+    {
+      for (size_t i = 0; i < objects.size(); ++i)
+      {
+        objects[i]->m_bbox.move(movements[i]);
+        grid.update(*objects[i], objects[i]->get_bbox());
+      }
+
+      for (const auto* object : objects)
+      {
+        candidates.clear();
+        grid.query(object->get_bbox(), candidates);
+        auto other = std::find(candidates.begin(), candidates.end(), object);
+        for (++other; other != candidates.end(); ++other)
+        {
+          if (collision::intersects(object->get_bbox(), (*other)->get_bbox()))
+            pairs += 1;
+        }
+      }
+    });
+    log_debug << count << " objects: " << pairs << " overlapping pairs in the grid" << std::endl;
+    reset();
+
+    // An empty sector, the objects only collide with each other
+    Level level(false);
+    Sector sector(level);
+    CollisionSystem collision_system(sector);
+    for (auto* object : objects)
+      collision_system.add(object);
+
+    result.measure("collision_update_" + std::to_string(count), 100,
+                   [&collision_system, &objects, &movements]
+    {
+      for (size_t i = 0; i < objects.size(); ++i)
+        objects[i]->set_movement(movements[i]);
+      collision_system.update();
+    });
+
+    for (auto* object : objects)
+      collision_system.remove(object);
+    collision_system.flush_removals();
+  }
+}
+
+/** Brings a frame worth of texture requests into drawing order. The
+    requests are spread over the layers the game uses and a handful of
+    textures. */
+void
+benchmark_request_sorter(BenchmarkCaseResult& result)
+{
+  std::vector<std::unique_ptr<Texture> > textures;
+  for (int i = 0; i < 16; ++i)
+    textures.push_back(std::make_unique<NullTexture>(Size(32, 32)));
+  const int layers[] = { -300, -200, -100, 0, 50, 50, 50, 51, 150, 200, 300, 500 };
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> layer(0, sizeof(layers) / sizeof(layers[0]) - 1);
+  std::uniform_int_distribution<int> offset(-2, 2);
+  std::uniform_int_distribution<int> texture(0, 15);
+  std::uniform_real_distribution<float> pos(0.0f, 1280.0f);
+
+  for (const size_t count : { 5000, 20000, 100000 })
+  {
+    std::vector<std::unique_ptr<TextureRequest> > storage;
+    std::vector<DrawingRequest*> original;
+    for (size_t i = 0; i < count; ++i)
+    {
+      storage.push_back(std::make_unique<TextureRequest>());
+      TextureRequest& request = *storage.back();
+      request.layer = layers[layer(rng)] + offset(rng);
+      request.texture = textures[texture(rng)].get();
+      request.srcrects.set(Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+      request.dstrects.set(Rectf(Vector(pos(rng), pos(rng)), Sizef(32.0f, 32.0f)));
+      request.angles.set(0.0f);
+      request.repeats.set(Size(1, 1));
+      original.push_back(&request);
+    }
+
+    RequestSorter sorter;
+    std::vector<DrawingRequest*> requests;
+    result.measure("sort_by_layer_" + std::to_string(count), 20,
+                   [&sorter, &original, &requests]
+    {
+      requests = original;
+      sorter.sort_by_layer(requests);
+    });
+
+    result.measure("sort_" + std::to_string(count), 20,
+                   [&sorter, &original, &requests]
+    {
+      requests = original;
+      sorter.sort(requests);
+    });
+  }
+}
+
+/** Runs the collect-script of 1000 coins, compiled for every run like
+    std::istream scripts are and through the script cache */
+void
+benchmark_squirrel_scripts(BenchmarkCaseResult& result)
+{
+  // Roughly what a coin's collect-script does
+  const char* script =
+    "counter += 1;\n"
+    "if (counter % 100 == 0) {\n"
+    "  local message = \"collected \" + counter + \" coins\";\n"
+    "}\n";
+
+  SquirrelVM vm;
+  SquirrelEnvironment env(vm, "benchmark");
+  env.expose_self();
+  env.run_script("counter <- 0;", "init");
+
+  result.measure("compiled_1000_coins", 10, [&env, script]
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      std::istringstream in(script);
+      env.run_script(in, "coin");
+    }
+  });
+
+  result.measure("cached_1000_coins", 10, [&env, script]
+  {
+    for (int i = 0; i < 1000; ++i)
+      env.run_script(script, "coin");
+  });
+}
+
+/** Loads a level of one 400x40 tile sector with solid ground at the
+    bottom and a few floating tiles, `objects` is the S-expression of
+    further objects of the sector. The sector is activated with the
+    camera at the start, as the particle systems look at the current
+    sector. */
+std::unique_ptr<Level>
+create_particle_level(const std::string& objects)
+{
+  const TileSet* tileset = TileManager::current()->get_tileset("images/tiles.strf");
+  uint32_t solid_tile = 0;
+  for (uint32_t id = 1; id < tileset->get_max_tileid() && solid_tile == 0; ++id)
+  {
+    if (tileset->get(id).get_attributes() & Tile::SOLID)
+      solid_tile = id;
+  }
+
+  const int width = 400;
+  const int height = 40;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 99);
+
+  std::ostringstream out;
+  out << "(supertux-level (version 3) (name \"benchmark\") (tileset \"images/tiles.strf\")\n"
+      << "  (sector (name \"main\")\n"
+      << "    (tilemap (solid #t) (width " << width << ") (height " << height << ") (tiles";
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x)
+      out << ' ' << ((y >= height - 3 || dist(rng) < 3) ? solid_tile : 0);
+  out << "))\n"
+      << "    " << objects << "))\n";
+
+  std::istringstream in(out.str());
+  auto level = LevelParser::from_stream(in, "benchmark", false, false);
+  level->get_sector("main")->activate(Vector(320.0f, 1000.0f));
+  return level;
+}
+
+/** One frame of rain with its collision tests against the tiles, with
+    the tile mask and testing the tiles directly */
+void
+benchmark_tile_collision_mask(BenchmarkCaseResult& result)
+{
+  for (const int intensity : { 1, 5 })
+  {
+    for (const bool use_mask : { true, false })
+    {
+      auto level = create_particle_level("(particles-rain (intensity " + std::to_string(intensity) + "))");
+      RainParticleSystem* rain = nullptr;
+      for (auto& object : level->get_sector("main")->get_objects_by_type<RainParticleSystem>())
+        rain = &object;
+
+      ParticleSystem_Interactive::s_use_tile_mask = use_mask;
+      result.measure("rain_" + std::to_string(intensity) + (use_mask ? "_mask" : "_tiles"), 100,
+                     [rain]
+      {
+        rain->update(1.0f / 60.0f);
+      });
+      ParticleSystem_Interactive::s_use_tile_mask = true;
+    }
+  }
+}
+
+/** One frame of custom particles in a level with particle zones, the
+    zones looked up through the grid of ParticleZoneIndex and by testing
+    every zone */
+void
+benchmark_particle_zones(BenchmarkCaseResult& result)
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> pos_x(0.0f, 2400.0f);
+  std::uniform_real_distribution<float> pos_y(0.0f, 1280.0f);
+  std::uniform_real_distribution<float> size(64.0f, 640.0f);
+
+  // Mostly life zones, a particle dies after leaving them
+  std::ostringstream zones;
+  const char* types[] = { "life", "life", "life", "life-clear", "killer", "destroyer", "spawn" };
+  for (int i = 0; i < 32; ++i)
+  {
+    const float x = pos_x(rng);
+    const float y = pos_y(rng);
+    const float width = size(rng);
+    const float height = size(rng);
+    zones << "(particle-zone (particle-name \"benchmark\") (zone-type \"" << types[i % 7] << "\")"
+          << " (x " << x << ") (y " << y << ") (width " << width << ") (height " << height << "))\n";
+  }
+
+  for (const int count : { 250, 1000, 4000 })
+  {
+    for (const bool use_grid : { true, false })
+    {
+      // Long-living particles that fall to the ground and stay there,
+      // all spawned in the first frame
+      const std::string particles =
+        "(particles-custom (name \"benchmark\") (amount " + std::to_string(count) + ")"
+        " (delay 0) (lifetime 1000) (speed-y 200) (speed-var-x 100) (speed-var-y 100)"
+        " (collision-mode \"stick\") (offscreen-mode \"never\"))";
+      auto level = create_particle_level(particles + "\n" + zones.str());
+      CustomParticleSystem* system = nullptr;
+      for (auto& object : level->get_sector("main")->get_objects_by_type<CustomParticleSystem>())
+        system = &object;
+
+      ParticleZoneIndex::s_use_grid = use_grid;
+      result.measure("custom_" + std::to_string(count) + (use_grid ? "_grid" : "_scan"), 100,
+                     [system]
+      {
+        system->update(1.0f / 60.0f);
+      });
+      ParticleZoneIndex::s_use_grid = true;
+    }
+  }
+}
+
+/** One 4x4 brush stroke on every shipped level, recorded in the editor
+    undo history by saving the whole level, as snapshot mode does, and
+    by UndoDelta::record() */
+void
+benchmark_undo_history(BenchmarkCaseResult& result)
+{
+  struct Stroke
+  {
+    TileMap* tilemap;
+    uint32_t tile;
+  };
+
+  Editor::s_resaving_in_progress = true;
+
+  std::vector<std::unique_ptr<Level> > levels;
+  std::vector<Stroke> strokes;
+  for (const auto& filename : get_level_filenames())
+  {
+    auto level = LevelParser::from_file(filename, false, true);
+
+    // Paint with a tile of the first tilemap that has one
+    Stroke stroke{ nullptr, 0 };
+    for (const auto& sector : level->m_sectors)
+    {
+      for (auto& tilemap : sector->get_objects_by_type<TileMap>())
+      {
+        if (stroke.tilemap || tilemap.get_width() < 4 || tilemap.get_height() < 4)
+          continue;
+        for (const uint32_t tile : tilemap.get_tiles())
+        {
+          if (tile != 0) {
+            stroke = { &tilemap, tile };
+            break;
+          }
+        }
+      }
+    }
+
+    if (stroke.tilemap)
+    {
+      strokes.push_back(stroke);
+      levels.push_back(std::move(level));
+    }
+  }
+
+  // Alternates between painting and erasing, so that every run changes
+  int run = 0;
+  auto paint = [&strokes, &run]
+  {
+    run += 1;
+    for (const auto& stroke : strokes)
+      for (int y = 0; y < 4; ++y)
+        for (int x = 0; x < 4; ++x)
+          stroke.tilemap->change(x, y, run % 2 ? stroke.tile : 0);
+  };
+
+  const std::string suffix = "_" + std::to_string(levels.size()) + "_levels";
+
+  result.measure("snapshot" + suffix, 5, [&levels, &paint]
+  {
+    paint();
+    for (const auto& level : levels)
+    {
+      std::ostringstream out;
+      level->save(out);
+    }
+  });
+
+  std::vector<std::unique_ptr<LevelSnapshot> > states;
+  for (const auto& level : levels)
+    states.push_back(LevelSnapshot::from_level(*level));
+
+  result.measure("delta" + suffix, 5, [&levels, &states, &paint]
+  {
+    paint();
+    for (size_t i = 0; i < levels.size(); ++i)
+      UndoDelta::record(*states[i], *levels[i]);
+  });
+
+  Editor::s_resaving_in_progress = false;
+}
+
+struct BenchmarkCase
+{
+  const char* name;
+  void (*run)(BenchmarkCaseResult& result);
+};
+
+/** All cases in the order "all" runs them */
+const std::vector<BenchmarkCase> s_cases = {
+  { "autotile", &benchmark_autotile },
+  { "collision_grid", &benchmark_collision_grid },
+  { "level_header", &benchmark_level_header },
+  { "particle_zones", &benchmark_particle_zones },
+  { "reader", &benchmark_reader },
+  { "request_sorter", &benchmark_request_sorter },
+  { "squirrel_scripts", &benchmark_squirrel_scripts },
+  { "tile_collision_mask", &benchmark_tile_collision_mask },
+  { "undo_history", &benchmark_undo_history },
+};
+
+} // namespace
+
+void
+run_benchmark_cases(const std::string& name, std::ostream& out)
+{
+  std::vector<const BenchmarkCase*> cases;
+  for (const auto& benchmark_case : s_cases)
+  {
+    if (name == "all" || name == benchmark_case.name)
+      cases.push_back(&benchmark_case);
+  }
+
+  if (cases.empty())
+  {
+    std::string names;
+    for (const auto& benchmark_case : s_cases)
+      names += std::string(" ") + benchmark_case.name;
+    throw std::runtime_error("Unknown benchmark case '" + name + "', available: all" + names);
+  }
+
+  out << "{\n"
+      << "  \"cases\": {";
+  for (size_t i = 0; i < cases.size(); ++i)
+  {
+    BenchmarkCaseResult result;
+    cases[i]->run(result);
+
+    out << (i == 0 ? "\n" : ",\n")
+        << "    \"" << cases[i]->name << "\": ";
+    result.write_json(out);
+  }
+  out << "\n  }\n"
+      << "}" << std::endl;
+}
+
+/* EOF */
@@ -52,7 +52,10 @@ CommandLineArguments::CommandLineArguments() :
   christmas_mode(),
   repository_url(),
   editor(),
-  resave()
+  resave(),
+  compile(),
+  benchmark(),
+  benchmark_case()
 {
 }
 
@@ -115,6 +118,7 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Game Options:") << "\n"
     << _("  --edit-level                 Open given level in editor") << "\n"
     << _("  --resave                     Loads given level and saves it") << "\n"
+    << _("  --compile                    Loads given level and writes its compiled form") << "\n"
     << _("  --show-fps                   Display framerate in levels") << "\n"
     << _("  --no-show-fps                Do not display framerate in levels") << "\n"
     << _("  --show-pos                   Display player's current position") << "\n"
@@ -128,6 +132,11 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Demo Recording Options:") << "\n"
     << _("  --record-demo FILE LEVEL     Record a demo to FILE") << "\n"
     << _("  --play-demo FILE LEVEL       Play a recorded demo") << "\n"
+    << _("  --demo FILE                  Same as --play-demo FILE") << "\n"
+    << _("  --benchmark LEVEL            Play the given demo in LEVEL as fast as possible") << "\n"
+    << _("                               without video or audio and print timings as JSON") << "\n"
+    << _("  --benchmark-case NAME        Run the micro benchmark NAME, or all of them for") << "\n"
+    << _("                               'all', and print timings as JSON") << "\n"
     << "\n"
     << _("Directory Options:") << "\n"
     << _("  --datadir DIR                Set the directory for the games datafiles") << "\n"
@@ -324,7 +333,7 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       music_enabled = false;
     }
-    else if (arg == "--play-demo")
+    else if (arg == "--play-demo" || arg == "--demo")
     {
       if (i + 1 >= argc)
       {
@@ -400,6 +409,33 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       resave = true;
     }
+    else if (arg == "--compile")
+    {
+      compile = true;
+    }
+    else if (arg == "--benchmark")
+    {
+      if (++i >= argc)
+      {
+        throw std::runtime_error("--benchmark LEVEL needs an argument");
+      }
+      else
+      {
+        benchmark = true;
+        filenames.push_back(argv[i]);
+      }
+    }
+    else if (arg == "--benchmark-case")
+    {
+      if (++i >= argc)
+      {
+        throw std::runtime_error("--benchmark-case NAME needs an argument");
+      }
+      else
+      {
+        benchmark_case = std::string(argv[i]);
+      }
+    }
     else if (arg[0] != '-')
     {
       filenames.push_back(arg);
@@ -411,9 +447,13 @@ CommandLineArguments::parse_args(int argc, char** argv)
   }
 
   // some final checks
-  if (filenames.size() > 1 && !(resave && *resave)) {
+  if (filenames.size() > 1 && !(resave && *resave) && !(compile && *compile)) {
     throw std::runtime_error("Only one filename allowed for the given options");
   }
+
+  if (benchmark && *benchmark && !start_demo) {
+    throw std::runtime_error("--benchmark needs a demo, use --demo FILE");
+  }
 }
 
 void
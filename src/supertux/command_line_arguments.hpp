@@ -81,6 +81,9 @@ public:
 
   boost::optional<bool> editor;
   boost::optional<bool> resave;
+  boost::optional<bool> compile;
+  boost::optional<bool> benchmark;
+  boost::optional<std::string> benchmark_case;
 
   // boost::optional<std::string> locale;
 
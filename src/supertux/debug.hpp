@@ -35,6 +35,12 @@ public:
   /** Draw the path on the worldmap, including invisible paths */
   bool show_worldmap_path;
 
+  /** Show the per-frame counters of the drawing code */
+  bool show_render_stats;
+
+  /** Show the zones of the frame profiler, see util/profiler.hpp */
+  bool show_profiler;
+
   // Draw frames even when visually nothing changes; this can be used to
   // vaguely measure the impact of code changes which should increase the FPS
   bool draw_redundant_frames;
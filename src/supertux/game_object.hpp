@@ -30,6 +30,7 @@ class DrawingContext;
 class GameObjectComponent;
 class ObjectRemoveListener;
 class ReaderMapping;
+class Rectf;
 class Writer;
 
 /**
@@ -72,6 +73,12 @@ public:
       DrawingContext if this function is called. */
   virtual void draw(DrawingContext& context) = 0;
 
+  /** Returns false if draw() would not paint anything inside of
+      `view`, which allows skipping it. Objects that don't know where
+      they draw (backgrounds, particle systems, gradients, ...) keep
+      the default and are always drawn. */
+  virtual bool is_in_view(const Rectf& view) const { return true; }
+
   /** This function saves the object. Editor will use that. */
   virtual void save(Writer& writer);
   virtual std::string get_class() const { return "game-object"; }
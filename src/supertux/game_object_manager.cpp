@@ -20,6 +20,9 @@
 #include <algorithm>
 
 #include "object/tilemap.hpp"
+#include "util/profiler.hpp"
+#include "video/drawing_context.hpp"
+#include "video/render_stats.hpp"
 
 bool GameObjectManager::s_draw_solids_only = false;
 
@@ -31,7 +34,8 @@ GameObjectManager::GameObjectManager() :
   m_objects_by_name(),
   m_objects_by_uid(),
   m_objects_by_type_index(),
-  m_name_resolve_requests()
+  m_name_resolve_requests(),
+  m_object_list_version(0)
 {
 }
 
@@ -99,6 +103,30 @@ GameObjectManager::get_objects() const
   return m_gameobjects;
 }
 
+void
+GameObjectManager::move_object_before(const GameObject& object, const GameObject* before)
+{
+  auto find = [this](const GameObject* obj) {
+    return std::find_if(m_gameobjects.begin(), m_gameobjects.end(),
+                        [obj](const std::unique_ptr<GameObject>& other) {
+                          return other.get() == obj;
+                        });
+  };
+
+  auto it = find(&object);
+  assert(it != m_gameobjects.end());
+
+  auto dest = before ? find(before) : m_gameobjects.end();
+  assert(!before || dest != m_gameobjects.end());
+
+  if (it < dest) {
+    std::rotate(it, it + 1, dest);
+  } else if (dest < it) {
+    std::rotate(dest, it, it + 1);
+  }
+  m_object_list_version += 1;
+}
+
 GameObject&
 GameObjectManager::add_object(std::unique_ptr<GameObject> object)
 {
@@ -131,6 +159,8 @@ GameObjectManager::clear_objects()
     before_object_remove(*obj);
   }
   m_gameobjects.clear();
+  m_object_list_version += 1;
+  after_objects_removed();
 }
 
 void
@@ -148,6 +178,11 @@ GameObjectManager::update(float dt_sec)
 void
 GameObjectManager::draw(DrawingContext& context)
 {
+  PROFILE_ZONE("GameObjectManager::draw");
+
+  // Everything outside of this can't end up on the screen
+  const Rectf view = context.get_cliprect();
+
   for (const auto& object : m_gameobjects)
   {
     if (!object->is_valid())
@@ -160,6 +195,13 @@ GameObjectManager::draw(DrawingContext& context)
         continue;
     }
 
+    if (!object->is_in_view(view))
+    {
+      g_render_stats.frame.culled_objects += 1;
+      continue;
+    }
+
+    g_render_stats.frame.drawn_objects += 1;
     object->draw(context);
   }
 }
@@ -181,6 +223,7 @@ GameObjectManager::flush_game_objects()
                        }
                      }),
       m_gameobjects.end());
+    after_objects_removed();
   }
 
   { // add newly created objects
@@ -225,6 +268,8 @@ GameObjectManager::update_solid(TileMap* tm) {
 void
 GameObjectManager::this_before_object_add(GameObject& object)
 {
+  m_object_list_version += 1;
+
   { // by_name
     if (!object.get_name().empty())
     {
@@ -246,6 +291,8 @@ GameObjectManager::this_before_object_add(GameObject& object)
 void
 GameObjectManager::this_before_object_remove(GameObject& object)
 {
+  m_object_list_version += 1;
+
   { // by_name
     const std::string& name = object.get_name();
     if (!name.empty())
@@ -18,6 +18,7 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_GAME_OBJECT_MANAGER_HPP
 #define HEADER_SUPERTUX_SUPERTUX_GAME_OBJECT_MANAGER_HPP
 
+#include <stdint.h>
 #include <functional>
 #include <iostream>
 #include <typeindex>
@@ -66,9 +67,18 @@ public:
 
   const std::vector<std::unique_ptr<GameObject> >& get_objects() const;
 
+  /** Moves `object` in front of `before` in the object list, which is
+      the order objects are updated, drawn and saved in. Both objects
+      have to be flushed already. */
+  void move_object_before(const GameObject& object, const GameObject* before);
+
   /** Commit the queued up additions and deletions to the object list */
   void flush_game_objects();
 
+  /** Changes whenever objects are added to, removed from or moved
+      within the object list */
+  uint64_t get_object_list_version() const { return m_object_list_version; }
+
   float get_width() const;
   float get_height() const;
 
@@ -84,6 +94,9 @@ public:
   /** Hook that is called before an object is removed from the vector */
   virtual void before_object_remove(GameObject& object) = 0;
 
+  /** Hook that is called once after a batch of objects got removed */
+  virtual void after_objects_removed() {}
+
   template<class T>
   GameObjectRange<T> get_objects_by_type() const
   {
@@ -220,6 +233,8 @@ private:
 
   std::vector<NameResolveRequest> m_name_resolve_requests;
 
+  uint64_t m_object_list_version;
+
 private:
   GameObjectManager(const GameObjectManager&) = delete;
   GameObjectManager& operator=(const GameObjectManager&) = delete;
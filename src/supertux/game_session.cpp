@@ -31,6 +31,7 @@
 #include "object/music_object.hpp"
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/fadetoblack.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
@@ -42,6 +43,7 @@
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
@@ -326,6 +328,9 @@ GameSession::leave()
 void
 GameSession::update(float dt_sec, const Controller& controller)
 {
+  PROFILE_ZONE("GameSession::update");
+  BenchmarkTimer benchmark_timer("GameSession::update");
+
   // Set active flag
   if (!m_active)
   {
@@ -32,6 +32,7 @@ GameSessionRecorder::GameSessionRecorder() :
   m_capture_demo_stream(),
   m_playback_demo_stream(),
   m_demo_controller(),
+  m_demo_finished(false),
   m_playing(false)
 {
 }
@@ -103,6 +104,7 @@ GameSessionRecorder::play_demo(const std::string& filename)
 
   m_playback_demo_stream.reset();
   m_demo_controller.reset();
+  m_demo_finished = false;
 
   m_playback_demo_stream.reset(new std::ifstream(filename.c_str()));
   if (!m_playback_demo_stream->good()) {
@@ -145,7 +147,7 @@ GameSessionRecorder::process_events()
   {
     m_demo_controller->update();
 
-    char left, right, up, down, jump, action;
+    char left = 0, right = 0, up = 0, down = 0, jump = 0, action = 0;
 
     m_playback_demo_stream->get(left);
     m_playback_demo_stream->get(right);
@@ -154,6 +156,12 @@ GameSessionRecorder::process_events()
     m_playback_demo_stream->get(jump);
     m_playback_demo_stream->get(action);
 
+    if (!*m_playback_demo_stream) {
+      // end of the demo, let go of all buttons
+      left = right = up = down = jump = action = 0;
+      m_demo_finished = true;
+    }
+
     m_demo_controller->press(Control::LEFT, left != 0);
     m_demo_controller->press(Control::RIGHT, right != 0);
     m_demo_controller->press(Control::UP, up != 0);
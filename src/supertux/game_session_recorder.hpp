@@ -40,6 +40,9 @@ public:
 
   bool is_playing_demo() const { return m_playing; }
 
+  /** True once all recorded input of the played back demo is used up */
+  bool is_demo_finished() const { return m_demo_finished; }
+
 private:
   void capture_demo_step();
 
@@ -48,6 +51,7 @@ private:
   std::unique_ptr<std::ostream> m_capture_demo_stream;
   std::unique_ptr<std::istream> m_playback_demo_stream;
   std::unique_ptr<CodeController> m_demo_controller;
+  bool m_demo_finished;
   bool m_playing;
 
 private:
@@ -48,6 +48,8 @@ Config::Config() :
 #endif
   video(VideoSystem::VIDEO_AUTO),
   try_vsync(true),
+  texture_atlas(true),
+  async_image_loading(true),
   show_fps(false),
   show_player_pos(false),
   show_controller(false),
@@ -85,6 +87,8 @@ Config::Config() :
   editor_autotile_mode(false),
   editor_autotile_help(true),
   editor_autosave_frequency(5),
+  editor_undo_deltas(true),
+  editor_undo_memory(64),
   repository_url()
 {
 }
@@ -140,6 +144,8 @@ Config::load()
     editor_mapping->get("render_lighting", editor_render_lighting);
     editor_mapping->get("selected_snap_grid_size", editor_selected_snap_grid_size);
     editor_mapping->get("snap_to_grid", editor_snap_to_grid);
+    editor_mapping->get("undo_deltas", editor_undo_deltas);
+    editor_mapping->get("undo_memory", editor_undo_memory);
   } else { log_warning << "!!!!" << std::endl; }
 
   if (is_christmas()) {
@@ -158,6 +164,8 @@ Config::load()
     config_video_mapping->get("video", video_string);
     video = VideoSystem::get_video_system(video_string);
     config_video_mapping->get("vsync", try_vsync);
+    config_video_mapping->get("texture_atlas", texture_atlas);
+    config_video_mapping->get("async_image_loading", async_image_loading);
 
     config_video_mapping->get("fullscreen_width",  fullscreen_size.width);
     config_video_mapping->get("fullscreen_height", fullscreen_size.height);
@@ -283,6 +291,8 @@ Config::save()
     writer.write("video", VideoSystem::get_video_string(video));
   }
   writer.write("vsync", try_vsync);
+  writer.write("texture_atlas", texture_atlas);
+  writer.write("async_image_loading", async_image_loading);
 
   writer.write("fullscreen_width",  fullscreen_size.width);
   writer.write("fullscreen_height", fullscreen_size.height);
@@ -349,6 +359,8 @@ Config::save()
     writer.write("render_lighting", editor_render_lighting);
     writer.write("selected_snap_grid_size", editor_selected_snap_grid_size);
     writer.write("snap_to_grid", editor_snap_to_grid);
+    writer.write("undo_deltas", editor_undo_deltas);
+    writer.write("undo_memory", editor_undo_memory);
   }
   writer.end_list("editor");
 
@@ -64,6 +64,14 @@ public:
   bool use_fullscreen;
   VideoSystem::Enum video;
   bool try_vsync;
+
+  /** Place small sprite and tile images on shared textures */
+  bool texture_atlas;
+
+  /** Decode the images of a level on a background thread while it is
+      being loaded */
+  bool async_image_loading;
+
   bool show_fps;
   bool show_player_pos;
   bool show_controller;
@@ -121,6 +129,9 @@ public:
   bool editor_autotile_mode;
   bool editor_autotile_help;
   int editor_autosave_frequency;
+  bool editor_undo_deltas;
+  /** Memory limit of the editor undo history in MiB */
+  int editor_undo_memory;
 
   std::string repository_url;
 
@@ -0,0 +1,329 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/level_header.hpp"
+
+#include <ctype.h>
+#include <stdexcept>
+#include <stdlib.h>
+
+#include "physfs/ifile_stream.hpp"
+#include "util/gettext.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+/** Tokenizer for the subset of S-Expressions used by level files,
+    reads from the stream as needed so that the reader can stop
+    early. */
+class Lexer final
+{
+public:
+  enum Token
+  {
+    TOKEN_EOF,
+    TOKEN_OPEN_PAREN,
+    TOKEN_CLOSE_PAREN,
+    TOKEN_STRING,
+    TOKEN_ATOM
+  };
+
+public:
+  Lexer(std::istream& in) :
+    m_in(in),
+    m_text()
+  {}
+
+  Token next()
+  {
+    int c = m_in.get();
+    while (c != EOF && (isspace(c) || c == ';'))
+    {
+      if (c == ';') {
+        while (c != '\n' && c != EOF)
+          c = m_in.get();
+      } else {
+        c = m_in.get();
+      }
+    }
+
+    m_text.clear();
+    switch (c)
+    {
+      case EOF:
+        return TOKEN_EOF;
+
+      case '(':
+        return TOKEN_OPEN_PAREN;
+
+      case ')':
+        return TOKEN_CLOSE_PAREN;
+
+      case '"':
+        for (c = m_in.get(); c != '"'; c = m_in.get())
+        {
+          if (c == '\\') {
+            c = m_in.get();
+            if (c == 'n')
+              c = '\n';
+            else if (c == 't')
+              c = '\t';
+          }
+
+          if (c == EOF)
+            throw std::runtime_error("unterminated string");
+          m_text += static_cast<char>(c);
+        }
+        return TOKEN_STRING;
+
+      default:
+        m_text += static_cast<char>(c);
+        for (c = m_in.peek(); c != EOF && !isspace(c) && c != '(' && c != ')' && c != '"' && c != ';';
+             c = m_in.peek())
+        {
+          m_text += static_cast<char>(m_in.get());
+        }
+        return TOKEN_ATOM;
+    }
+  }
+
+  /** Skips tokens until `depth` lists have been closed */
+  void skip(int depth)
+  {
+    while (depth > 0)
+    {
+      switch (next())
+      {
+        case TOKEN_OPEN_PAREN:
+          depth += 1;
+          break;
+
+        case TOKEN_CLOSE_PAREN:
+          depth -= 1;
+          break;
+
+        case TOKEN_EOF:
+          throw std::runtime_error("unexpected end of file");
+
+        default:
+          break;
+      }
+    }
+  }
+
+  const std::string& get_text() const { return m_text; }
+
+private:
+  std::istream& m_in;
+  std::string m_text;
+
+private:
+  Lexer(const Lexer&) = delete;
+  Lexer& operator=(const Lexer&) = delete;
+};
+
+/** Reads the value of a field whose key has just been read, up to
+    and including the closing paren of the field. Returns false if
+    the value is not a single atom, string or (_ "string"). */
+bool read_value(Lexer& lexer, std::string& value, bool& translatable)
+{
+  // (key value) and (key (_ "value")) are at most five tokens
+  const int MAX_TOKENS = 5;
+
+  Lexer::Token tokens[MAX_TOKENS];
+  std::string texts[MAX_TOKENS];
+  int count = 0;
+  int depth = 1;
+  while (depth > 0)
+  {
+    if (count == MAX_TOKENS) {
+      lexer.skip(depth);
+      return false;
+    }
+
+    const Lexer::Token token = lexer.next();
+    if (token == Lexer::TOKEN_EOF)
+      throw std::runtime_error("unexpected end of file");
+    else if (token == Lexer::TOKEN_OPEN_PAREN)
+      depth += 1;
+    else if (token == Lexer::TOKEN_CLOSE_PAREN)
+      depth -= 1;
+
+    tokens[count] = token;
+    texts[count] = lexer.get_text();
+    count += 1;
+  }
+
+  if (count == 2 &&
+      (tokens[0] == Lexer::TOKEN_STRING || tokens[0] == Lexer::TOKEN_ATOM))
+  {
+    value = texts[0];
+    translatable = false;
+    return true;
+  }
+  else if (count == 5 &&
+           tokens[0] == Lexer::TOKEN_OPEN_PAREN &&
+           tokens[1] == Lexer::TOKEN_ATOM && texts[1] == "_" &&
+           tokens[2] == Lexer::TOKEN_STRING)
+  {
+    value = texts[2];
+    translatable = true;
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+/** Reads the rest of a (sector ...) field, returns the name of the
+    sector or an empty string if it has none */
+std::string read_sector_name(Lexer& lexer)
+{
+  std::string name;
+  for (;;)
+  {
+    switch (lexer.next())
+    {
+      case Lexer::TOKEN_CLOSE_PAREN:
+        return name;
+
+      case Lexer::TOKEN_EOF:
+        throw std::runtime_error("unexpected end of file");
+
+      case Lexer::TOKEN_OPEN_PAREN:
+        switch (lexer.next())
+        {
+          case Lexer::TOKEN_CLOSE_PAREN:
+            break;
+
+          case Lexer::TOKEN_OPEN_PAREN:
+            lexer.skip(2);
+            break;
+
+          default:
+            if (name.empty() && lexer.get_text() == "name") {
+              std::string value;
+              bool translatable;
+              if (read_value(lexer, value, translatable))
+                name = value;
+            } else {
+              lexer.skip(1);
+            }
+            break;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+} // namespace
+
+LevelHeader
+LevelHeader::from_stream(std::istream& in, bool read_sectors)
+{
+  Lexer lexer(in);
+  if (lexer.next() != Lexer::TOKEN_OPEN_PAREN ||
+      lexer.next() != Lexer::TOKEN_ATOM ||
+      lexer.get_text() != "supertux-level")
+  {
+    throw std::runtime_error("file is not a supertux-level file.");
+  }
+
+  LevelHeader header;
+  bool in_header = true;
+  for (;;)
+  {
+    const Lexer::Token token = lexer.next();
+    if (token == Lexer::TOKEN_CLOSE_PAREN || token == Lexer::TOKEN_EOF)
+      break;
+    else if (token != Lexer::TOKEN_OPEN_PAREN)
+      continue;
+
+    const Lexer::Token key_token = lexer.next();
+    if (key_token == Lexer::TOKEN_CLOSE_PAREN) {
+      continue;
+    } else if (key_token != Lexer::TOKEN_ATOM) {
+      lexer.skip(key_token == Lexer::TOKEN_OPEN_PAREN ? 2 : 1);
+      continue;
+    }
+
+    const std::string key = lexer.get_text();
+    if (key == "sector")
+    {
+      if (!read_sectors)
+        break;
+
+      const std::string name = read_sector_name(lexer);
+      if (!name.empty())
+        header.sectors.push_back(name);
+      continue;
+    }
+    else if (!in_header)
+    {
+      lexer.skip(1);
+      continue;
+    }
+
+    std::string value;
+    bool translatable;
+    if (!read_value(lexer, value, translatable))
+    {
+      // The scalar fields are over
+      if (!read_sectors)
+        break;
+      in_header = false;
+      continue;
+    }
+
+    if (key == "version") {
+      header.version = static_cast<int>(strtol(value.c_str(), nullptr, 10));
+    } else if (key == "name") {
+      header.name = value;
+      header.name_translatable = translatable;
+    } else if (key == "author") {
+      header.author = value;
+    } else if (key == "license") {
+      header.license = value;
+    } else if (key == "target-time") {
+      header.target_time = strtof(value.c_str(), nullptr);
+    }
+  }
+
+  return header;
+}
+
+LevelHeader
+LevelHeader::from_file(const std::string& filename, bool read_sectors)
+{
+  IFileStream in(filename);
+  return from_stream(in, read_sectors);
+}
+
+std::string
+LevelHeader::get_name() const
+{
+  if (name_translatable && ReaderMapping::s_translations_enabled)
+    return _(name);
+  else
+    return name;
+}
+
+/* EOF */
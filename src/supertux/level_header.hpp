@@ -0,0 +1,62 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_HEADER_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_HEADER_HPP
+
+#include <istream>
+#include <string>
+#include <vector>
+
+/** Metadata of a level, read without parsing the sectors */
+struct LevelHeader
+{
+public:
+  /** Reads the top-level scalar fields of a supertux-level and stops
+      at the first field that is a list, usually the first sector.
+      With `read_sectors` the rest of the file is skimmed for the
+      names of the sectors instead, without building a tree. Throws
+      std::runtime_error if the stream doesn't contain a level. */
+  static LevelHeader from_stream(std::istream& in, bool read_sectors = false);
+  static LevelHeader from_file(const std::string& filename, bool read_sectors = false);
+
+public:
+  LevelHeader() :
+    version(0),
+    name(),
+    name_translatable(false),
+    author(),
+    license(),
+    target_time(0.0f),
+    sectors()
+  {}
+
+  /** Returns the name, translated if the level marked it as such */
+  std::string get_name() const;
+
+  int version;
+  std::string name;
+  bool name_translatable;
+  std::string author;
+  std::string license;
+  float target_time;
+  std::vector<std::string> sectors;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,211 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/level_index.hpp"
+
+#include <physfs.h>
+#include <sstream>
+#include <stdexcept>
+#include <stdlib.h>
+
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_iterator.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+namespace {
+
+const int INDEX_VERSION = 1;
+
+std::string get_index_filename(const std::string& basedir)
+{
+  std::string name = basedir;
+  for (auto& c : name)
+  {
+    if (c == '/' || c == '\\' || c == ':')
+      c = '_';
+  }
+  return "levelindex/" + name + ".stli";
+}
+
+} // namespace
+
+LevelIndex::LevelIndex(const std::string& basedir) :
+  m_filename(get_index_filename(basedir)),
+  m_entries(),
+  m_dirty(false)
+{
+  try
+  {
+    load();
+  }
+  catch(const std::exception& err)
+  {
+    log_warning << "Couldn't read level index '" << m_filename << "': " << err.what() << std::endl;
+    m_entries.clear();
+  }
+}
+
+void
+LevelIndex::load()
+{
+  if (!PHYSFS_exists(m_filename.c_str()))
+    return;
+
+  auto doc = ReaderDocument::from_file(m_filename);
+  auto root = doc.get_root();
+  if (root.get_name() != "supertux-level-index")
+    throw std::runtime_error("file is not a supertux-level-index file.");
+
+  auto mapping = root.get_mapping();
+  int version = 0;
+  mapping.get("version", version);
+  if (version != INDEX_VERSION)
+    return;
+
+  auto iter = mapping.get_iter();
+  while (iter.next())
+  {
+    if (iter.get_key() != "level")
+      continue;
+
+    auto level = iter.as_mapping();
+
+    std::string path;
+    std::string mtime;
+    std::string size;
+    if (!level.get("path", path) || !level.get("mtime", mtime) || !level.get("size", size))
+      continue;
+
+    Entry entry;
+    entry.mtime = strtoll(mtime.c_str(), nullptr, 10);
+    entry.size = strtoll(size.c_str(), nullptr, 10);
+    entry.used = false;
+
+    LevelHeader& header = entry.header;
+    level.get("version", header.version);
+    level.get("name", header.name);
+    level.get("name-translatable", header.name_translatable);
+    level.get("author", header.author);
+    level.get("license", header.license);
+    level.get("target-time", header.target_time);
+    level.get("sectors", header.sectors);
+
+    m_entries[path] = entry;
+  }
+}
+
+const LevelHeader&
+LevelIndex::get(const std::string& filename)
+{
+  PHYSFS_Stat stat;
+  if (!PHYSFS_stat(filename.c_str(), &stat))
+  {
+    std::ostringstream msg;
+    msg << "Couldn't stat '" << filename << "': " << PHYSFS_getLastErrorCode();
+    throw std::runtime_error(msg.str());
+  }
+
+  auto it = m_entries.find(filename);
+  if (it != m_entries.end() &&
+      it->second.mtime == stat.modtime &&
+      it->second.size == stat.filesize)
+  {
+    it->second.used = true;
+    return it->second.header;
+  }
+
+  Entry entry;
+  entry.mtime = stat.modtime;
+  entry.size = stat.filesize;
+  entry.used = true;
+  entry.header = LevelHeader::from_file(filename, true);
+
+  m_dirty = true;
+  return (m_entries[filename] = entry).header;
+}
+
+std::string
+LevelIndex::get_level_name(const std::string& filename)
+{
+  try
+  {
+    register_translation_directory(filename);
+    return get(filename).get_name();
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Problem getting name of '" << filename << "': "
+                << e.what() << std::endl;
+    return "";
+  }
+}
+
+void
+LevelIndex::save()
+{
+  if (!m_dirty)
+    return;
+
+  try
+  {
+    const std::string dirname = FileSystem::dirname(m_filename);
+    if (!PHYSFS_exists(dirname.c_str()) && !PHYSFS_mkdir(dirname.c_str()))
+    {
+      std::ostringstream msg;
+      msg << "Couldn't create directory '" << dirname << "': " << PHYSFS_getLastErrorCode();
+      throw std::runtime_error(msg.str());
+    }
+
+    Writer writer(m_filename);
+    writer.start_list("supertux-level-index");
+    writer.write("version", INDEX_VERSION);
+
+    for (const auto& it : m_entries)
+    {
+      const Entry& entry = it.second;
+      if (!entry.used)
+        continue;
+
+      const LevelHeader& header = entry.header;
+      writer.start_list("level");
+      writer.write("path", it.first);
+      writer.write("mtime", std::to_string(entry.mtime));
+      writer.write("size", std::to_string(entry.size));
+      writer.write("version", header.version);
+      writer.write("name", header.name);
+      writer.write("name-translatable", header.name_translatable);
+      writer.write("author", header.author);
+      writer.write("license", header.license);
+      writer.write("target-time", header.target_time);
+      writer.write("sectors", header.sectors);
+      writer.end_list("level");
+    }
+
+    writer.end_list("supertux-level-index");
+    m_dirty = false;
+  }
+  catch(const std::exception& err)
+  {
+    log_warning << "Couldn't write level index '" << m_filename << "': " << err.what() << std::endl;
+  }
+}
+
+/* EOF */
@@ -0,0 +1,78 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_INDEX_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_INDEX_HPP
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+#include "supertux/level_header.hpp"
+
+/**
+ * Cache of the LevelHeaders of the levels in a levelset, kept in the
+ * user directory so that menus listing the levels don't have to read
+ * every level file each time they are opened. Entries are keyed by
+ * path and invalidated when the modification time or the size of the
+ * level changes.
+ */
+class LevelIndex final
+{
+public:
+  /** Loads the index of the levelset in `basedir`, an unreadable
+      index is treated as empty */
+  LevelIndex(const std::string& basedir);
+
+  /** Returns the header of the level, reading it if it is not in the
+      index or has changed since. Throws if the level can't be read. */
+  const LevelHeader& get(const std::string& filename);
+
+  /** Returns the translated name of the level, or an empty string if
+      the level can't be read */
+  std::string get_level_name(const std::string& filename);
+
+  /** Writes the index back if entries were added or refreshed. Only
+      the entries looked up since loading are kept, which drops
+      levels that no longer exist. */
+  void save();
+
+private:
+  struct Entry
+  {
+    int64_t mtime;
+    int64_t size;
+    bool used;
+    LevelHeader header;
+  };
+
+private:
+  void load();
+
+private:
+  std::string m_filename;
+  std::unordered_map<std::string, Entry> m_entries;
+  bool m_dirty;
+
+private:
+  LevelIndex(const LevelIndex&) = delete;
+  LevelIndex& operator=(const LevelIndex&) = delete;
+};
+
+#endif
+
+/* EOF */
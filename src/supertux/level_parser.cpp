@@ -17,15 +17,146 @@
 #include "supertux/level_parser.hpp"
 
 #include <physfs.h>
+#include <set>
 #include <sstream>
 
+#include "sprite/sprite_manager.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_header.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/sector_parser.hpp"
+#include "util/compiled_document.hpp"
+#include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+#include "util/timelog.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+bool is_image_file(const std::string& filename)
+{
+  return (StringUtil::has_suffix(filename, ".png") ||
+          StringUtil::has_suffix(filename, ".jpg"));
+}
+
+/** Drops the prefetched images that the level didn't use once it is
+    loaded, also when loading throws */
+class PrefetchGuard final
+{
+public:
+  PrefetchGuard(bool active) :
+    m_active(active)
+  {
+  }
+
+  ~PrefetchGuard()
+  {
+    if (m_active)
+      TextureManager::current()->clear_prefetched();
+  }
+
+private:
+  bool m_active;
+
+private:
+  PrefetchGuard(const PrefetchGuard&) = delete;
+  PrefetchGuard& operator=(const PrefetchGuard&) = delete;
+};
+
+/** Resolves `path` relative to `directory` first, then relative to
+    the data directory, like the loaders of images and sprites do.
+    Returns an empty string if neither exists. */
+std::string resolve_path(const std::string& directory, const std::string& path)
+{
+  const std::string relative = FileSystem::join(directory, path);
+  if (PHYSFS_exists(relative.c_str()))
+    return relative;
+  else if (PHYSFS_exists(path.c_str()))
+    return path;
+  else
+    return std::string();
+}
+
+/** Loads the compiled form of `filename` when one exists that is at
+    least as new as the source, the source otherwise. */
+ReaderDocument load_document(const std::string& filename)
+{
+  const std::string compiled_filename = CompiledDocument::get_filename(filename);
+
+  PHYSFS_Stat compiled_stat;
+  if (PHYSFS_stat(compiled_filename.c_str(), &compiled_stat))
+  {
+    PHYSFS_Stat source_stat;
+    if (!PHYSFS_stat(filename.c_str(), &source_stat) ||
+        compiled_stat.modtime >= source_stat.modtime)
+    {
+      try
+      {
+        return ReaderDocument::from_compiled_file(compiled_filename);
+      }
+      catch(const std::exception& err)
+      {
+        log_warning << "[" << compiled_filename << "] failed to load compiled level, "
+                    << "falling back to source: " << err.what() << std::endl;
+      }
+    }
+  }
+
+  return ReaderDocument::from_file(filename);
+}
+
+/** Collects the image files referenced by strings in `sx`, following
+    references to sprite files that aren't loaded yet. Tilesets are not
+    followed, finding their images would mean parsing them twice. */
+void collect_images(const sexp::Value& sx, const std::string& directory,
+                    std::set<std::string>& images, std::set<std::string>& sprites)
+{
+  if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array())
+    {
+      collect_images(item, directory, images, sprites);
+    }
+  }
+  else if (sx.is_string())
+  {
+    const std::string& value = sx.as_string();
+    if (is_image_file(value))
+    {
+      const std::string path = resolve_path(directory, value);
+      if (!path.empty())
+        images.insert(path);
+    }
+    else if (StringUtil::has_suffix(value, ".sprite"))
+    {
+      if (SpriteManager::current()->is_loaded(value))
+        return;
+
+      const std::string path = resolve_path(directory, value);
+      if (path.empty() || !sprites.insert(path).second)
+        return;
+
+      try
+      {
+        auto doc = ReaderDocument::from_file(path);
+        collect_images(doc.get_sexp(), doc.get_directory(), images, sprites);
+      }
+      catch(const std::exception& err)
+      {
+        // the sprite reports the error itself when it gets loaded
+        log_debug << "Couldn't scan sprite '" << path << "' for images: " << err.what() << std::endl;
+      }
+    }
+  }
+}
+
+} // namespace
 
 std::string
 LevelParser::get_level_name(const std::string& filename)
@@ -33,17 +164,7 @@ LevelParser::get_level_name(const std::string& filename)
   try
   {
     register_translation_directory(filename);
-    auto doc = ReaderDocument::from_file(filename);
-    auto root = doc.get_root();
-
-    if (root.get_name() != "supertux-level") {
-      return "";
-    } else {
-      auto mapping = root.get_mapping();
-      std::string name;
-      mapping.get("name", name);
-      return name;
-    }
+    return LevelHeader::from_file(filename).get_name();
   }
   catch(const std::exception& e)
   {
@@ -134,7 +255,7 @@ LevelParser::load(const std::string& filepath)
   m_level.m_filename = filepath;
   register_translation_directory(filepath);
   try {
-    auto doc = ReaderDocument::from_file(filepath);
+    auto doc = load_document(filepath);
     load(doc);
   } catch(std::exception& e) {
     std::stringstream msg;
@@ -143,6 +264,20 @@ LevelParser::load(const std::string& filepath)
   }
 }
 
+void
+LevelParser::prefetch_images(const ReaderDocument& doc)
+{
+  std::set<std::string> images;
+  std::set<std::string> sprites;
+  collect_images(doc.get_sexp(), doc.get_directory(), images, sprites);
+
+  log_debug << "[" << doc.get_filename() << "] prefetching " << images.size() << " images" << std::endl;
+  for (const auto& image : images)
+  {
+    TextureManager::current()->prefetch(image);
+  }
+}
+
 void
 LevelParser::load(const ReaderDocument& doc)
 {
@@ -151,6 +286,19 @@ LevelParser::load(const ReaderDocument& doc)
   if (root.get_name() != "supertux-level")
     throw std::runtime_error("file is not a supertux-level file.");
 
+  const bool prefetch = (g_config->async_image_loading &&
+                         TextureManager::current() &&
+                         SpriteManager::current());
+
+  PrefetchGuard prefetch_guard(prefetch);
+  Timelog timelog;
+  if (prefetch)
+  {
+    timelog.log("prefetch");
+    prefetch_images(doc);
+  }
+  timelog.log("sectors");
+
   auto level = root.get_mapping();
 
   int version = 1;
@@ -188,6 +336,8 @@ LevelParser::load(const ReaderDocument& doc)
   }
 
   m_level.m_stats.init(m_level);
+
+  timelog.log(nullptr);
 }
 
 void
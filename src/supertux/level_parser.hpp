@@ -41,6 +41,9 @@ private:
   void load(std::istream& stream, const std::string& context);
   void load(const std::string& filepath);
   void load_old_format(const ReaderMapping& reader);
+
+  /** Queues the images referenced by the level for background decoding */
+  void prefetch_images(const ReaderDocument& doc);
   void create(const std::string& filepath, const std::string& levelname);
 
 private:
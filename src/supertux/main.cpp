@@ -53,6 +53,7 @@ extern "C" {
 #include "sdk/integration.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/command_line_arguments.hpp"
 #include "supertux/console.hpp"
 #include "supertux/error_handler.hpp"
@@ -72,8 +73,10 @@ extern "C" {
 #include "supertux/tile_manager.hpp"
 #include "supertux/title_screen.hpp"
 #include "supertux/world.hpp"
+#include "util/compiled_document.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/reader_document.hpp"
 #include "util/string_util.hpp"
 #include "util/timelog.hpp"
 #include "util/string_util.hpp"
@@ -445,6 +448,29 @@ Main::resave(const std::string& input_filename, const std::string& output_filena
   Editor::s_resaving_in_progress = false;
 }
 
+void
+Main::compile(const std::string& filename)
+{
+  std::ifstream in(filename);
+  if (!in) {
+    log_fatal << filename << ": couldn't open file for reading" << std::endl;
+    return;
+  }
+
+  log_info << "loading level: " << filename << std::endl;
+  auto doc = ReaderDocument::from_stream(in, filename);
+  in.close();
+
+  const std::string output_filename = CompiledDocument::get_filename(filename);
+  std::ofstream out(output_filename, std::ios::binary);
+  if (!out) {
+    log_fatal << output_filename << ": couldn't open file for writing" << std::endl;
+  } else {
+    log_info << "compiling level: " << output_filename << std::endl;
+    doc.save_compiled(out);
+  }
+}
+
 void
 Main::launch_game(const CommandLineArguments& args)
 {
@@ -463,7 +489,8 @@ Main::launch_game(const CommandLineArguments& args)
 
 #ifndef EMSCRIPTEN
   auto video = g_config->video;
-  if (args.resave && *args.resave) {
+  if ((args.resave && *args.resave) || (args.compile && *args.compile) ||
+      (args.benchmark && *args.benchmark) || args.benchmark_case) {
     if (args.video) {
       video = *args.video;
     } else {
@@ -483,8 +510,13 @@ Main::launch_game(const CommandLineArguments& args)
 
   s_timelog.log("audio");
   m_sound_manager.reset(new SoundManager());
-  m_sound_manager->enable_sound(g_config->sound_enabled);
-  m_sound_manager->enable_music(g_config->music_enabled);
+  if ((args.benchmark && *args.benchmark) || args.benchmark_case) {
+    m_sound_manager->enable_sound(false);
+    m_sound_manager->enable_music(false);
+  } else {
+    m_sound_manager->enable_sound(g_config->sound_enabled);
+    m_sound_manager->enable_music(g_config->music_enabled);
+  }
   m_sound_manager->set_sound_volume(g_config->sound_volume);
   m_sound_manager->set_music_volume(g_config->music_volume);
 
@@ -511,6 +543,12 @@ Main::launch_game(const CommandLineArguments& args)
   m_game_manager.reset(new GameManager());
   m_screen_manager.reset(new ScreenManager(*m_video_system, *m_input_manager));
 
+  if (args.benchmark_case)
+  {
+    run_benchmark_cases(*args.benchmark_case, std::cout);
+    return;
+  }
+
   if (!args.filenames.empty())
   {
     for(const auto& start_level : args.filenames)
@@ -527,9 +565,12 @@ Main::launch_game(const CommandLineArguments& args)
       log_debug << "Adding dir: " << dir << std::endl;
       PHYSFS_mount(dir.c_str(), nullptr, true);
 
-      if (args.resave && *args.resave)
+      if ((args.resave && *args.resave) || (args.compile && *args.compile))
       {
-        resave(start_level, start_level);
+        if (args.resave && *args.resave)
+          resave(start_level, start_level);
+        if (args.compile && *args.compile)
+          compile(start_level);
       }
       else if (args.editor)
       {
@@ -605,7 +646,16 @@ Main::launch_game(const CommandLineArguments& args)
                          "Open Store's Telegram at https://open-store.io/telegram"));
 #endif
 
+  std::unique_ptr<Benchmark> benchmark;
+  if (args.benchmark && *args.benchmark && !args.filenames.empty()) {
+    benchmark.reset(new Benchmark(args.filenames.front(), g_config->start_demo));
+  }
+
   m_screen_manager->run();
+
+  if (benchmark) {
+    benchmark->write_json(std::cout);
+  }
 }
 
 int
@@ -86,6 +86,7 @@ private:
 
   void launch_game(const CommandLineArguments& args);
   void resave(const std::string& input_filename, const std::string& output_filename);
+  void compile(const std::string& filename);
 
 private:
   // Using pointers allows us to initialize them whenever we want
@@ -22,7 +22,7 @@
 #include "audio/sound_manager.hpp"
 #include "gui/item_action.hpp"
 #include "supertux/game_manager.hpp"
-#include "supertux/level_parser.hpp"
+#include "supertux/level_index.hpp"
 #include "supertux/levelset.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/savegame.hpp"
@@ -44,11 +44,12 @@ ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
   add_label(m_world->get_title());
   add_hl();
 
+  LevelIndex level_index(m_world->get_basedir());
   for (int i = 0; i < m_levelset->get_num_levels(); ++i)
   {
     std::string filename = m_levelset->get_level_filename(i);
     std::string full_filename = FileSystem::join(m_world->get_basedir(), filename);
-    std::string title = LevelParser::get_level_name(full_filename);
+    std::string title = level_index.get_level_name(full_filename);
     LevelState level_state = state.get_level_state(filename);
 
     std::ostringstream out;
@@ -62,6 +63,7 @@ ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
     }
     add_entry(i, out.str());
   }
+  level_index.save();
 
   add_hl();
   add_back(_("Back"));
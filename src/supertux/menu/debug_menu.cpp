@@ -19,6 +19,8 @@
 #include <algorithm>
 #include <sstream>
 
+#include "config.h"
+
 #include "gui/item_stringselect.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/gameconfig.hpp"
@@ -64,6 +66,10 @@ DebugMenu::DebugMenu() :
   add_toggle(-1, _("Show Worldmap Path"), &g_debug.show_worldmap_path);
   add_toggle(-1, _("Show Controller"), &g_config->show_controller);
   add_toggle(-1, _("Show Framerate"), &g_config->show_fps);
+  add_toggle(-1, _("Show Render Statistics"), &g_debug.show_render_stats);
+#ifdef ENABLE_PROFILER
+  add_toggle(-1, _("Show Profiler"), &g_debug.show_profiler);
+#endif
   add_toggle(-1, _("Draw Redundant Frames"), &g_debug.draw_redundant_frames);
   add_toggle(-1, _("Show Player Position"), &g_config->show_player_pos);
   add_toggle(-1, _("Use Bitmap Fonts"),
@@ -17,7 +17,7 @@
 #include "supertux/menu/editor_delete_level_menu.hpp"
 #include <physfs.h>
 #include "supertux/levelset.hpp"
-#include "supertux/level_parser.hpp"
+#include "supertux/level_index.hpp"
 #include "supertux/level.hpp"
 #include "supertux/menu/editor_level_select_menu.hpp"
 #include "supertux/menu/editor_levelset_select_menu.hpp"
@@ -32,13 +32,15 @@ EditorDeleteLevelMenu::EditorDeleteLevelMenu(std::unique_ptr<Levelset>& levelset
 {
   add_label(_("Delete level"));
   add_hl();
+  LevelIndex level_index(Editor::current()->get_world()->get_basedir());
   for (int i = 0; i < levelset->get_num_levels(); i++)
   {
     std::string filename = levelset->get_level_filename(i);
     std::string fullpath = FileSystem::join(Editor::current()->get_world()->get_basedir(),filename);
     m_level_full_paths.push_back(fullpath);
-    add_entry(i, LevelParser::get_level_name(fullpath));
+    add_entry(i, level_index.get_level_name(fullpath));
   }
+  level_index.save();
   add_hl();
   add_back(_("Back"));
 }
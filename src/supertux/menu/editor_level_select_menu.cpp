@@ -23,6 +23,7 @@
 #include "gui/menu_item.hpp"
 #include "supertux/game_manager.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_index.hpp"
 #include "supertux/level_parser.hpp"
 #include "supertux/levelset.hpp"
 #include "supertux/menu/editor_levelset_menu.hpp"
@@ -63,13 +64,15 @@ void EditorLevelSelectMenu::initialize() {
   }
   else
   {
+    LevelIndex level_index(basedir);
     for (int i = 0; i < num_levels; ++i)
     {
       std::string filename = m_levelset->get_level_filename(i);
       std::string full_filename = FileSystem::join(basedir, filename);
-      std::string title = LevelParser::get_level_name(full_filename);
+      std::string title = level_index.get_level_name(full_filename);
       add_entry(i, title);
     }
+    level_index.save();
   }
 
   add_hl();
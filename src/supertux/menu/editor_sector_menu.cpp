@@ -76,6 +76,7 @@ EditorSectorMenu::menu_action(MenuItem& item)
       if (new_size.is_valid()) {
         sector->resize_sector(size, new_size, offset);
         size = new_size;
+        Editor::current()->sector_changed();
       }
       break;
   }
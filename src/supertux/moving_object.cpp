@@ -16,6 +16,7 @@
 
 #include "supertux/moving_object.hpp"
 
+#include "collision/collision.hpp"
 #include "editor/resize_marker.hpp"
 #include "supertux/sector.hpp"
 #include "util/reader_mapping.hpp"
@@ -82,4 +83,14 @@ MovingObject::on_flip(float height)
   set_pos(pos);
 }
 
+bool
+MovingObject::is_in_view(const Rectf& view) const
+{
+  const float margin = get_draw_margin();
+  if (margin < 0.0f)
+    return true;
+
+  return collision::intersects(m_col.m_bbox.grown(margin), view);
+}
+
 /* EOF */
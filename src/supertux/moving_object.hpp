@@ -101,6 +101,13 @@ public:
 
   virtual int get_layer() const = 0;
 
+  virtual bool is_in_view(const Rectf& view) const override;
+
+  /** Distance around the bounding box that draw() might paint into,
+      a negative value disables culling for objects that draw at
+      screen positions or otherwise far away from their bounding box */
+  virtual float get_draw_margin() const { return 256.0f; }
+
 protected:
   void set_group(CollisionGroup group)
   {
@@ -27,6 +27,7 @@
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/console.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/controller_hud.hpp"
@@ -41,11 +42,14 @@
 #include "supertux/sector.hpp"
 #include "supertux/timer.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/render_stats.hpp"
 
 #include <stdio.h>
 #include <chrono>
+#include <functional>
 #include <iostream>
 
 #ifdef __EMSCRIPTEN__
@@ -262,9 +266,94 @@ ScreenManager::draw_player_pos(DrawingContext& context)
   }
 }
 
+void
+ScreenManager::draw_render_stats(DrawingContext& context)
+{
+  // Counters of the last complete frame, this frame is still being drawn
+  const RenderStats::Counters& stats = g_render_stats.get_last_frame();
+
+  const std::string lines[] = {
+    "Requests: " + std::to_string(stats.requests),
+    "Merged requests: " + std::to_string(stats.merged_requests),
+    "Expanded quads: " + std::to_string(stats.expanded_quads),
+    "Cached requests: " + std::to_string(stats.cached_requests),
+    "Cached quads: " + std::to_string(stats.cached_quads),
+    "Cached uploads: " + std::to_string(stats.cached_uploads),
+#ifdef ENABLE_ALLOCATION_COUNTER
+    "Allocations: " + std::to_string(stats.allocations),
+#else
+    "Allocations: n/a",
+#endif
+    "Objects drawn/culled: " + std::to_string(stats.drawn_objects) + "/" + std::to_string(stats.culled_objects),
+  };
+
+  Vector pos(static_cast<float>(context.get_width()) - BORDER_X, BORDER_Y + 90);
+  for (const auto& line : lines)
+  {
+    context.color().draw_text(Resources::small_font, line, pos, ALIGN_RIGHT, LAYER_HUD);
+    pos.y += 15;
+  }
+}
+
+#ifdef ENABLE_PROFILER
+void
+ScreenManager::draw_profiler(DrawingContext& context)
+{
+  if (g_profiler.get_frame_count() == 0)
+    return;
+
+  // Zone totals of the last complete frame and averaged over the
+  // frames in the profiler's ring buffer
+  Vector pos(static_cast<float>(context.get_width()) - BORDER_X, BORDER_Y + 225);
+  context.color().draw_text(Resources::small_font, "Zone  last / avg ms", pos, ALIGN_RIGHT, LAYER_HUD);
+  pos.y += 15;
+
+  char buf[32];
+  for (const auto& summary : g_profiler.get_summary())
+  {
+    snprintf(buf, sizeof(buf), "  %.2f / %.2f", summary.last_ms, summary.average_ms);
+    context.color().draw_text(Resources::small_font,
+                              std::string(static_cast<size_t>(summary.depth) * 2, ' ') + summary.name + buf,
+                              pos, ALIGN_RIGHT, LAYER_HUD);
+    pos.y += 15;
+  }
+
+  // Flame view of the last frame, one row per nesting level, scaled so
+  // that a frame at the logical frame rate fills the width
+  const Profiler::Frame& frame = g_profiler.get_frame(0);
+  const float width = 300.0f;
+  const float row_height = 8.0f;
+  const double frame_ns = std::max(static_cast<double>(frame.end - frame.start), 1.0e9 / LOGICAL_FPS);
+  const float scale = width / static_cast<float>(frame_ns);
+  const float left = static_cast<float>(context.get_width()) - BORDER_X - width;
+  const float top = pos.y + 5.0f;
+
+  context.color().draw_filled_rect(Rectf(left, top, left + width, top + row_height * 8.0f),
+                                   Color(0.0f, 0.0f, 0.0f, 0.5f), LAYER_HUD);
+
+  for (const auto& zone : frame.zones)
+  {
+    const float x1 = left + static_cast<float>(zone.start - frame.start) * scale;
+    const float x2 = left + static_cast<float>(zone.end - frame.start) * scale;
+    const float y = top + static_cast<float>(zone.depth) * row_height;
+
+    // Give every zone name a stable color
+    const size_t hash = std::hash<std::string>()(zone.name);
+    const Color color(0.5f + static_cast<float>(hash & 0xff) / 510.0f,
+                      0.3f + static_cast<float>((hash >> 8) & 0xff) / 510.0f,
+                      0.2f, 0.8f);
+
+    context.color().draw_filled_rect(Rectf(x1, y, std::max(x2, x1 + 1.0f), y + row_height - 1.0f),
+                                     color, LAYER_HUD);
+  }
+}
+#endif
+
 void
 ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 {
+  PROFILE_ZONE("ScreenManager::draw");
+
   assert(!m_screen_stack.empty());
 
   // draw the actual screen
@@ -287,6 +376,12 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
   if (g_config->show_fps)
     draw_fps(context, fps_statistics);
 
+#ifdef ENABLE_PROFILER
+  if (g_debug.show_profiler) {
+    draw_profiler(context);
+  }
+#endif
+
   if (g_config->show_controller) {
     m_controller_hud->draw(context);
   }
@@ -295,13 +390,16 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
     draw_player_pos(context);
   }
 
-  // render everything
-  compositor.render();
+  if (g_debug.show_render_stats) {
+    draw_render_stats(context);
+  }
 }
 
 void
 ScreenManager::update_gamelogic(float dt_sec)
 {
+  PROFILE_ZONE("ScreenManager::update_gamelogic");
+
   Controller& controller = m_input_manager.get_controller();
 
 #ifdef ENABLE_TOUCHSCREEN_SUPPORT
@@ -539,8 +637,58 @@ ScreenManager::handle_screen_switch()
   }
 }
 
+void
+ScreenManager::benchmark_iter(Benchmark& benchmark)
+{
+  if (benchmark.is_finished())
+  {
+    quit();
+    handle_screen_switch();
+    return;
+  }
+
+  const auto start = Benchmark::clock::now();
+
+  {
+    // The Benchmark reads the zones of this frame once it is complete
+    PROFILE_FRAME("ScreenManager::loop_iter");
+
+    // Exactly one logical step and one frame per iteration without
+    // waiting for the wall clock, so that runs are reproducible.
+    float dtime = seconds_per_step * m_speed * g_debug.get_game_speed_multiplier();
+    g_game_time += dtime;
+    g_real_time = g_game_time;
+
+    process_events();
+    update_gamelogic(dtime);
+
+    if (!m_screen_stack.empty())
+    {
+      Compositor compositor(m_video_system);
+      draw(compositor, *m_fps_statistics);
+      {
+        BenchmarkTimer benchmark_timer("Compositor::render");
+        compositor.render();
+      }
+      m_fps_statistics->report_frame();
+    }
+
+    SoundManager::current()->update();
+
+    handle_screen_switch();
+  }
+
+  benchmark.end_step(Benchmark::clock::now() - start);
+}
+
 void ScreenManager::loop_iter()
 {
+  if (Benchmark* benchmark = Benchmark::current())
+  {
+    benchmark_iter(*benchmark);
+    return;
+  }
+
   // Useful if screens edit their status without switching screens
   Integration::update_status_all(m_screen_stack.back()->get_status());
   Integration::update_all();
@@ -563,6 +711,8 @@ void ScreenManager::loop_iter()
     return;
   }
 
+  PROFILE_FRAME("ScreenManager::loop_iter");
+
   g_real_time = static_cast<float>(ticks) / 1000.0f;
 
   float speed_multiplier = g_debug.get_game_speed_multiplier();
@@ -608,6 +758,7 @@ void ScreenManager::loop_iter()
     // Draw a frame
     Compositor compositor(m_video_system);
     draw(compositor, *m_fps_statistics);
+    compositor.render();
     m_fps_statistics->report_frame();
   }
 
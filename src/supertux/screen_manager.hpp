@@ -28,6 +28,7 @@
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 
+class Benchmark;
 class Compositor;
 class ControllerHUD;
 class DrawingContext;
@@ -63,11 +64,18 @@ private:
   struct FPS_Stats;
   void draw_fps(DrawingContext& context, FPS_Stats& fps_statistics);
   void draw_player_pos(DrawingContext& context);
+  void draw_render_stats(DrawingContext& context);
+#ifdef ENABLE_PROFILER
+  void draw_profiler(DrawingContext& context);
+#endif
   void draw(Compositor& compositor, FPS_Stats& fps_statistics);
   void update_gamelogic(float dt_sec);
   void process_events();
   void handle_screen_switch();
 
+  /** Replaces loop_iter() while a Benchmark is running */
+  void benchmark_iter(Benchmark& benchmark);
+
 private:
   VideoSystem& m_video_system;
   InputManager& m_input_manager;
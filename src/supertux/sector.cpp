@@ -45,6 +45,7 @@
 #include "physfs/ifile_stream.hpp"
 #include "scripting/sector.hpp"
 #include "squirrel/squirrel_environment.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/colorscheme.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/debug.hpp"
@@ -56,6 +57,7 @@
 #include "supertux/savegame.hpp"
 #include "supertux/tile.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "util/writer.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
@@ -328,6 +330,8 @@ Sector::get_foremost_layer() const
 void
 Sector::update(float dt_sec)
 {
+  PROFILE_ZONE("Sector::update");
+
   assert(m_fully_constructed);
 
   BIND_SECTOR(*this);
@@ -389,9 +393,16 @@ Sector::before_object_remove(GameObject& object)
     m_squirrel_environment->try_unexpose(object);
 }
 
+void
+Sector::after_objects_removed()
+{
+  m_collision_system->flush_removals();
+}
+
 void
 Sector::draw(DrawingContext& context)
 {
+  BenchmarkTimer benchmark_timer("Sector::draw");
   BIND_SECTOR(*this);
 
   Camera& camera = get_camera();
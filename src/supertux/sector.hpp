@@ -143,6 +143,7 @@ public:
   void set_init_script(const std::string& init_script) {
     m_init_script = init_script;
   }
+  const std::string& get_init_script() const { return m_init_script; }
 
   void run_script(const std::string& script, const std::string& sourcename);
 
@@ -155,6 +156,7 @@ private:
 
   virtual bool before_object_add(GameObject& object) override;
   virtual void before_object_remove(GameObject& object) override;
+  virtual void after_objects_removed() override;
 
   int calculate_foremost_layer() const;
 
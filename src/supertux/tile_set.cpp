@@ -49,7 +49,8 @@ TileSet::from_file(const std::string& filename)
 TileSet::TileSet() :
   m_autotilesets(),
   m_tiles(1),
-  m_tilegroups()
+  m_tilegroups(),
+  m_tile_autotilesets()
 {
   m_tiles[0] = std::make_unique<Tile>();
   m_autotilesets = new std::vector<AutotileSet*>();
@@ -95,19 +96,32 @@ TileSet::get(const uint32_t id) const
 AutotileSet*
 TileSet::get_autotileset_from_tile(uint32_t tile_id) const
 {
-  if (tile_id == 0)
+  if (tile_id == 0 || tile_id >= m_tile_autotilesets.size())
   {
     return nullptr;
   }
 
+  return m_tile_autotilesets[tile_id];
+}
+
+void
+TileSet::build_autotile_lookup()
+{
+  m_tile_autotilesets.clear();
+
   for (auto& ats : *m_autotilesets)
   {
-    if (ats->is_member(tile_id))
+    const uint32_t max_tile_id = ats->get_max_tile_id();
+    if (max_tile_id >= m_tile_autotilesets.size())
+      m_tile_autotilesets.resize(max_tile_id + 1, nullptr);
+
+    // Tile 0 is never autotiled, earlier autotilesets take precedence
+    for (uint32_t tile_id = 1; tile_id <= max_tile_id; ++tile_id)
     {
-      return ats;
+      if (!m_tile_autotilesets[tile_id] && ats->is_member(tile_id))
+        m_tile_autotilesets[tile_id] = ats;
     }
   }
-  return nullptr;
 }
 
 void
@@ -61,6 +61,10 @@ public:
   
   AutotileSet* get_autotileset_from_tile(uint32_t tile_id) const;
 
+  /** Builds the table used by get_autotileset_from_tile(), has to be
+      called after m_autotilesets got changed */
+  void build_autotile_lookup();
+
   uint32_t get_max_tileid() const {
     return static_cast<uint32_t>(m_tiles.size());
   }
@@ -79,6 +83,9 @@ private:
   std::vector<std::unique_ptr<Tile> > m_tiles;
   std::vector<Tilegroup> m_tilegroups;
 
+  /** The first autotileset each tile ID is a member of, indexed by tile ID */
+  std::vector<AutotileSet*> m_tile_autotilesets;
+
 private:
   TileSet(const TileSet&) = delete;
   TileSet& operator=(const TileSet&) = delete;
@@ -92,6 +92,9 @@ TileSetParser::parse()
       log_warning << "Unknown symbol '" << iter.get_key() << "' in tileset file" << std::endl;
     }
   }
+
+  m_tileset.build_autotile_lookup();
+
   if (g_config->developer_mode)
   {
     m_tileset.add_unassigned_tilegroup();
@@ -349,7 +352,7 @@ std::vector<SurfacePtr>
     if (iter.is_string())
     {
       std::string file = iter.as_string_item();
-      surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file), surface_region));
+      surfaces.push_back(Surface::from_file_atlased(FileSystem::join(m_tiles_path, file), surface_region));
     }
     else if (iter.is_pair() && iter.get_key() == "surface")
     {
@@ -382,8 +385,8 @@ std::vector<SurfacePtr>
           rect.bottom = rect.top + surface_region->get_height();
         }
 
-        surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file),
-                                              rect));
+        surfaces.push_back(Surface::from_file_atlased(FileSystem::join(m_tiles_path, file),
+                                                      rect));
       }
     }
     else
@@ -43,6 +43,8 @@ public:
   virtual void event(Player& player, EventType type) override;
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  /** The message is drawn in screen coordinates */
+  virtual float get_draw_margin() const override { return -1.0f; }
 
   /** returns true if the player is within bounds of the Climbable */
   bool may_climb(Player& player) const;
@@ -41,6 +41,8 @@ public:
 
   virtual void event(Player& player, EventType type) override;
   virtual void draw(DrawingContext& context) override;
+  /** The message is drawn in screen coordinates */
+  virtual float get_draw_margin() const override { return -1.0f; }
 
   std::string get_fade_tilemap_name() const;
 
@@ -0,0 +1,69 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/allocation_counter.hpp"
+
+#ifdef ENABLE_ALLOCATION_COUNTER
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+namespace {
+
+std::atomic<size_t> s_allocation_count(0);
+
+} // namespace
+
+size_t
+get_allocation_count()
+{
+  return s_allocation_count.load(std::memory_order_relaxed);
+}
+
+// The array and nothrow variants forward to these two, so replacing
+// them is enough to see every allocation.
+
+void*
+operator new(size_t size)
+{
+  s_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+  if (size == 0)
+    size = 1;
+
+  while (true)
+  {
+    void* ptr = malloc(size);
+    if (ptr)
+      return ptr;
+
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+#endif
+
+/* EOF */
@@ -0,0 +1,36 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_ALLOCATION_COUNTER_HPP
+#define HEADER_SUPERTUX_UTIL_ALLOCATION_COUNTER_HPP
+
+#include <stddef.h>
+
+#include "config.h"
+
+#ifdef ENABLE_ALLOCATION_COUNTER
+
+/** Number of heap allocations done through operator new since the
+    program started. allocation_counter.cpp replaces the global
+    operator new and delete to keep track of them, which is why this
+    is only built with ENABLE_ALLOCATION_COUNTER. */
+size_t get_allocation_count();
+
+#endif
+
+#endif
+
+/* EOF */
@@ -0,0 +1,318 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/compiled_document.hpp"
+
+#include <sexp/value.hpp>
+#include <stdexcept>
+#include <string.h>
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'L', 'B' };
+const uint32_t VERSION = 1;
+
+enum Tag : uint8_t
+{
+  TAG_NIL,
+  TAG_TRUE,
+  TAG_FALSE,
+  TAG_INTEGER,
+  TAG_REAL,
+  TAG_STRING,
+  TAG_SYMBOL,
+  TAG_CONS,
+  TAG_ARRAY,
+  /** Symbol followed by raw uint32 values */
+  TAG_BLOCK
+};
+
+/** Lists shorter than this are not worth a block */
+const size_t MIN_BLOCK_SIZE = 16;
+
+void write_u32(std::ostream& out, uint32_t value)
+{
+  const char bytes[4] = {
+    static_cast<char>(value & 0xff),
+    static_cast<char>((value >> 8) & 0xff),
+    static_cast<char>((value >> 16) & 0xff),
+    static_cast<char>((value >> 24) & 0xff)
+  };
+  out.write(bytes, sizeof(bytes));
+}
+
+void write_string(std::ostream& out, const std::string& text)
+{
+  write_u32(out, static_cast<uint32_t>(text.size()));
+  out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+bool is_block(const sexp::Value& sx)
+{
+  const auto& arr = sx.as_array();
+  if (arr.size() < MIN_BLOCK_SIZE + 1 || !arr[0].is_symbol() || arr[0].as_string() != "tiles")
+    return false;
+
+  for (size_t i = 1; i < arr.size(); ++i) {
+    if (!arr[i].is_integer())
+      return false;
+  }
+  return true;
+}
+
+void write_value(std::ostream& out, const sexp::Value& sx)
+{
+  switch (sx.get_type())
+  {
+    case sexp::Value::Type::NIL:
+      out.put(static_cast<char>(TAG_NIL));
+      break;
+
+    case sexp::Value::Type::BOOLEAN:
+      out.put(static_cast<char>(sx.as_bool() ? TAG_TRUE : TAG_FALSE));
+      break;
+
+    case sexp::Value::Type::INTEGER:
+      out.put(static_cast<char>(TAG_INTEGER));
+      write_u32(out, static_cast<uint32_t>(sx.as_int()));
+      break;
+
+    case sexp::Value::Type::REAL:
+    {
+      const float value = sx.as_float();
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      out.put(static_cast<char>(TAG_REAL));
+      write_u32(out, bits);
+      break;
+    }
+
+    case sexp::Value::Type::STRING:
+      out.put(static_cast<char>(TAG_STRING));
+      write_string(out, sx.as_string());
+      break;
+
+    case sexp::Value::Type::SYMBOL:
+      out.put(static_cast<char>(TAG_SYMBOL));
+      write_string(out, sx.as_string());
+      break;
+
+    case sexp::Value::Type::CONS:
+      out.put(static_cast<char>(TAG_CONS));
+      write_value(out, sx.get_car());
+      write_value(out, sx.get_cdr());
+      break;
+
+    case sexp::Value::Type::ARRAY:
+    {
+      const auto& arr = sx.as_array();
+      if (is_block(sx))
+      {
+        out.put(static_cast<char>(TAG_BLOCK));
+        write_string(out, arr[0].as_string());
+        write_u32(out, static_cast<uint32_t>(arr.size() - 1));
+        for (size_t i = 1; i < arr.size(); ++i) {
+          write_u32(out, static_cast<uint32_t>(arr[i].as_int()));
+        }
+      }
+      else
+      {
+        out.put(static_cast<char>(TAG_ARRAY));
+        write_u32(out, static_cast<uint32_t>(arr.size()));
+        for (const auto& item : arr) {
+          write_value(out, item);
+        }
+      }
+      break;
+    }
+  }
+}
+
+class Decoder final
+{
+public:
+  Decoder(const char* data, size_t size, std::vector<std::vector<uint32_t> >& blocks) :
+    m_data(reinterpret_cast<const unsigned char*>(data)),
+    m_size(size),
+    m_pos(0),
+    m_blocks(blocks)
+  {}
+
+  void expect(size_t size) const
+  {
+    if (m_size - m_pos < size)
+      throw std::runtime_error("compiled document is truncated");
+  }
+
+  uint8_t read_u8()
+  {
+    expect(1);
+    return m_data[m_pos++];
+  }
+
+  uint32_t read_u32()
+  {
+    expect(4);
+    const unsigned char* p = m_data + m_pos;
+    m_pos += 4;
+    return static_cast<uint32_t>(p[0]) |
+      (static_cast<uint32_t>(p[1]) << 8) |
+      (static_cast<uint32_t>(p[2]) << 16) |
+      (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  std::string read_string()
+  {
+    const uint32_t size = read_u32();
+    expect(size);
+    std::string text(reinterpret_cast<const char*>(m_data + m_pos), size);
+    m_pos += size;
+    return text;
+  }
+
+  void read_header()
+  {
+    expect(sizeof(MAGIC));
+    if (memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0)
+      throw std::runtime_error("not a compiled document");
+    m_pos += sizeof(MAGIC);
+
+    if (read_u32() != VERSION)
+      throw std::runtime_error("unsupported compiled document version");
+  }
+
+  sexp::Value read_value()
+  {
+    switch (read_u8())
+    {
+      case TAG_NIL:
+        return sexp::Value::nil();
+
+      case TAG_TRUE:
+        return sexp::Value::boolean(true);
+
+      case TAG_FALSE:
+        return sexp::Value::boolean(false);
+
+      case TAG_INTEGER:
+        return sexp::Value::integer(static_cast<int>(read_u32()));
+
+      case TAG_REAL:
+      {
+        const uint32_t bits = read_u32();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return sexp::Value::real(value);
+      }
+
+      case TAG_STRING:
+        return sexp::Value::string(read_string());
+
+      case TAG_SYMBOL:
+        return sexp::Value::symbol(read_string());
+
+      case TAG_CONS:
+      {
+        auto car = read_value();
+        auto cdr = read_value();
+        return sexp::Value::cons(std::move(car), std::move(cdr));
+      }
+
+      case TAG_ARRAY:
+      {
+        const uint32_t count = read_u32();
+        // Every value takes at least one byte
+        expect(count);
+        std::vector<sexp::Value> arr;
+        arr.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+          arr.push_back(read_value());
+        }
+        return sexp::Value::array(std::move(arr));
+      }
+
+      case TAG_BLOCK:
+      {
+        auto name = read_string();
+        const uint32_t count = read_u32();
+        expect(static_cast<size_t>(count) * 4);
+
+        std::vector<uint32_t> block(count);
+        for (auto& value : block) {
+          value = read_u32();
+        }
+
+        std::vector<sexp::Value> arr;
+        arr.push_back(sexp::Value::symbol(name));
+        arr.push_back(sexp::Value::symbol(CompiledDocument::BLOCK_SYMBOL));
+        arr.push_back(sexp::Value::integer(static_cast<int>(m_blocks.size())));
+        m_blocks.push_back(std::move(block));
+        return sexp::Value::array(std::move(arr));
+      }
+
+      default:
+        throw std::runtime_error("compiled document contains an unknown tag");
+    }
+  }
+
+  bool at_end() const { return m_pos == m_size; }
+
+private:
+  const unsigned char* m_data;
+  size_t m_size;
+  size_t m_pos;
+  std::vector<std::vector<uint32_t> >& m_blocks;
+
+private:
+  Decoder(const Decoder&) = delete;
+  Decoder& operator=(const Decoder&) = delete;
+};
+
+} // namespace
+
+namespace CompiledDocument {
+
+const char* const BLOCK_SYMBOL = "%compiled-block";
+
+std::string
+get_filename(const std::string& filename)
+{
+  return filename + "b";
+}
+
+void
+write(std::ostream& out, const sexp::Value& sx)
+{
+  out.write(MAGIC, sizeof(MAGIC));
+  write_u32(out, VERSION);
+  write_value(out, sx);
+}
+
+sexp::Value
+read(const char* data, size_t size, std::vector<std::vector<uint32_t> >& blocks)
+{
+  Decoder decoder(data, size, blocks);
+  decoder.read_header();
+  auto sx = decoder.read_value();
+  if (!decoder.at_end())
+    throw std::runtime_error("compiled document has trailing data");
+  return sx;
+}
+
+} // namespace CompiledDocument
+
+/* EOF */
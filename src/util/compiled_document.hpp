@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_COMPILED_DOCUMENT_HPP
+#define HEADER_SUPERTUX_UTIL_COMPILED_DOCUMENT_HPP
+
+#include <ostream>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace sexp {
+class Value;
+} // namespace sexp
+
+/**
+ * Binary form of a parsed document, used to load levels without
+ * running the S-Expression parser.
+ *
+ * The tree is stored as tagged values. Every `(tiles ...)` list of
+ * integers is stored as a raw little-endian uint32 block instead. When
+ * reading, such a list becomes `(tiles BLOCK_SYMBOL index)` and the
+ * data is appended to `blocks`. ReaderMapping resolves that form
+ * transparently through ReaderDocument::get_block().
+ */
+namespace CompiledDocument {
+
+extern const char* const BLOCK_SYMBOL;
+
+/** Returns the name of the compiled form of `filename` */
+std::string get_filename(const std::string& filename);
+
+void write(std::ostream& out, const sexp::Value& sx);
+
+/** Throws std::runtime_error on malformed data */
+sexp::Value read(const char* data, size_t size, std::vector<std::vector<uint32_t> >& blocks);
+
+} // namespace CompiledDocument
+
+#endif
+
+/* EOF */
@@ -0,0 +1,180 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/profiler.hpp"
+
+#ifdef ENABLE_PROFILER
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+Profiler g_profiler;
+
+const size_t Profiler::FRAME_COUNT;
+
+Profiler::Profiler() :
+  m_epoch(std::chrono::steady_clock::now()),
+  m_frames(FRAME_COUNT),
+  m_current(0),
+  m_frame_count(0),
+  m_in_frame(false),
+  m_depth(0)
+{
+}
+
+int64_t
+Profiler::now() const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - m_epoch).count();
+}
+
+void
+Profiler::begin_frame()
+{
+  assert(!m_in_frame);
+
+  Frame& frame = m_frames[m_current];
+  frame.zones.clear();
+  frame.start = now();
+  frame.end = frame.start;
+
+  m_in_frame = true;
+  m_depth = 0;
+}
+
+void
+Profiler::end_frame()
+{
+  if (!m_in_frame)
+    return;
+
+  m_frames[m_current].end = now();
+  m_in_frame = false;
+
+  m_current = (m_current + 1) % FRAME_COUNT;
+  if (m_frame_count < FRAME_COUNT)
+    m_frame_count += 1;
+}
+
+int
+Profiler::begin_zone(const char* name)
+{
+  if (!m_in_frame)
+    return -1;
+
+  auto& zones = m_frames[m_current].zones;
+  const int64_t start = now();
+  zones.push_back(Zone{ name, m_depth, start, start });
+  m_depth += 1;
+  return static_cast<int>(zones.size()) - 1;
+}
+
+void
+Profiler::end_zone(int zone)
+{
+  if (!m_in_frame || zone < 0)
+    return;
+
+  m_frames[m_current].zones[zone].end = now();
+  m_depth -= 1;
+}
+
+const Profiler::Frame&
+Profiler::get_frame(size_t age) const
+{
+  assert(age < m_frame_count);
+  return m_frames[(m_current + FRAME_COUNT - 1 - age) % FRAME_COUNT];
+}
+
+std::vector<Profiler::Summary>
+Profiler::get_summary() const
+{
+  std::vector<Summary> result;
+  if (m_frame_count == 0)
+    return result;
+
+  auto find = [&result](const char* name) -> Summary* {
+    for (auto& summary : result) {
+      if (summary.name == name || strcmp(summary.name, name) == 0)
+        return &summary;
+    }
+    return nullptr;
+  };
+
+  for (const auto& zone : get_frame(0).zones) {
+    Summary* summary = find(zone.name);
+    if (!summary) {
+      result.push_back(Summary{ zone.name, zone.depth, 0.0, 0.0 });
+      summary = &result.back();
+    }
+    summary->last_ms += static_cast<double>(zone.end - zone.start) / 1000000.0;
+  }
+
+  for (size_t age = 0; age < m_frame_count; ++age) {
+    for (const auto& zone : get_frame(age).zones) {
+      if (Summary* summary = find(zone.name))
+        summary->average_ms += static_cast<double>(zone.end - zone.start) / 1000000.0;
+    }
+  }
+
+  for (auto& summary : result) {
+    summary.average_ms /= static_cast<double>(m_frame_count);
+  }
+
+  return result;
+}
+
+void
+Profiler::write_chrome_trace(std::ostream& out) const
+{
+  out << "{\"traceEvents\":[";
+
+  bool first = true;
+  char buf[64];
+  for (size_t age = m_frame_count; age-- > 0;) {
+    for (const auto& zone : get_frame(age).zones) {
+      // Timestamps and durations are in microseconds
+      snprintf(buf, sizeof(buf), "\"ts\":%.3f,\"dur\":%.3f",
+               static_cast<double>(zone.start) / 1000.0,
+               static_cast<double>(zone.end - zone.start) / 1000.0);
+
+      out << (first ? "\n" : ",\n")
+          << "{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1," << buf << "}";
+      first = false;
+    }
+  }
+
+  out << "\n]}" << std::endl;
+}
+
+void
+Profiler::clear()
+{
+  for (auto& frame : m_frames)
+    frame.zones.clear();
+
+  m_current = 0;
+  m_frame_count = 0;
+  m_in_frame = false;
+  m_depth = 0;
+}
+
+#endif
+
+/* EOF */
@@ -0,0 +1,175 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_PROFILER_HPP
+#define HEADER_SUPERTUX_UTIL_PROFILER_HPP
+
+#include "config.h"
+
+#include <chrono>
+#include <ostream>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Frame profiler recording nested, named zones into a ring buffer of
+ * the most recent frames.
+ *
+ * Code is instrumented with the PROFILE_FRAME() and PROFILE_ZONE()
+ * macros. The profiler only exists if ENABLE_PROFILER is set, in
+ * regular builds the macros expand to nothing, so the instrumentation
+ * costs nothing.
+ */
+#ifdef ENABLE_PROFILER
+class Profiler final
+{
+public:
+  /** Number of frames kept in the ring buffer */
+  static const size_t FRAME_COUNT = 120;
+
+  struct Zone
+  {
+    /** Static string, zones are compared by name */
+    const char* name;
+    int depth;
+
+    /** Nanoseconds since the creation of the profiler */
+    int64_t start;
+    int64_t end;
+  };
+
+  struct Frame
+  {
+    int64_t start;
+    int64_t end;
+
+    /** Zones in the order they were entered */
+    std::vector<Zone> zones;
+  };
+
+  /** Time spent in all zones of one name */
+  struct Summary
+  {
+    const char* name;
+    int depth;
+
+    /** Milliseconds in the last frame and averaged over all frames */
+    double last_ms;
+    double average_ms;
+  };
+
+public:
+  Profiler();
+
+  void begin_frame();
+  void end_frame();
+
+  /** Returns a handle for end_zone(), zones outside of a frame are
+      not recorded. */
+  int begin_zone(const char* name);
+  void end_zone(int zone);
+
+  /** Number of complete frames in the ring buffer */
+  size_t get_frame_count() const { return m_frame_count; }
+
+  /** Returns a complete frame, 0 being the most recent one */
+  const Frame& get_frame(size_t age) const;
+
+  /** Per-name totals in order of first appearance in the last frame */
+  std::vector<Summary> get_summary() const;
+
+  /** Writes all recorded frames in the Chrome trace event format, as
+      read by chrome://tracing and Perfetto */
+  void write_chrome_trace(std::ostream& out) const;
+
+  void clear();
+
+private:
+  int64_t now() const;
+
+private:
+  const std::chrono::steady_clock::time_point m_epoch;
+  std::vector<Frame> m_frames;
+
+  /** Slot of the frame being recorded */
+  size_t m_current;
+  size_t m_frame_count;
+  bool m_in_frame;
+  int m_depth;
+
+private:
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+};
+
+extern Profiler g_profiler;
+
+class ProfilerZone final
+{
+public:
+  ProfilerZone(const char* name) :
+    m_zone(g_profiler.begin_zone(name))
+  {}
+
+  ~ProfilerZone()
+  {
+    g_profiler.end_zone(m_zone);
+  }
+
+private:
+  int m_zone;
+
+private:
+  ProfilerZone(const ProfilerZone&) = delete;
+  ProfilerZone& operator=(const ProfilerZone&) = delete;
+};
+
+/** Scope of a whole frame, which is also its outermost zone */
+class ProfilerFrame final
+{
+public:
+  ProfilerFrame(const char* name) :
+    m_zone((g_profiler.begin_frame(), g_profiler.begin_zone(name)))
+  {}
+
+  ~ProfilerFrame()
+  {
+    g_profiler.end_zone(m_zone);
+    g_profiler.end_frame();
+  }
+
+private:
+  int m_zone;
+
+private:
+  ProfilerFrame(const ProfilerFrame&) = delete;
+  ProfilerFrame& operator=(const ProfilerFrame&) = delete;
+};
+
+#  define PROFILER_CONCAT2(a, b) a ## b
+#  define PROFILER_CONCAT(a, b) PROFILER_CONCAT2(a, b)
+#  define PROFILE_FRAME(name) ProfilerFrame PROFILER_CONCAT(profiler_frame_, __LINE__)(name)
+#  define PROFILE_ZONE(name) ProfilerZone PROFILER_CONCAT(profiler_zone_, __LINE__)(name)
+#else
+#  define PROFILE_FRAME(name)
+#  define PROFILE_ZONE(name)
+#endif
+
+#endif
+
+/* EOF */
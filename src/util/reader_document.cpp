@@ -16,10 +16,13 @@
 
 #include "util/reader_document.hpp"
 
+#include <algorithm>
+#include <physfs.h>
 #include <sexp/parser.hpp>
 #include <sstream>
 
 #include "physfs/ifile_stream.hpp"
+#include "util/compiled_document.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 
@@ -45,10 +48,72 @@ ReaderDocument::from_file(const std::string& filename)
   }
 }
 
+ReaderDocument
+ReaderDocument::from_compiled_file(const std::string& filename)
+{
+  log_debug << "ReaderDocument::from_compiled_file: " << filename << std::endl;
+
+  PHYSFS_File* file = PHYSFS_openRead(filename.c_str());
+  if (!file) {
+    std::stringstream msg;
+    msg << "Parser problem: Couldn't open file '" << filename << "'.";
+    throw std::runtime_error(msg.str());
+  }
+
+  // Read the whole file at once, the blocks are decoded straight from it
+  std::string data(static_cast<size_t>(std::max<PHYSFS_sint64>(0, PHYSFS_fileLength(file))), '\0');
+  const PHYSFS_sint64 size = PHYSFS_readBytes(file, &data[0], data.size());
+  PHYSFS_close(file);
+  if (size != static_cast<PHYSFS_sint64>(data.size())) {
+    std::stringstream msg;
+    msg << "Parser problem: Couldn't read file '" << filename << "'.";
+    throw std::runtime_error(msg.str());
+  }
+
+  return from_compiled_data(data, filename);
+}
+
+ReaderDocument
+ReaderDocument::from_compiled_data(const std::string& data, const std::string& filename)
+{
+  std::vector<std::vector<uint32_t> > blocks;
+  sexp::Value sx = CompiledDocument::read(data.data(), data.size(), blocks);
+
+  ReaderDocument doc(filename, std::move(sx));
+  doc.m_blocks = std::move(blocks);
+  return doc;
+}
+
 ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::move(sx)),
+  m_blocks()
+{
+}
+
+void
+ReaderDocument::save_compiled(std::ostream& out) const
+{
+  CompiledDocument::write(out, m_sx);
+}
+
+const std::vector<uint32_t>*
+ReaderDocument::get_block(const sexp::Value& item) const
 {
+  if (m_blocks.empty() || !item.is_array())
+    return nullptr;
+
+  const auto& arr = item.as_array();
+  if (arr.size() != 3 ||
+      !arr[1].is_symbol() || arr[1].as_string() != CompiledDocument::BLOCK_SYMBOL ||
+      !arr[2].is_integer())
+    return nullptr;
+
+  const int index = arr[2].as_int();
+  if (index < 0 || index >= static_cast<int>(m_blocks.size()))
+    return nullptr;
+
+  return &m_blocks[index];
 }
 
 ReaderObject
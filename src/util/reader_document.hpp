@@ -19,6 +19,8 @@
 
 #include <istream>
 #include <sexp/value.hpp>
+#include <stdint.h>
+#include <vector>
 
 #include "util/reader_object.hpp"
 
@@ -30,6 +32,10 @@ public:
   static ReaderDocument from_stream(std::istream& stream, const std::string& filename = "<stream>");
   static ReaderDocument from_file(const std::string& filename);
 
+  /** Loads a document written by save_compiled(), see CompiledDocument */
+  static ReaderDocument from_compiled_file(const std::string& filename);
+  static ReaderDocument from_compiled_data(const std::string& data, const std::string& filename = "<stream>");
+
 public:
   ReaderDocument(const std::string& filename, sexp::Value sx);
 
@@ -44,9 +50,19 @@ public:
 
   const sexp::Value& get_sexp() const { return m_sx; }
 
+  /** Writes the document in the binary form of CompiledDocument */
+  void save_compiled(std::ostream& out) const;
+
+  /** If `item` is a (key ...) list that was loaded from a compiled
+      block, returns the values of the list, nullptr otherwise */
+  const std::vector<uint32_t>* get_block(const sexp::Value& item) const;
+
 private:
   std::string m_filename;
   sexp::Value m_sx;
+
+  /** Integer lists of compiled documents */
+  std::vector<std::vector<uint32_t> > m_blocks;
 };
 
 #endif
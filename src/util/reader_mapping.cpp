@@ -16,6 +16,7 @@
 
 #include "util/reader_mapping.hpp"
 
+#include <algorithm>
 #include <boost/ref.hpp>
 #include <boost/utility/typed_in_place_factory.hpp>
 #include <sexp/io.hpp>
@@ -32,7 +33,9 @@ bool ReaderMapping::s_translations_enabled = true;
 ReaderMapping::ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx) :
   m_doc(doc),
   m_sx(sx),
-  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}())
+  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}()),
+  m_index_built(false),
+  m_index()
 {
 }
 
@@ -44,9 +47,51 @@ ReaderMapping::get_iter() const
   return ReaderIterator(m_doc, m_sx);
 }
 
+void
+ReaderMapping::build_index() const
+{
+  m_index_built = true;
+
+  m_index.reserve(m_arr.size() - 1);
+  for (size_t i = 1; i < m_arr.size(); ++i)
+  {
+    auto const& pair = m_arr[i];
+    if (!pair.is_array() || pair.as_array().empty() || !pair.as_array()[0].is_symbol())
+    {
+      m_index.clear();
+      return;
+    }
+    m_index.push_back(IndexEntry{ &pair.as_array()[0].as_string(), i });
+  }
+
+  // stable, so that the first of duplicate keys still wins
+  std::stable_sort(m_index.begin(), m_index.end(),
+                   [](const IndexEntry& lhs, const IndexEntry& rhs) {
+                     return *lhs.key < *rhs.key;
+                   });
+}
+
 const sexp::Value*
 ReaderMapping::get_item(const char* key) const
 {
+  if (m_arr.size() > INDEX_MIN_SIZE)
+  {
+    if (!m_index_built)
+      build_index();
+
+    if (!m_index.empty())
+    {
+      auto it = std::lower_bound(m_index.begin(), m_index.end(), key,
+                                 [](const IndexEntry& entry, const char* k) {
+                                   return entry.key->compare(k) < 0;
+                                 });
+      if (it != m_index.end() && it->key->compare(key) == 0)
+        return &m_arr[it->pos];
+      else
+        return nullptr;
+    }
+  }
+
   for (size_t i = 1; i < m_arr.size(); ++i)
   {
     auto const& pair = m_arr[i];
@@ -187,6 +232,15 @@ bool
 ReaderMapping::get(const char* key, std::vector<unsigned int>& value) const
 {
   value.clear();
+
+  // Lists of compiled documents are stored outside of the sexp tree
+  if (auto const sx = get_item(key)) {
+    if (auto const block = m_doc.get_block(*sx)) {
+      value.assign(block->begin(), block->end());
+      return true;
+    }
+  }
+
   GET_VALUES_MACRO("unsigned int", is_integer, as_int)
 }
 
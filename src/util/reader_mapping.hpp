@@ -18,6 +18,8 @@
 #define HEADER_SUPERTUX_UTIL_READER_MAPPING_HPP
 
 #include <boost/optional.hpp>
+#include <string>
+#include <vector>
 
 #include "util/reader_iterator.hpp"
 
@@ -82,14 +84,32 @@ public:
   const sexp::Value& get_sexp() const { return m_sx; }
   const ReaderDocument& get_doc() const { return m_doc; }
 
+private:
+  /** Mappings with more keys than this are looked up through m_index */
+  static const size_t INDEX_MIN_SIZE = 16;
+
+  struct IndexEntry
+  {
+    const std::string* key;
+    size_t pos;
+  };
+
 private:
   /** Returns pointer to (key value) */
   const sexp::Value* get_item(const char* key) const;
 
+  void build_index() const;
+
 private:
   const ReaderDocument& m_doc;
   const sexp::Value& m_sx;
   const std::vector<sexp::Value>& m_arr;
+
+  /** Keys of m_arr sorted by name, built on the first lookup. Left
+      empty for malformed mappings, get_item() then falls back to the
+      linear search, which reports the error. */
+  mutable bool m_index_built;
+  mutable std::vector<IndexEntry> m_index;
 };
 
 #endif
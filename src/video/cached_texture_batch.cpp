@@ -0,0 +1,45 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/cached_texture_batch.hpp"
+
+CachedTextureBatch::CachedTextureBatch() :
+  m_srcrects(),
+  m_dstrects(),
+  m_repeats(),
+  m_painter_data()
+{
+}
+
+void
+CachedTextureBatch::clear()
+{
+  m_srcrects.clear();
+  m_dstrects.clear();
+  m_repeats.clear();
+  m_painter_data.reset();
+}
+
+void
+CachedTextureBatch::add(const Rectf& srcrect, const Rectf& dstrect, const Size& repeat)
+{
+  m_srcrects.push_back(srcrect);
+  m_dstrects.push_back(dstrect);
+  m_repeats.push_back(repeat);
+  m_painter_data.reset();
+}
+
+/* EOF */
@@ -0,0 +1,76 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_CACHED_TEXTURE_BATCH_HPP
+#define HEADER_SUPERTUX_VIDEO_CACHED_TEXTURE_BATCH_HPP
+
+#include <memory>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "math/size.hpp"
+
+/** Quads of a single texture that stay the same over many frames.
+    The destination rectangles are relative to an origin given at draw
+    time, so the painter can keep the vertices it generated from them
+    (on the GPU where possible) until the batch is changed. */
+class CachedTextureBatch final
+{
+public:
+  /** Painter specific data generated from the batch */
+  class PainterData
+  {
+  public:
+    PainterData() {}
+    virtual ~PainterData() {}
+
+  private:
+    PainterData(const PainterData&) = delete;
+    PainterData& operator=(const PainterData&) = delete;
+  };
+
+public:
+  CachedTextureBatch();
+
+  /** Both drop the painter data */
+  void clear();
+  void add(const Rectf& srcrect, const Rectf& dstrect, const Size& repeat = Size(1, 1));
+
+  bool empty() const { return m_srcrects.empty(); }
+  size_t size() const { return m_srcrects.size(); }
+
+  const std::vector<Rectf>& get_srcrects() const { return m_srcrects; }
+  const std::vector<Rectf>& get_dstrects() const { return m_dstrects; }
+  const std::vector<Size>& get_repeats() const { return m_repeats; }
+
+  PainterData* get_painter_data() const { return m_painter_data.get(); }
+  void set_painter_data(std::unique_ptr<PainterData> data) const { m_painter_data = std::move(data); }
+
+private:
+  std::vector<Rectf> m_srcrects;
+  std::vector<Rectf> m_dstrects;
+  std::vector<Size> m_repeats;
+
+  mutable std::unique_ptr<PainterData> m_painter_data;
+
+private:
+  CachedTextureBatch(const CachedTextureBatch&) = delete;
+  CachedTextureBatch& operator=(const CachedTextureBatch&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -17,20 +17,37 @@
 #include "video/canvas.hpp"
 
 #include <algorithm>
+#include <assert.h>
+#include <memory>
 
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "video/cached_texture_batch.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
+#include "video/render_stats.hpp"
 #include "video/renderer.hpp"
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Offset of surface relative source rectangles on the texture */
+Vector region_offset(const Surface& surface)
+{
+  const Rect region = surface.get_region();
+  return Vector(static_cast<float>(region.left), static_cast<float>(region.top));
+}
+
+} // namespace
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_sorter(),
+  m_sorted_size(0)
 {
   m_requests.reserve(500);
 }
@@ -48,32 +65,67 @@ Canvas::clear()
     request->~DrawingRequest();
   }
   m_requests.clear();
+  m_sorted_size = 0;
 }
 
 void
 Canvas::render(Renderer& renderer, Filter filter)
 {
   // On a regular level, each frame has around 50-250 requests (before
-  // batching it was 1000-3000), the sort comparator function is
-  // called approximatly 3-7 times for each request.
-  std::stable_sort(m_requests.begin(), m_requests.end(),
-                   [](const DrawingRequest* r1, const DrawingRequest* r2){
-                     return r1->layer < r2->layer;
-                   });
+  // batching it was 1000-3000), but particle heavy levels can have a
+  // lot more.
+  if (m_sorted_size != m_requests.size())
+  {
+    m_sorter.sort(m_requests);
+    m_sorted_size = m_requests.size();
+  }
 
   Painter& painter = renderer.get_painter();
 
-  for (const auto& i : m_requests) {
-    const DrawingRequest& request = *i;
+  for (size_t i = 0; i < m_requests.size(); ++i) {
+    const DrawingRequest& request = *m_requests[i];
 
-    if (filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP)
-      continue;
-    else if (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP)
+    if (!filter_accepts(filter, request))
       continue;
 
+    g_render_stats.frame.requests += 1;
+
     switch (request.type) {
       case TEXTURE:
-        painter.draw_texture(static_cast<const TextureRequest&>(request));
+      {
+        // Adjacent requests that only differ in their quads are drawn
+        // with a single call. Only neighbours are merged, so the order
+        // in which the quads are drawn stays the same.
+        const auto& texture_request = static_cast<const TextureRequest&>(request);
+
+        size_t end = i + 1;
+        while (end < m_requests.size() &&
+               filter_accepts(filter, *m_requests[end]) &&
+               RequestSorter::can_merge(texture_request, *m_requests[end]))
+        {
+          ++end;
+        }
+
+        if (end - i == 1)
+        {
+          painter.draw_texture(texture_request);
+        }
+        else
+        {
+          TextureRequest* merged = merge_texture_requests(i, end);
+          painter.draw_texture(*merged);
+          merged->~TextureRequest();
+
+          const int merged_count = static_cast<int>(end - i - 1);
+          g_render_stats.frame.requests += merged_count;
+          g_render_stats.frame.merged_requests += merged_count;
+          i = end - 1;
+        }
+        break;
+      }
+
+      case CACHED_TEXTURE:
+        painter.draw_cached_texture(static_cast<const CachedTextureRequest&>(request));
         break;
 
       case GRADIENT:
@@ -103,6 +155,46 @@ Canvas::render(Renderer& renderer, Filter filter)
   }
 }
 
+bool
+Canvas::filter_accepts(Filter filter, const DrawingRequest& request)
+{
+  if (filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP)
+    return false;
+  else if (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP)
+    return false;
+  else
+    return true;
+}
+
+TextureRequest*
+Canvas::merge_texture_requests(size_t begin, size_t end)
+{
+  const auto& first = static_cast<const TextureRequest&>(*m_requests[begin]);
+
+  auto merged = new(m_obst) TextureRequest();
+
+  merged->layer = first.layer;
+  merged->flip = first.flip;
+  merged->alpha = first.alpha;
+  merged->blend = first.blend;
+  merged->texture = first.texture;
+  merged->displacement_texture = first.displacement_texture;
+  merged->color = first.color;
+
+  size_t size = 0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    size += static_cast<const TextureRequest&>(*m_requests[i]).srcrects.size();
+  }
+
+  concat_in_obstack(merged->srcrects, &TextureRequest::srcrects, begin, end, size);
+  concat_in_obstack(merged->dstrects, &TextureRequest::dstrects, begin, end, size);
+  concat_in_obstack(merged->angles, &TextureRequest::angles, begin, end, size);
+  concat_in_obstack(merged->repeats, &TextureRequest::repeats, begin, end, size);
+
+  return merged;
+}
+
 void
 Canvas::draw_surface(const SurfacePtr& surface,
                      const Vector& position, float angle, const Color& color, const Blend& blend,
@@ -127,12 +219,12 @@ Canvas::draw_surface(const SurfacePtr& surface,
   request->alpha = m_context.transform().alpha;
   request->blend = blend;
 
-  request->srcrects.emplace_back(Rectf(surface->get_region()));
-  request->dstrects.emplace_back(Rectf(apply_translate(position) * scale(),
-                                 Sizef(static_cast<float>(surface->get_width()) * scale(),
-                                       static_cast<float>(surface->get_height()) * scale())));
-  request->angles.emplace_back(angle);
-  request->repeats.emplace_back(Size(1, 1));
+  request->srcrects.set(Rectf(surface->get_region()));
+  request->dstrects.set(Rectf(apply_translate(position) * scale(),
+                              Sizef(static_cast<float>(surface->get_width()) * scale(),
+                                    static_cast<float>(surface->get_height()) * scale())));
+  request->angles.set(angle);
+  request->repeats.set(Size(1, 1));
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = color;
@@ -168,10 +260,10 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
   request->alpha = m_context.transform().alpha * style.get_alpha();
   request->blend = style.get_blend();
 
-  request->srcrects.emplace_back(srcrect);
-  request->dstrects.emplace_back(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
-  request->angles.emplace_back(0.0f);
-  request->repeats.emplace_back(Size(1, 1));
+  request->srcrects.set(srcrect.moved(region_offset(*surface)));
+  request->dstrects.set(Rectf(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale()));
+  request->angles.set(0.0f);
+  request->repeats.set(Size(1, 1));
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = style.get_color();
@@ -186,12 +278,7 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
                            const Color& color,
                            int layer)
 {
-  const size_t len = srcrects.size();
-  draw_surface_batch(surface,
-                     std::move(srcrects),
-                     std::move(dstrects),
-                     std::vector<float>(len, 0.0f),
-                     color, layer);
+  push_surface_batch(surface, srcrects, dstrects, nullptr, nullptr, color, layer);
 }
 
 void
@@ -202,13 +289,7 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
                            const Color& color,
                            int layer)
 {
-  const size_t len = srcrects.size();
-  draw_surface_batch(surface,
-                     std::move(srcrects),
-                     std::move(dstrects),
-                     std::move(angles),
-                     std::vector<Size>(len, Size(1, 1)),
-                     color, layer);
+  push_surface_batch(surface, srcrects, dstrects, &angles, nullptr, color, layer);
 }
 
 void
@@ -219,13 +300,7 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
                            const Color& color,
                            int layer)
 {
-  const size_t len = srcrects.size();
-  draw_surface_batch(surface,
-                     std::move(srcrects),
-                     std::move(dstrects),
-                     std::vector<float>(len, 0.0f),
-                     std::move(repeats),
-                     color, layer);
+  push_surface_batch(surface, srcrects, dstrects, nullptr, &repeats, color, layer);
 }
 
 void
@@ -236,9 +311,25 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
                            std::vector<Size> repeats,
                            const Color& color,
                            int layer)
+{
+  push_surface_batch(surface, srcrects, dstrects, &angles, &repeats, color, layer);
+}
+
+void
+Canvas::push_surface_batch(const SurfacePtr& surface,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
+                           const std::vector<float>* angles,
+                           const std::vector<Size>* repeats,
+                           const Color& color,
+                           int layer)
 {
   if (!surface) return;
 
+  assert(srcrects.size() == dstrects.size());
+  assert(!angles || angles->size() == srcrects.size());
+  assert(!repeats || repeats->size() == srcrects.size());
+
   auto request = new(m_obst) TextureRequest();
 
   request->type = TEXTURE;
@@ -247,10 +338,29 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   request->alpha = m_context.transform().alpha;
   request->color = color;
 
-  request->srcrects = std::move(srcrects);
-  request->dstrects = std::move(dstrects);
-  request->angles = std::move(angles);
-  request->repeats = std::move(repeats);
+  const size_t len = srcrects.size();
+
+  copy_to_obstack(request->srcrects, srcrects.data(), len);
+  copy_to_obstack(request->dstrects, dstrects.data(), len);
+
+  if (angles)
+    copy_to_obstack(request->angles, angles->data(), len);
+  else
+    fill_in_obstack(request->angles, 0.0f, len);
+
+  if (repeats)
+    copy_to_obstack(request->repeats, repeats->data(), len);
+  else
+    fill_in_obstack(request->repeats, Size(1, 1), len);
+
+  const Vector offset = region_offset(*surface);
+  if (offset.x != 0.0f || offset.y != 0.0f)
+  {
+    for (auto& srcrect : request->srcrects)
+    {
+      srcrect = srcrect.moved(offset);
+    }
+  }
 
   for (auto& dstrect : request->dstrects)
   {
@@ -263,6 +373,81 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   m_requests.push_back(request);
 }
 
+template<typename T>
+void
+Canvas::copy_to_obstack(RequestArray<T>& array, const T* data, size_t size)
+{
+  if (size == 1)
+  {
+    array.set(data[0]);
+  }
+  else if (size > 1)
+  {
+    T* copy = static_cast<T*>(obstack_alloc(&m_obst, static_cast<int>(sizeof(T) * size)));
+    std::uninitialized_copy(data, data + size, copy);
+    array.set_span(copy, size);
+  }
+}
+
+template<typename T>
+void
+Canvas::fill_in_obstack(RequestArray<T>& array, const T& value, size_t size)
+{
+  if (size == 1)
+  {
+    array.set(value);
+  }
+  else if (size > 1)
+  {
+    T* data = static_cast<T*>(obstack_alloc(&m_obst, static_cast<int>(sizeof(T) * size)));
+    std::uninitialized_fill_n(data, size, value);
+    array.set_span(data, size);
+  }
+}
+
+template<typename T>
+void
+Canvas::concat_in_obstack(RequestArray<T>& array, RequestArray<T> TextureRequest::*member,
+                          size_t begin, size_t end, size_t size)
+{
+  T* data = static_cast<T*>(obstack_alloc(&m_obst, static_cast<int>(sizeof(T) * size)));
+
+  T* out = data;
+  for (size_t i = begin; i < end; ++i)
+  {
+    const RequestArray<T>& source = static_cast<const TextureRequest&>(*m_requests[i]).*member;
+    out = std::uninitialized_copy(source.begin(), source.end(), out);
+  }
+
+  array.set_span(data, size);
+}
+
+void
+Canvas::draw_cached_batch(const SurfacePtr& surface,
+                          const CachedTextureBatch& batch,
+                          const Vector& origin,
+                          const Color& color,
+                          int layer)
+{
+  if (!surface || batch.empty()) return;
+
+  auto request = new(m_obst) CachedTextureRequest();
+
+  request->layer = layer;
+  request->flip = m_context.transform().flip ^ surface->get_flip();
+  request->alpha = m_context.transform().alpha;
+  request->color = color;
+
+  request->batch = &batch;
+  request->translation = apply_translate(origin) * scale();
+  request->scale = scale();
+
+  request->texture = surface->get_texture().get();
+  request->displacement_texture = surface->get_displacement_texture().get();
+
+  m_requests.push_back(request);
+}
+
 void
 Canvas::draw_text(const FontPtr& font, const std::string& text,
                   const Vector& pos, FontAlignment alignment, int layer, const Color& color)
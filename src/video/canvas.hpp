@@ -34,11 +34,15 @@
 #include "video/gradient.hpp"
 #include "video/layer.hpp"
 #include "video/paint_style.hpp"
+#include "video/request_sorter.hpp"
 
+class CachedTextureBatch;
 class DrawingContext;
 class Renderer;
 class VideoSystem;
 struct DrawingRequest;
+struct TextureRequest;
+template<typename T> class RequestArray;
 
 class Canvas final
 {
@@ -52,6 +56,8 @@ public:
   void draw_surface(const SurfacePtr& surface, const Vector& position, int layer);
   void draw_surface(const SurfacePtr& surface, const Vector& position, float angle, const Color& color, const Blend& blend,
                     int layer);
+  /** The source rectangles of draw_surface_part() and
+      draw_surface_batch() are relative to the surface's region */
   void draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const Rectf& dstrect,
                          int layer, const PaintStyle& style = PaintStyle());
   void draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
@@ -80,6 +86,16 @@ public:
                           std::vector<Size> repeats,
                           const Color& color,
                           int layer);
+  /** Draws a batch whose vertices are kept by the painter between
+      frames, `origin` is added to all its destination rectangles.
+      Its source rectangles are texture coordinates, as returned by
+      Surface::get_region().
+      The batch must stay alive until the canvas got rendered. */
+  void draw_cached_batch(const SurfacePtr& surface,
+                         const CachedTextureBatch& batch,
+                         const Vector& origin,
+                         const Color& color,
+                         int layer);
   void draw_text(const FontPtr& font, const std::string& text,
                  const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
@@ -107,11 +123,42 @@ private:
   Vector apply_translate(const Vector& pos) const;
   float scale() const;
 
+  void push_surface_batch(const SurfacePtr& surface,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
+                          const std::vector<float>* angles,
+                          const std::vector<Size>* repeats,
+                          const Color& color,
+                          int layer);
+
+  /** Request arrays with more than one element live in the obstack */
+  template<typename T>
+  void copy_to_obstack(RequestArray<T>& array, const T* data, size_t size);
+  template<typename T>
+  void fill_in_obstack(RequestArray<T>& array, const T& value, size_t size);
+
+  /** Concatenates `member` of the TextureRequests [begin, end) */
+  template<typename T>
+  void concat_in_obstack(RequestArray<T>& array, RequestArray<T> TextureRequest::*member,
+                         size_t begin, size_t end, size_t size);
+
+  static bool filter_accepts(Filter filter, const DrawingRequest& request);
+
+  /** Combines the TextureRequests [begin, end) of m_requests into a
+      single request allocated in the obstack */
+  TextureRequest* merge_texture_requests(size_t begin, size_t end);
+
 private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
 
+  /** Requests are only added between clear() calls, so m_requests is
+      still sorted when its size didn't change since the last sort.
+      This spares sorting again for the second pass of the Compositor. */
+  RequestSorter m_sorter;
+  size_t m_sorted_size;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
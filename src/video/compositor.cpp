@@ -18,8 +18,10 @@
 #include "video/compositor.hpp"
 
 #include "math/rect.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
+#include "video/render_stats.hpp"
 #include "video/renderer.hpp"
 #include "video/video_system.hpp"
 
@@ -49,6 +51,8 @@ Compositor::make_context(bool overlay)
 void
 Compositor::render()
 {
+  PROFILE_ZONE("Compositor::render");
+
   auto& lightmap = m_video_system.get_lightmap();
 
   bool use_lightmap = std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
@@ -122,12 +126,12 @@ Compositor::render()
         request.alpha = 1.0f;
         request.blend = Blend::MOD;
 
-        request.srcrects.emplace_back(0.0f, 0.0f,
-                                      static_cast<float>(texture->get_image_width()),
-                                      static_cast<float>(texture->get_image_height()));
-        request.dstrects.emplace_back(Vector(0.0f, 0.0f), lightmap.get_logical_size());
-        request.angles.emplace_back(0.0f);
-        request.repeats.emplace_back(Size(1, 1));
+        request.srcrects.set(Rectf(0.0f, 0.0f,
+                                   static_cast<float>(texture->get_image_width()),
+                                   static_cast<float>(texture->get_image_height())));
+        request.dstrects.set(Rectf(Vector(0.0f, 0.0f), lightmap.get_logical_size()));
+        request.angles.set(0.0f);
+        request.repeats.set(Size(1, 1));
 
         request.texture = texture.get();
         request.color = Color::WHITE;
@@ -154,6 +158,8 @@ Compositor::render()
   }
   m_video_system.flip();
 
+  g_render_stats.next_frame();
+
   obstack_free(&m_obst, nullptr);
   obstack_init(&m_obst);
 }
@@ -26,12 +26,14 @@
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 #include "video/font.hpp"
+#include "video/request_array.hpp"
 
+class CachedTextureBatch;
 class Surface;
 
 enum RequestType
 {
-  TEXTURE, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE
+  TEXTURE, CACHED_TEXTURE, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE
 };
 
 struct DrawingRequest
@@ -69,10 +71,10 @@ struct TextureRequest : public DrawingRequest
 
   const Texture* texture;
   const Texture* displacement_texture;
-  std::vector<Rectf> srcrects;
-  std::vector<Rectf> dstrects;
-  std::vector<float> angles;
-  std::vector<Size> repeats;
+  RequestArray<Rectf> srcrects;
+  RequestArray<Rectf> dstrects;
+  RequestArray<float> angles;
+  RequestArray<Size> repeats;
   Color color;
 
 private:
@@ -80,6 +82,34 @@ private:
   TextureRequest& operator=(const TextureRequest&) = delete;
 };
 
+struct CachedTextureRequest : public DrawingRequest
+{
+  CachedTextureRequest() :
+    DrawingRequest(CACHED_TEXTURE),
+    texture(),
+    displacement_texture(),
+    batch(),
+    translation(0.0f, 0.0f),
+    scale(1.0f),
+    color(1.0f, 1.0f, 1.0f)
+  {}
+
+  const Texture* texture;
+  const Texture* displacement_texture;
+  const CachedTextureBatch* batch;
+
+  /** Applied to the destination rectangles of the batch as
+      pos * scale + translation */
+  Vector translation;
+  float scale;
+
+  Color color;
+
+private:
+  CachedTextureRequest(const CachedTextureRequest&) = delete;
+  CachedTextureRequest& operator=(const CachedTextureRequest&) = delete;
+};
+
 struct GradientRequest : public DrawingRequest
 {
   GradientRequest()  :
@@ -20,6 +20,7 @@
 #include "video/glutil.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl_texture.hpp"
+#include "video/gl/gl_vertex_cache.hpp"
 
 #ifndef USE_OPENGLES2
 
@@ -81,6 +82,19 @@ GL20Context::blend_func(GLenum src, GLenum dst)
   assert_gl();
 }
 
+void
+GL20Context::set_model_transform(const Vector& translation, float scale)
+{
+  assert_gl();
+
+  glMatrixMode(GL_MODELVIEW);
+  glLoadIdentity();
+  glTranslatef(translation.x, translation.y, 0.0f);
+  glScalef(scale, scale, 1.0f);
+
+  assert_gl();
+}
+
 void
 GL20Context::set_positions(const float* data, size_t size)
 {
@@ -140,6 +154,14 @@ GL20Context::set_color(const Color& color)
   assert_gl();
 }
 
+void
+GL20Context::set_vertex_cache(GLVertexCache& cache)
+{
+  // No vertex buffers here, the client side arrays are used directly
+  set_positions(cache.get_positions().data(), sizeof(float) * cache.get_positions().size());
+  set_texcoords(cache.get_texcoords().data(), sizeof(float) * cache.get_texcoords().size());
+}
+
 void
 GL20Context::bind_texture(const Texture& texture, const Texture* displacement_texture)
 {
@@ -22,6 +22,7 @@
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_cache.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
@@ -108,6 +109,8 @@ GL33CoreContext::bind()
 
   glUniform1f(m_program->get_uniform_location(GLProgram::uniform_game_time), g_game_time);
 
+  set_model_transform(Vector(0.0f, 0.0f), 1.0f);
+
   assert_gl();
 }
 
@@ -144,6 +147,17 @@ GL33CoreContext::blend_func(GLenum src, GLenum dst)
   assert_gl();
 }
 
+void
+GL33CoreContext::set_model_transform(const Vector& translation, float scale)
+{
+  assert_gl();
+
+  glUniform2f(m_program->get_uniform_location(GLProgram::uniform_model_translation), translation.x, translation.y);
+  glUniform1f(m_program->get_uniform_location(GLProgram::uniform_model_scale), scale);
+
+  assert_gl();
+}
+
 void
 GL33CoreContext::set_positions(const float* data, size_t size)
 {
@@ -180,6 +194,15 @@ GL33CoreContext::set_color(const Color& color)
   m_vertex_arrays->set_color(color);
 }
 
+void
+GL33CoreContext::set_vertex_cache(GLVertexCache& cache)
+{
+  cache.upload();
+  m_vertex_arrays->set_buffers(cache.get_positions_buffer(),
+                               cache.get_texcoords_buffer(),
+                               cache.get_texcoords_repeat_buffer());
+}
+
 void
 GL33CoreContext::bind_texture(const Texture& texture, const Texture* displacement_texture)
 {
@@ -40,6 +40,8 @@ public:
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
+  virtual void set_model_transform(const Vector& translation, float scale) override;
+
   virtual void set_positions(const float* data, size_t size) override;
 
   virtual void set_texcoords(const float* data, size_t size) override;
@@ -49,6 +51,8 @@ public:
   virtual void set_colors(const float* data, size_t size) override;
   virtual void set_color(const Color& color) override;
 
+  virtual void set_vertex_cache(GLVertexCache& cache) override;
+
   virtual void bind_texture(const Texture& texture, const Texture* displacement_texture) override;
   virtual void bind_no_texture() override;
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) override;
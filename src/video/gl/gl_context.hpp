@@ -20,10 +20,12 @@
 #include <stddef.h>
 #include <string>
 
+#include "math/vector.hpp"
 #include "video/gl.hpp"
 
 class Color;
 class GLTexture;
+class GLVertexCache;
 class Texture;
 
 class GLContext
@@ -40,6 +42,10 @@ public:
 
   virtual void blend_func(GLenum src, GLenum dst) = 0;
 
+  /** Transforms all positions as pos * scale + translation, the
+      default is the identity */
+  virtual void set_model_transform(const Vector& translation, float scale) = 0;
+
   virtual void set_positions(const float* data, size_t size) = 0;
 
   virtual void set_texcoords(const float* data, size_t size) = 0;
@@ -49,6 +55,9 @@ public:
   virtual void set_colors(const float* data, size_t size) = 0;
   virtual void set_color(const Color& color) = 0;
 
+  /** Sets positions and texture coordinates from cached vertices */
+  virtual void set_vertex_cache(GLVertexCache& cache) = 0;
+
   virtual void bind_texture(const Texture& texture, const Texture* displacement_texture) = 0;
   virtual void bind_no_texture() = 0;
 
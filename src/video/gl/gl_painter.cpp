@@ -21,6 +21,7 @@
 
 #include "math/util.hpp"
 #include "supertux/globals.hpp"
+#include "video/cached_texture_batch.hpp"
 #include "video/drawing_request.hpp"
 #include "video/gl/gl_context.hpp"
 #include "video/gl/gl_pixel_request.hpp"
@@ -28,8 +29,10 @@
 #include "video/gl/gl_renderer.hpp"
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_cache.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
+#include "video/render_stats.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -69,46 +72,43 @@ GLPainter::GLPainter(GLVideoSystem& video_system, GLRenderer& renderer) :
 }
 
 void
-GLPainter::draw_texture(const TextureRequest& request)
+GLPainter::expand_quads(const GLTexture& texture, Flip flip, size_t count,
+                        const Rectf* srcrects,
+                        const Rectf* dstrects,
+                        const float* angles,
+                        const Size* repeats)
 {
-  assert_gl();
-
-  const auto& texture = static_cast<const GLTexture&>(*request.texture);
-
-  assert(request.srcrects.size() == request.dstrects.size());
-  assert(request.srcrects.size() == request.angles.size());
-
   m_vertices.clear();
   m_uvs.clear();
   m_uvs_repeat.clear();
 
-  m_vertices.reserve(request.srcrects.size() * 12);
-  m_uvs.reserve(request.srcrects.size() * 12);
-  m_uvs_repeat.reserve(request.srcrects.size() * 24);
+  m_vertices.reserve(count * 12);
+  m_uvs.reserve(count * 12);
+  m_uvs_repeat.reserve(count * 24);
 
-  for (size_t i = 0; i < request.srcrects.size(); ++i)
+  for (size_t i = 0; i < count; ++i)
   {
-    const float left = request.dstrects[i].get_left();
-    const float top = request.dstrects[i].get_top();
-    const float right  = request.dstrects[i].get_left() + request.dstrects[i].get_width() * static_cast<float>(request.repeats[i].width);
-    const float bottom = request.dstrects[i].get_top() + request.dstrects[i].get_height() * static_cast<float>(request.repeats[i].height);
+    const float left = dstrects[i].get_left();
+    const float top = dstrects[i].get_top();
+    const float right  = dstrects[i].get_left() + dstrects[i].get_width() * static_cast<float>(repeats[i].width);
+    const float bottom = dstrects[i].get_top() + dstrects[i].get_height() * static_cast<float>(repeats[i].height);
 
     float uv_left = 0.0f;
     float uv_top = 0.0f;
-    float uv_right = request.srcrects[i].get_width() * static_cast<float>(request.repeats[i].width) / static_cast<float>(texture.get_texture_width());
-    float uv_bottom = request.srcrects[i].get_height() * static_cast<float>(request.repeats[i].height) / static_cast<float>(texture.get_texture_height());
-    float uv_left_start = request.srcrects[i].get_left() / static_cast<float>(texture.get_texture_width());
-    float uv_top_start = request.srcrects[i].get_top() / static_cast<float>(texture.get_texture_height());
-    float uv_left_step = request.srcrects[i].get_width() / static_cast<float>(texture.get_texture_width());
-    float uv_top_step = request.srcrects[i].get_height() / static_cast<float>(texture.get_texture_height());
-
-    if (request.flip & HORIZONTAL_FLIP)
+    float uv_right = srcrects[i].get_width() * static_cast<float>(repeats[i].width) / static_cast<float>(texture.get_texture_width());
+    float uv_bottom = srcrects[i].get_height() * static_cast<float>(repeats[i].height) / static_cast<float>(texture.get_texture_height());
+    float uv_left_start = srcrects[i].get_left() / static_cast<float>(texture.get_texture_width());
+    float uv_top_start = srcrects[i].get_top() / static_cast<float>(texture.get_texture_height());
+    float uv_left_step = srcrects[i].get_width() / static_cast<float>(texture.get_texture_width());
+    float uv_top_step = srcrects[i].get_height() / static_cast<float>(texture.get_texture_height());
+
+    if (flip & HORIZONTAL_FLIP)
       std::swap(uv_left, uv_right);
 
-    if (request.flip & VERTICAL_FLIP)
+    if (flip & VERTICAL_FLIP)
       std::swap(uv_top, uv_bottom);
 
-    if (request.angles[i] == 0.0f)
+    if (!angles || angles[i] == 0.0f)
     {
       auto vertices_lst = {
         left, top,
@@ -127,8 +127,8 @@ GLPainter::draw_texture(const TextureRequest& request)
       const float center_x = (left + right) / 2;
       const float center_y = (top + bottom) / 2;
 
-      const float sa = sinf(math::radians(request.angles[i]));
-      const float ca = cosf(math::radians(request.angles[i]));
+      const float sa = sinf(math::radians(angles[i]));
+      const float ca = cosf(math::radians(angles[i]));
 
       const float new_left = left - center_x;
       const float new_right = right - center_x;
@@ -170,6 +170,23 @@ GLPainter::draw_texture(const TextureRequest& request)
     };
     m_uvs_repeat.insert(m_uvs_repeat.end(), std::begin(uvs_repeat_lst), std::end(uvs_repeat_lst));
   }
+}
+
+void
+GLPainter::draw_texture(const TextureRequest& request)
+{
+  assert_gl();
+
+  const auto& texture = static_cast<const GLTexture&>(*request.texture);
+
+  assert(request.srcrects.size() == request.dstrects.size());
+  assert(request.srcrects.size() == request.angles.size());
+  assert(request.srcrects.size() == request.repeats.size());
+
+  expand_quads(texture, request.flip, request.srcrects.size(),
+               request.srcrects.data(), request.dstrects.data(),
+               request.angles.data(), request.repeats.data());
+  g_render_stats.frame.expanded_quads += static_cast<int>(request.srcrects.size());
 
   GLContext& context = m_video_system.get_context();
 
@@ -188,6 +205,58 @@ GLPainter::draw_texture(const TextureRequest& request)
   assert_gl();
 }
 
+void
+GLPainter::draw_cached_texture(const CachedTextureRequest& request)
+{
+  assert_gl();
+
+  const auto& texture = static_cast<const GLTexture&>(*request.texture);
+  const CachedTextureBatch& batch = *request.batch;
+
+  auto cache = static_cast<GLVertexCache*>(batch.get_painter_data());
+  if (!cache || !cache->is_valid_for(texture, request.flip))
+  {
+    expand_quads(texture, request.flip, batch.size(),
+                 batch.get_srcrects().data(), batch.get_dstrects().data(),
+                 nullptr, batch.get_repeats().data());
+    g_render_stats.frame.expanded_quads += static_cast<int>(batch.size());
+    g_render_stats.frame.cached_uploads += 1;
+
+    // The arrays are moved into the cache, the next draw_texture()
+    // call has to grow fresh ones
+    std::unique_ptr<GLVertexCache> new_cache(new GLVertexCache(texture, request.flip,
+                                                               std::move(m_vertices),
+                                                               std::move(m_uvs),
+                                                               std::move(m_uvs_repeat)));
+    m_vertices.clear();
+    m_uvs.clear();
+    m_uvs_repeat.clear();
+
+    cache = new_cache.get();
+    batch.set_painter_data(std::move(new_cache));
+  }
+
+  g_render_stats.frame.cached_requests += 1;
+  g_render_stats.frame.cached_quads += static_cast<int>(batch.size());
+
+  GLContext& context = m_video_system.get_context();
+
+  context.blend_func(sfactor(request.blend), dfactor(request.blend));
+  context.bind_texture(texture, request.displacement_texture);
+  context.set_vertex_cache(*cache);
+  context.set_color(Color(request.color.red,
+                          request.color.green,
+                          request.color.blue,
+                          request.color.alpha * request.alpha));
+  context.set_model_transform(request.translation, request.scale);
+
+  context.draw_arrays(GL_TRIANGLES, 0, cache->get_vertex_count());
+
+  context.set_model_transform(Vector(0.0f, 0.0f), 1.0f);
+
+  assert_gl();
+}
+
 void
 GLPainter::draw_gradient(const GradientRequest& request)
 {
@@ -19,10 +19,15 @@
 
 #include "video/painter.hpp"
 
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "math/size.hpp"
 #include "video/flip.hpp"
 
 enum class Blend;
 class GLRenderer;
+class GLTexture;
 class GLVideoSystem;
 
 class GLPainter final : public Painter
@@ -31,6 +36,7 @@ public:
   GLPainter(GLVideoSystem& video_system, GLRenderer& renderer);
 
   virtual void draw_texture(const TextureRequest& request) override;
+  virtual void draw_cached_texture(const CachedTextureRequest& request) override;
   virtual void draw_gradient(const GradientRequest& request) override;
   virtual void draw_filled_rect(const FillRectRequest& request) override;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) override;
@@ -43,6 +49,15 @@ public:
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
 
+private:
+  /** Fills m_vertices, m_uvs and m_uvs_repeat with two triangles per
+      quad, `angles` may be nullptr when no quad is rotated */
+  void expand_quads(const GLTexture& texture, Flip flip, size_t count,
+                    const Rectf* srcrects,
+                    const Rectf* dstrects,
+                    const float* angles,
+                    const Size* repeats);
+
 private:
   GLVideoSystem& m_video_system;
   GLRenderer& m_renderer;
@@ -73,6 +73,8 @@ GLProgram::GLProgram() :
   m_uniforms[uniform_framebuffer_texture] = get_uniform_location("framebuffer_texture");
   m_uniforms[uniform_game_time] = get_uniform_location("game_time");
   m_uniforms[uniform_modelviewprojection] = get_uniform_location("modelviewprojection");
+  m_uniforms[uniform_model_translation] = get_uniform_location("model_translation");
+  m_uniforms[uniform_model_scale] = get_uniform_location("model_scale");
   m_uniforms[uniform_animate] = get_uniform_location("animate");
   m_uniforms[uniform_displacement_animate] = get_uniform_location("displacement_animate");
 }
@@ -52,6 +52,8 @@ public:
     uniform_framebuffer_texture,
     uniform_game_time,
     uniform_modelviewprojection,
+    uniform_model_translation,
+    uniform_model_scale,
     uniform_animate,
     uniform_displacement_animate,
     uniform_max
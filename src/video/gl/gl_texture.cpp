@@ -188,6 +188,38 @@ GLTexture::GLTexture(const SDL_Surface& image, const Sampler& sampler) :
   assert_gl();
 }
 
+void
+GLTexture::update(const SDL_Surface& image, int x, int y)
+{
+  SDLSurfacePtr convert = SDLSurface::create_rgba(image.w, image.h);
+
+  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), nullptr, convert.get(), nullptr);
+
+  assert_gl();
+
+  glBindTexture(GL_TEXTURE_2D, m_handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#if defined(GL_UNPACK_ROW_LENGTH) || defined(USE_GLBINDING)
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, convert->pitch/convert->format->BytesPerPixel);
+#else
+  assert(convert->pitch == static_cast<int>(convert->w * convert->format->BytesPerPixel));
+#endif
+
+  if (SDL_MUSTLOCK(convert)) {
+    SDL_LockSurface(convert.get());
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, convert->w, convert->h,
+                  GL_RGBA, GL_UNSIGNED_BYTE, convert->pixels);
+
+  if (SDL_MUSTLOCK(convert)) {
+    SDL_UnlockSurface(convert.get());
+  }
+
+  assert_gl();
+}
+
 GLTexture::~GLTexture()
 {
   glDeleteTextures(1, &m_handle);
@@ -148,4 +148,29 @@ GLVertexArrays::set_color(const Color& color)
   assert_gl();
 }
 
+void
+GLVertexArrays::set_buffers(GLuint positions, GLuint texcoords, GLuint texcoords_repeat)
+{
+  assert_gl();
+
+  const GLProgram& program = m_context.get_program();
+
+  int loc = program.get_attrib_location(GLProgram::attrib_position);
+  glBindBuffer(GL_ARRAY_BUFFER, positions);
+  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  loc = program.get_attrib_location(GLProgram::attrib_texcoord);
+  glBindBuffer(GL_ARRAY_BUFFER, texcoords);
+  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  loc = program.get_attrib_location(GLProgram::attrib_texcoord_repeat);
+  glBindBuffer(GL_ARRAY_BUFFER, texcoords_repeat);
+  glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  assert_gl();
+}
+
 /* EOF */
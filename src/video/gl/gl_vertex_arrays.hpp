@@ -42,6 +42,10 @@ public:
   void set_colors(const float* data, size_t size);
   void set_color(const Color& color);
 
+  /** Sources positions and texture coordinates from buffers owned by
+      someone else, see GLVertexCache */
+  void set_buffers(GLuint positions, GLuint texcoords, GLuint texcoords_repeat);
+
 private:
   GL33CoreContext& m_context;
   GLuint m_vao;
@@ -0,0 +1,114 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/gl/gl_vertex_cache.hpp"
+
+#include "video/glutil.hpp"
+#include "video/texture.hpp"
+
+std::unordered_set<GLVertexCache*> GLVertexCache::s_caches;
+
+void
+GLVertexCache::release_all()
+{
+  for (auto* cache : s_caches)
+    cache->release();
+}
+
+GLVertexCache::GLVertexCache(const Texture& texture, Flip flip,
+                             std::vector<float> positions,
+                             std::vector<float> texcoords,
+                             std::vector<float> texcoords_repeat) :
+  m_texture_id(texture.get_id()),
+  m_texture_width(texture.get_texture_width()),
+  m_texture_height(texture.get_texture_height()),
+  m_flip(flip),
+  m_vertex_count(static_cast<GLsizei>(positions.size() / 2)),
+  m_positions(std::move(positions)),
+  m_texcoords(std::move(texcoords)),
+  m_texcoords_repeat(std::move(texcoords_repeat)),
+  m_uploaded(false),
+  m_positions_buffer(),
+  m_texcoords_buffer(),
+  m_texcoords_repeat_buffer()
+{
+  s_caches.insert(this);
+}
+
+GLVertexCache::~GLVertexCache()
+{
+  release();
+  s_caches.erase(this);
+}
+
+void
+GLVertexCache::release()
+{
+  if (m_uploaded)
+  {
+    glDeleteBuffers(1, &m_positions_buffer);
+    glDeleteBuffers(1, &m_texcoords_buffer);
+    glDeleteBuffers(1, &m_texcoords_repeat_buffer);
+    m_uploaded = false;
+  }
+
+  // Never valid again, the batch generates a new cache on the next draw
+  m_texture_id = 0;
+  m_positions = std::vector<float>();
+  m_texcoords = std::vector<float>();
+  m_texcoords_repeat = std::vector<float>();
+}
+
+bool
+GLVertexCache::is_valid_for(const Texture& texture, Flip flip) const
+{
+  // The texture size is part of the texture coordinates
+  return (m_texture_id == texture.get_id() &&
+          m_texture_width == texture.get_texture_width() &&
+          m_texture_height == texture.get_texture_height() &&
+          m_flip == flip);
+}
+
+void
+GLVertexCache::upload()
+{
+  if (m_uploaded) return;
+
+  assert_gl();
+
+  glGenBuffers(1, &m_positions_buffer);
+  glGenBuffers(1, &m_texcoords_buffer);
+  glGenBuffers(1, &m_texcoords_repeat_buffer);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_positions_buffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_positions.size(), m_positions.data(), GL_STATIC_DRAW);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_texcoords.size(), m_texcoords.data(), GL_STATIC_DRAW);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_repeat_buffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_texcoords_repeat.size(), m_texcoords_repeat.data(), GL_STATIC_DRAW);
+
+  m_positions = std::vector<float>();
+  m_texcoords = std::vector<float>();
+  m_texcoords_repeat = std::vector<float>();
+
+  m_uploaded = true;
+
+  assert_gl();
+}
+
+/* EOF */
@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_GL_GL_VERTEX_CACHE_HPP
+#define HEADER_SUPERTUX_VIDEO_GL_GL_VERTEX_CACHE_HPP
+
+#include <stdint.h>
+#include <unordered_set>
+#include <vector>
+
+#include "video/cached_texture_batch.hpp"
+#include "video/flip.hpp"
+#include "video/gl.hpp"
+
+class Texture;
+
+/** Vertices the GLPainter generated for a CachedTextureBatch. They
+    stay in client side arrays for contexts without vertex buffers,
+    upload() moves them into vertex buffers. */
+class GLVertexCache final : public CachedTextureBatch::PainterData
+{
+public:
+  GLVertexCache(const Texture& texture, Flip flip,
+                std::vector<float> positions,
+                std::vector<float> texcoords,
+                std::vector<float> texcoords_repeat);
+  ~GLVertexCache() override;
+
+  /** Frees the vertex buffers of all caches and makes them invalid,
+      called by the video system while its GL context is still current,
+      right before destroying it */
+  static void release_all();
+
+  /** Whether the vertices were generated for the given state */
+  bool is_valid_for(const Texture& texture, Flip flip) const;
+
+  /** Moves the vertices into static vertex buffers and frees the
+      client side arrays, does nothing when that already happened */
+  void upload();
+  bool is_uploaded() const { return m_uploaded; }
+
+  GLsizei get_vertex_count() const { return m_vertex_count; }
+
+  const std::vector<float>& get_positions() const { return m_positions; }
+  const std::vector<float>& get_texcoords() const { return m_texcoords; }
+  const std::vector<float>& get_texcoords_repeat() const { return m_texcoords_repeat; }
+
+  GLuint get_positions_buffer() const { return m_positions_buffer; }
+  GLuint get_texcoords_buffer() const { return m_texcoords_buffer; }
+  GLuint get_texcoords_repeat_buffer() const { return m_texcoords_repeat_buffer; }
+
+private:
+  void release();
+
+private:
+  static std::unordered_set<GLVertexCache*> s_caches;
+
+private:
+  /** Texture::get_id() of the texture, 0 once the cache was released */
+  uint64_t m_texture_id;
+  int m_texture_width;
+  int m_texture_height;
+  Flip m_flip;
+
+  GLsizei m_vertex_count;
+  std::vector<float> m_positions;
+  std::vector<float> m_texcoords;
+  std::vector<float> m_texcoords_repeat;
+
+  bool m_uploaded;
+  GLuint m_positions_buffer;
+  GLuint m_texcoords_buffer;
+  GLuint m_texcoords_repeat_buffer;
+
+private:
+  GLVertexCache(const GLVertexCache&) = delete;
+  GLVertexCache& operator=(const GLVertexCache&) = delete;
+};
+
+#endif
+
+/* EOF */
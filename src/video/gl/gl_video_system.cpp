@@ -29,6 +29,7 @@
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_cache.hpp"
 #include "video/glutil.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture_manager.hpp"
@@ -86,6 +87,8 @@ GLVideoSystem::GLVideoSystem(bool use_opengl33core) :
 
 GLVideoSystem::~GLVideoSystem()
 {
+  // Batches kept by game objects can outlive the context
+  GLVertexCache::release_all();
   SDL_GL_DeleteContext(m_glcontext);
 }
 
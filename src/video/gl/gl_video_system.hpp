@@ -49,6 +49,10 @@ public:
 
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler) override;
 
+  /** Only the GL33 shader handles texture coordinates and repeats
+      within a region of the texture */
+  virtual bool supports_texture_atlas() const override { return m_use_opengl33core; }
+
   virtual const Viewport& get_viewport() const override { return m_viewport; }
   virtual void apply_config() override;
   virtual void flip() override;
@@ -0,0 +1,160 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/image_decode_queue.hpp"
+
+#include "util/log.hpp"
+#include "video/sdl_surface.hpp"
+
+namespace {
+
+SDLSurfacePtr decode(const std::string& filename)
+{
+  try
+  {
+    return SDLSurface::from_file(filename);
+  }
+  catch(const std::exception& err)
+  {
+    log_debug << "Couldn't decode '" << filename << "' in the background: " << err.what() << std::endl;
+    return SDLSurfacePtr();
+  }
+}
+
+} // namespace
+
+ImageDecodeQueue::ImageDecodeQueue() :
+  m_mutex(),
+  m_work_cond(),
+  m_done_cond(),
+  m_queue(),
+  m_jobs(),
+  m_next_id(0),
+  m_quit(false),
+  m_thread()
+{
+  m_thread = std::thread(&ImageDecodeQueue::run, this);
+}
+
+ImageDecodeQueue::~ImageDecodeQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_work_cond.notify_all();
+  m_thread.join();
+}
+
+void
+ImageDecodeQueue::prefetch(const std::string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_jobs.find(filename) != m_jobs.end())
+      return;
+
+    Job& job = m_jobs[filename];
+    job.state = State::QUEUED;
+    job.id = m_next_id++;
+    m_queue.push_back(filename);
+  }
+  m_work_cond.notify_one();
+}
+
+SDLSurfacePtr
+ImageDecodeQueue::take(const std::string& filename)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  auto it = m_jobs.find(filename);
+  if (it == m_jobs.end())
+    return SDLSurfacePtr();
+
+  if (it->second.state == State::QUEUED)
+  {
+    // The worker skips queue entries without a job
+    m_jobs.erase(it);
+    lock.unlock();
+    return decode(filename);
+  }
+
+  const unsigned int id = it->second.id;
+  m_done_cond.wait(lock, [this, &filename, id]{
+      auto job = m_jobs.find(filename);
+      return job == m_jobs.end() || job->second.id != id || job->second.state == State::DONE;
+    });
+
+  it = m_jobs.find(filename);
+  if (it == m_jobs.end() || it->second.id != id)
+    return SDLSurfacePtr();
+
+  SDLSurfacePtr surface = std::move(it->second.surface);
+  m_jobs.erase(it);
+  return surface;
+}
+
+void
+ImageDecodeQueue::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_queue.clear();
+  m_jobs.clear();
+}
+
+size_t
+ImageDecodeQueue::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_jobs.size();
+}
+
+void
+ImageDecodeQueue::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_work_cond.wait(lock, [this]{ return m_quit || !m_queue.empty(); });
+    if (m_quit)
+      return;
+
+    const std::string filename = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    auto it = m_jobs.find(filename);
+    if (it == m_jobs.end() || it->second.state != State::QUEUED)
+      continue;
+
+    it->second.state = State::DECODING;
+    const unsigned int id = it->second.id;
+
+    lock.unlock();
+    SDLSurfacePtr surface = decode(filename);
+    lock.lock();
+
+    it = m_jobs.find(filename);
+    if (it != m_jobs.end() && it->second.id == id)
+    {
+      it->second.surface = std::move(surface);
+      it->second.state = State::DONE;
+    }
+    m_done_cond.notify_all();
+  }
+}
+
+/* EOF */
@@ -0,0 +1,89 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_IMAGE_DECODE_QUEUE_HPP
+#define HEADER_SUPERTUX_VIDEO_IMAGE_DECODE_QUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "video/sdl_surface_ptr.hpp"
+
+/** Decodes image files on a worker thread ahead of time. Only the
+    decoding happens in the background, the decoded images are turned
+    into textures by the TextureManager on the main thread. */
+class ImageDecodeQueue final
+{
+private:
+  enum class State { QUEUED, DECODING, DONE };
+
+  struct Job
+  {
+    State state;
+
+    /** Distinguishes a job from an earlier one for the same file that
+        got dropped by clear() while it was being decoded */
+    unsigned int id;
+
+    SDLSurfacePtr surface;
+  };
+
+public:
+  ImageDecodeQueue();
+  ~ImageDecodeQueue();
+
+  /** Queues `filename` for decoding, does nothing if it is queued already */
+  void prefetch(const std::string& filename);
+
+  /** Returns the decoded image of a prefetched file, waiting for the
+      worker if it is currently decoding it. Files the worker didn't
+      start on yet are decoded right away on the calling thread.
+      Returns nullptr if the file wasn't prefetched or failed to decode. */
+  SDLSurfacePtr take(const std::string& filename);
+
+  /** Drops all queued and decoded images */
+  void clear();
+
+  size_t size() const;
+
+private:
+  void run();
+
+private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_work_cond;
+  std::condition_variable m_done_cond;
+
+  std::deque<std::string> m_queue;
+  std::unordered_map<std::string, Job> m_jobs;
+  unsigned int m_next_id;
+  bool m_quit;
+
+  std::thread m_thread;
+
+private:
+  ImageDecodeQueue(const ImageDecodeQueue&) = delete;
+  ImageDecodeQueue& operator=(const ImageDecodeQueue&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -33,6 +33,12 @@ NullPainter::draw_texture(const TextureRequest& request)
   log_info << "NullPainter::draw_texture()" << std::endl;
 }
 
+void
+NullPainter::draw_cached_texture(const CachedTextureRequest& request)
+{
+  log_info << "NullPainter::draw_cached_texture()" << std::endl;
+}
+
 void
 NullPainter::draw_gradient(const GradientRequest& request)
 {
@@ -23,6 +23,7 @@
 #include "video/color.hpp"
 
 class Rect;
+struct CachedTextureRequest;
 struct DrawingRequest;
 struct FillRectRequest;
 struct GetPixelRequest;
@@ -40,6 +41,7 @@ public:
   virtual ~Painter() {}
 
   virtual void draw_texture(const TextureRequest& request) = 0;
+  virtual void draw_cached_texture(const CachedTextureRequest& request) = 0;
   virtual void draw_gradient(const GradientRequest& request) = 0;
   virtual void draw_filled_rect(const FillRectRequest& request) = 0;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) = 0;
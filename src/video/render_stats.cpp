@@ -0,0 +1,43 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/render_stats.hpp"
+
+#include "util/allocation_counter.hpp"
+
+RenderStats g_render_stats;
+
+RenderStats::RenderStats() :
+  frame(),
+  m_last_frame(),
+  m_frame_start_allocations(0)
+{
+}
+
+void
+RenderStats::next_frame()
+{
+#ifdef ENABLE_ALLOCATION_COUNTER
+  const size_t allocations = get_allocation_count();
+  frame.allocations = static_cast<int>(allocations - m_frame_start_allocations);
+  m_frame_start_allocations = allocations;
+#endif
+
+  m_last_frame = frame;
+  frame = Counters();
+}
+
+/* EOF */
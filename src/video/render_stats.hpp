@@ -0,0 +1,80 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_RENDER_STATS_HPP
+#define HEADER_SUPERTUX_VIDEO_RENDER_STATS_HPP
+
+#include <stddef.h>
+
+/** Counters of the drawing code, collected over one frame and shown
+    by the render statistics overlay */
+class RenderStats final
+{
+public:
+  struct Counters
+  {
+    /** Requests rendered by the Canvas */
+    int requests;
+
+    /** Requests that were drawn together with the previous one */
+    int merged_requests;
+
+    /** Quads the painter had to turn into vertices this frame */
+    int expanded_quads;
+
+    /** Requests and quads drawn from cached geometry */
+    int cached_requests;
+    int cached_quads;
+
+    /** Cached geometry that had to be (re)built and uploaded */
+    int cached_uploads;
+
+    /** Heap allocations over the whole frame, see get_allocation_count(),
+        only counted with ENABLE_ALLOCATION_COUNTER */
+    int allocations;
+
+    /** Game objects drawn and skipped for being outside of the view
+        by GameObjectManager::draw() */
+    int drawn_objects;
+    int culled_objects;
+  };
+
+public:
+  RenderStats();
+
+  /** Moves the counters of the current frame to get_last_frame() and
+      resets them */
+  void next_frame();
+
+  const Counters& get_last_frame() const { return m_last_frame; }
+
+public:
+  Counters frame;
+
+private:
+  Counters m_last_frame;
+  size_t m_frame_start_allocations;
+
+private:
+  RenderStats(const RenderStats&) = delete;
+  RenderStats& operator=(const RenderStats&) = delete;
+};
+
+extern RenderStats g_render_stats;
+
+#endif
+
+/* EOF */
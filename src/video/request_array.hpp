@@ -0,0 +1,84 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_REQUEST_ARRAY_HPP
+#define HEADER_SUPERTUX_VIDEO_REQUEST_ARRAY_HPP
+
+#include <assert.h>
+#include <stddef.h>
+#include <type_traits>
+
+/** Elements of a DrawingRequest. A single element is stored inline,
+    larger arrays are only referenced and usually live in the obstack of
+    the Canvas, so creating and destroying a request never touches the
+    heap. */
+template<typename T>
+class RequestArray final
+{
+  static_assert(std::is_trivially_destructible<T>::value,
+                "RequestArray elements are never destroyed");
+
+public:
+  RequestArray() :
+    m_data(&m_inline),
+    m_size(0),
+    m_inline()
+  {}
+
+  /** Stores a single element inline */
+  void set(const T& value)
+  {
+    m_inline = value;
+    m_data = &m_inline;
+    m_size = 1;
+  }
+
+  /** Refers to `size` elements owned by someone else, they have to
+      outlive the request */
+  void set_span(T* data, size_t size)
+  {
+    assert(data || size == 0);
+    m_data = data;
+    m_size = size;
+  }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  T* data() { return m_data; }
+  const T* data() const { return m_data; }
+
+  T& operator[](size_t i) { assert(i < m_size); return m_data[i]; }
+  const T& operator[](size_t i) const { assert(i < m_size); return m_data[i]; }
+
+  T* begin() { return m_data; }
+  T* end() { return m_data + m_size; }
+  const T* begin() const { return m_data; }
+  const T* end() const { return m_data + m_size; }
+
+private:
+  T* m_data;
+  size_t m_size;
+  T m_inline;
+
+private:
+  RequestArray(const RequestArray&) = delete;
+  RequestArray& operator=(const RequestArray&) = delete;
+};
+
+#endif
+
+/* EOF */
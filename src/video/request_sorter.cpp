@@ -0,0 +1,191 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/request_sorter.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+
+#include "math/rectf.hpp"
+#include "video/drawing_request.hpp"
+
+namespace {
+
+/** Unlike collision::intersects(), rectangles that only touch don't
+    overlap, as no pixel is drawn by both */
+bool overlaps(const Rectf& r1, const Rectf& r2)
+{
+  return (r1.get_left() < r2.get_right() && r2.get_left() < r1.get_right() &&
+          r1.get_top() < r2.get_bottom() && r2.get_top() < r1.get_bottom());
+}
+
+Rectf unite(const Rectf& r1, const Rectf& r2)
+{
+  return Rectf(std::min(r1.get_left(), r2.get_left()),
+               std::min(r1.get_top(), r2.get_top()),
+               std::max(r1.get_right(), r2.get_right()),
+               std::max(r1.get_bottom(), r2.get_bottom()));
+}
+
+} // namespace
+
+RequestSorter::RequestSorter() :
+  m_counts(),
+  m_buffer()
+{
+}
+
+void
+RequestSorter::sort(std::vector<DrawingRequest*>& requests)
+{
+  sort_by_layer(requests);
+  group_textures(requests);
+}
+
+void
+RequestSorter::sort_by_layer(std::vector<DrawingRequest*>& requests)
+{
+  if (requests.size() < 2)
+    return;
+
+  const auto minmax = std::minmax_element(requests.begin(), requests.end(),
+                                          [](const DrawingRequest* r1, const DrawingRequest* r2) {
+                                            return r1->layer < r2->layer;
+                                          });
+  const int min_layer = (*minmax.first)->layer;
+  const int64_t range = static_cast<int64_t>((*minmax.second)->layer) - min_layer + 1;
+
+  if (range > MAX_COUNTING_RANGE)
+  {
+    std::stable_sort(requests.begin(), requests.end(),
+                     [](const DrawingRequest* r1, const DrawingRequest* r2) {
+                       return r1->layer < r2->layer;
+                     });
+    return;
+  }
+
+  // m_counts[layer + 1] counts the requests of a layer, the prefix sum
+  // then turns m_counts[layer] into the first index of the layer.
+  m_counts.assign(static_cast<size_t>(range) + 1, 0);
+  for (const auto* request : requests)
+    m_counts[static_cast<size_t>(request->layer - min_layer) + 1] += 1;
+
+  for (size_t i = 1; i < m_counts.size(); ++i)
+    m_counts[i] += m_counts[i - 1];
+
+  m_buffer.resize(requests.size());
+  for (auto* request : requests)
+    m_buffer[m_counts[static_cast<size_t>(request->layer - min_layer)]++] = request;
+
+  requests.swap(m_buffer);
+}
+
+void
+RequestSorter::group_textures(std::vector<DrawingRequest*>& requests)
+{
+  const size_t count = requests.size();
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (requests[i]->type != TEXTURE)
+      continue;
+
+    const auto& first = static_cast<const TextureRequest&>(*requests[i]);
+
+    size_t group_end = i + 1;
+    while (group_end < count &&
+           requests[group_end]->layer == first.layer &&
+           can_merge(first, *requests[group_end]))
+    {
+      ++group_end;
+    }
+
+    // A request can be drawn before the ones it is moved over when it
+    // doesn't overlap any of them.
+    Rectf blocked;
+    size_t skipped = 0;
+    for (size_t j = group_end; j < count && requests[j]->layer == first.layer; ++j)
+    {
+      Rectf bounds;
+      if (!get_bounds(*requests[j], bounds))
+        break;
+
+      if (can_merge(first, *requests[j]) &&
+          (skipped == 0 || !overlaps(bounds, blocked)))
+      {
+        std::rotate(requests.begin() + group_end, requests.begin() + j, requests.begin() + j + 1);
+        ++group_end;
+      }
+      else
+      {
+        if (skipped == MAX_GROUPING_DISTANCE)
+          break;
+
+        blocked = (skipped == 0) ? bounds : unite(blocked, bounds);
+        skipped += 1;
+      }
+    }
+
+    i = group_end - 1;
+  }
+}
+
+bool
+RequestSorter::can_merge(const TextureRequest& request, const DrawingRequest& other)
+{
+  if (other.type != TEXTURE)
+    return false;
+
+  const auto& other_texture = static_cast<const TextureRequest&>(other);
+  return (request.texture == other_texture.texture &&
+          request.displacement_texture == other_texture.displacement_texture &&
+          request.blend == other_texture.blend &&
+          request.color == other_texture.color &&
+          request.alpha == other_texture.alpha &&
+          request.flip == other_texture.flip);
+}
+
+bool
+RequestSorter::get_bounds(const DrawingRequest& request, Rectf& bounds)
+{
+  if (request.type != TEXTURE)
+    return false;
+
+  const auto& texture_request = static_cast<const TextureRequest&>(request);
+  if (texture_request.dstrects.empty())
+    return false;
+
+  // Rotated quads reach out of their destination rectangle
+  for (const float angle : texture_request.angles)
+  {
+    if (angle != 0.0f)
+      return false;
+  }
+
+  // Repeated quads cover a multiple of their destination rectangle
+  for (size_t i = 0; i < texture_request.dstrects.size(); ++i)
+  {
+    const Rectf& dstrect = texture_request.dstrects[i];
+    const Size& repeat = texture_request.repeats[i];
+    const Rectf rect(dstrect.p1(), Sizef(dstrect.get_width() * static_cast<float>(repeat.width),
+                                         dstrect.get_height() * static_cast<float>(repeat.height)));
+    bounds = (i == 0) ? rect : unite(bounds, rect);
+  }
+  return true;
+}
+
+/* EOF */
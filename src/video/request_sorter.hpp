@@ -0,0 +1,72 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_REQUEST_SORTER_HPP
+#define HEADER_SUPERTUX_VIDEO_REQUEST_SORTER_HPP
+
+#include <stddef.h>
+#include <vector>
+
+class Rectf;
+struct DrawingRequest;
+struct TextureRequest;
+
+/**
+ * Brings the requests of a Canvas into drawing order.
+ *
+ * Requests are sorted by layer with a stable counting sort, so the
+ * requests of a layer keep the order in which they were made. Texture
+ * requests are then moved next to an earlier request of the same layer
+ * they can be merged with, as long as nothing drawn in between
+ * overlaps them, which doesn't change the rendered image.
+ */
+class RequestSorter final
+{
+public:
+  /** Layer ranges wider than this fall back to std::stable_sort() */
+  static const int MAX_COUNTING_RANGE = 65536;
+
+  /** Number of requests a texture request may be moved back over */
+  static const size_t MAX_GROUPING_DISTANCE = 16;
+
+public:
+  RequestSorter();
+
+  void sort(std::vector<DrawingRequest*>& requests);
+
+  void sort_by_layer(std::vector<DrawingRequest*>& requests);
+  void group_textures(std::vector<DrawingRequest*>& requests);
+
+  /** Whether `other` can be drawn in the same call as `request` */
+  static bool can_merge(const TextureRequest& request, const DrawingRequest& other);
+
+private:
+  /** Screen area covered by the request, false if it isn't known */
+  static bool get_bounds(const DrawingRequest& request, Rectf& bounds);
+
+private:
+  std::vector<size_t> m_counts;
+  std::vector<DrawingRequest*> m_buffer;
+
+private:
+  RequestSorter(const RequestSorter&) = delete;
+  RequestSorter& operator=(const RequestSorter&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -25,6 +25,7 @@
 #include "supertux/globals.hpp"
 #include "math/util.hpp"
 #include "util/log.hpp"
+#include "video/cached_texture_batch.hpp"
 #include "video/drawing_request.hpp"
 #include "video/renderer.hpp"
 #include "video/sdl/sdl_texture.hpp"
@@ -261,6 +262,41 @@ SDLPainter::draw_texture(const TextureRequest& request)
   }
 }
 
+void
+SDLPainter::draw_cached_texture(const CachedTextureRequest& request)
+{
+  // SDL_Renderer has no way to keep vertices around, so the batch is
+  // simply drawn like a regular request
+  const CachedTextureBatch& batch = *request.batch;
+
+  std::vector<Rectf> srcrects = batch.get_srcrects();
+  std::vector<Rectf> dstrects;
+  dstrects.reserve(batch.size());
+  for (const auto& dstrect : batch.get_dstrects())
+  {
+    dstrects.emplace_back(dstrect.p1() * request.scale + request.translation,
+                          dstrect.get_size() * request.scale);
+  }
+  std::vector<float> angles(batch.size(), 0.0f);
+  std::vector<Size> repeats = batch.get_repeats();
+
+  TextureRequest texture_request;
+  texture_request.layer = request.layer;
+  texture_request.flip = request.flip;
+  texture_request.alpha = request.alpha;
+  texture_request.blend = request.blend;
+  texture_request.texture = request.texture;
+  texture_request.displacement_texture = request.displacement_texture;
+  texture_request.color = request.color;
+
+  texture_request.srcrects.set_span(srcrects.data(), srcrects.size());
+  texture_request.dstrects.set_span(dstrects.data(), dstrects.size());
+  texture_request.angles.set_span(angles.data(), angles.size());
+  texture_request.repeats.set_span(repeats.data(), repeats.size());
+
+  draw_texture(texture_request);
+}
+
 void
 SDLPainter::draw_gradient(const GradientRequest& request)
 {
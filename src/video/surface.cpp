@@ -87,6 +87,21 @@ Surface::from_file(const std::string& filename, const boost::optional<Rect>& rec
   }
 }
 
+SurfacePtr
+Surface::from_file_atlased(const std::string& filename, const boost::optional<Rect>& rect)
+{
+  if (StringUtil::has_suffix(filename, ".surface"))
+  {
+    return from_file(filename, rect);
+  }
+  else
+  {
+    Rect region;
+    TexturePtr texture = TextureManager::current()->get_atlased(filename, rect, region);
+    return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP, filename));
+  }
+}
+
 Surface::Surface(const TexturePtr& diffuse_texture,
                  const TexturePtr& displacement_texture,
                  Flip flip, const std::string& filename) :
@@ -135,7 +150,7 @@ Surface::region(const Rect& rect) const
 {
   SurfacePtr surface(new Surface(m_diffuse_texture,
                                  m_displacement_texture,
-                                 rect,
+                                 rect.moved(m_region.left, m_region.top),
                                  m_flip));
   return surface;
 }
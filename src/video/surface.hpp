@@ -37,6 +37,10 @@ class Surface final
 public:
   static SurfacePtr from_texture(const TexturePtr& texture);
   static SurfacePtr from_file(const std::string& filename, const boost::optional<Rect>& rect = boost::none);
+
+  /** Like from_file(), but lets the TextureManager place plain images
+      on a shared atlas texture */
+  static SurfacePtr from_file_atlased(const std::string& filename, const boost::optional<Rect>& rect = boost::none);
   static SurfacePtr from_reader(const ReaderMapping& mapping, const boost::optional<Rect>& rect = boost::none, const std::string& filename = "");
 
 private:
@@ -46,6 +50,7 @@ private:
 public:
   ~Surface();
 
+  /** `rect` is relative to the region of this surface */
   SurfacePtr region(const Rect& rect) const;
   SurfacePtr clone(Flip flip = NO_FLIP) const;
 
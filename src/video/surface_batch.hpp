@@ -40,6 +40,8 @@ public:
   std::vector<float> move_angles() { return std::move(m_angles); }
 
   Color get_color() const { return m_color; }
+  const SurfacePtr& get_surface() const { return m_surface; }
+  bool empty() const { return m_dstrects.empty(); }
 
 private:
   SurfacePtr m_surface;
@@ -18,7 +18,10 @@
 
 #include "video/texture_manager.hpp"
 
+uint64_t Texture::s_next_id = 1;
+
 Texture::Texture() :
+  m_id(s_next_id++),
   m_cache_key()
 {
 }
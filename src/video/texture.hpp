@@ -17,6 +17,7 @@
 #ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_HPP
 #define HEADER_SUPERTUX_VIDEO_TEXTURE_HPP
 
+#include <stdint.h>
 #include <string>
 #include <tuple>
 #include <boost/optional.hpp>
@@ -24,6 +25,8 @@
 #include "math/rect.hpp"
 #include "video/flip.hpp"
 
+struct SDL_Surface;
+
 /** This class is a wrapper around a texture handle. It stores the
     texture width and height and provides convenience functions for
     uploading SDL_Surfaces into the texture. */
@@ -47,7 +50,18 @@ public:
   virtual int get_image_width() const = 0;
   virtual int get_image_height() const = 0;
 
+  /** Replaces the pixels starting at `x`, `y` with those of `image` */
+  virtual void update(const SDL_Surface& image, int x, int y) = 0;
+
+  /** Unique for every texture ever created, unlike its address, which
+      a later texture might reuse */
+  uint64_t get_id() const { return m_id; }
+
+private:
+  static uint64_t s_next_id;
+
 private:
+  uint64_t m_id;
   boost::optional<Key> m_cache_key;
 
 private:
@@ -0,0 +1,157 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_atlas.hpp"
+
+#include <SDL.h>
+#include <string.h>
+
+#include "video/sdl_surface.hpp"
+#include "video/texture.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+/** Fills the outer `padding` pixels of a 32bit surface with copies of
+    the pixels next to them */
+void extrude_edges(SDL_Surface& surface, int padding)
+{
+  if (SDL_MUSTLOCK(&surface)) {
+    SDL_LockSurface(&surface);
+  }
+
+  auto row = [&surface](int y) {
+    return reinterpret_cast<Uint32*>(static_cast<uint8_t*>(surface.pixels) + y * surface.pitch);
+  };
+
+  for (int y = padding; y < surface.h - padding; ++y)
+  {
+    Uint32* pixels = row(y);
+    for (int x = 0; x < padding; ++x)
+    {
+      pixels[x] = pixels[padding];
+      pixels[surface.w - 1 - x] = pixels[surface.w - 1 - padding];
+    }
+  }
+
+  // The copied rows already contain the extruded corners
+  for (int y = 0; y < padding; ++y)
+  {
+    memcpy(row(y), row(padding), surface.w * sizeof(Uint32));
+    memcpy(row(surface.h - 1 - y), row(surface.h - 1 - padding), surface.w * sizeof(Uint32));
+  }
+
+  if (SDL_MUSTLOCK(&surface)) {
+    SDL_UnlockSurface(&surface);
+  }
+}
+
+} // namespace
+
+TextureAtlas::TextureAtlas() :
+  m_pages()
+{
+}
+
+bool
+TextureAtlas::fits(int width, int height)
+{
+  return (width > 0 && height > 0 &&
+          width <= MAX_IMAGE_SIZE && height <= MAX_IMAGE_SIZE);
+}
+
+TexturePtr
+TextureAtlas::add(const SDL_Surface& image, const Rect& rect, Rect& region)
+{
+  if (!fits(rect.get_width(), rect.get_height()))
+    return TexturePtr();
+
+  const Size padded_size(rect.get_width() + 2 * PADDING,
+                         rect.get_height() + 2 * PADDING);
+
+  TexturePtr texture;
+  boost::optional<Rect> area;
+  for (auto& page : m_pages)
+  {
+    TexturePtr page_texture = page->texture.lock();
+    if (!page_texture)
+    {
+      // Nothing references the page anymore, start over
+      page->packer.clear();
+    }
+
+    area = page->packer.insert(padded_size);
+    if (area)
+    {
+      if (!page_texture)
+      {
+        page_texture = create_page_texture();
+        page->texture = page_texture;
+      }
+      texture = page_texture;
+      break;
+    }
+  }
+
+  if (!area)
+  {
+    m_pages.push_back(std::make_unique<Page>());
+    area = m_pages.back()->packer.insert(padded_size);
+    texture = create_page_texture();
+    m_pages.back()->texture = texture;
+  }
+
+  SDLSurfacePtr padded = SDLSurface::create_rgba(padded_size.width, padded_size.height);
+
+  SDL_Rect srcrect = rect.to_sdl();
+  SDL_Rect dstrect{PADDING, PADDING, rect.get_width(), rect.get_height()};
+  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &srcrect, padded.get(), &dstrect);
+  extrude_edges(*padded, PADDING);
+
+  texture->update(*padded, area->left, area->top);
+
+  region = Rect(area->left + PADDING, area->top + PADDING, rect.get_size());
+  return texture;
+}
+
+TexturePtr
+TextureAtlas::create_page_texture() const
+{
+  SDLSurfacePtr image = SDLSurface::create_rgba(PAGE_SIZE, PAGE_SIZE);
+  return VideoSystem::current()->new_texture(*image);
+}
+
+void
+TextureAtlas::debug_print(std::ostream& out) const
+{
+  out << "atlas:begin" << std::endl;
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const auto& page = *m_pages[i];
+    const bool in_use = !page.texture.expired();
+
+    out << "  page " << i
+        << " size:" << page.packer.get_size().width << "x" << page.packer.get_size().height
+        << " images:" << (in_use ? page.packer.get_rect_count() : 0)
+        << " fill:" << (in_use ? page.packer.get_fill() * 100.0f : 0.0f) << "%"
+        << (in_use ? "" : " unused") << std::endl;
+  }
+  out << "atlas:end" << std::endl;
+}
+
+/* EOF */
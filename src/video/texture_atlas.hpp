@@ -0,0 +1,85 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "video/texture_packer.hpp"
+#include "video/texture_ptr.hpp"
+
+class Texture;
+struct SDL_Surface;
+
+/** Collects small images on shared texture pages, so that sprites and
+    tiles drawn after each other end up using the same texture and can
+    be batched. A page is kept alive by the Surfaces referencing it and
+    is reused from scratch once all of them are gone. */
+class TextureAtlas final
+{
+public:
+  static const int PAGE_SIZE = 1024;
+
+  /** Images larger than this in either dimension get their own texture */
+  static const int MAX_IMAGE_SIZE = 256;
+
+  /** Border around each image, filled with copies of its edge pixels,
+      so that filtering doesn't pick up neighbouring images */
+  static const int PADDING = 1;
+
+private:
+  struct Page
+  {
+    Page() :
+      texture(),
+      packer(Size(PAGE_SIZE, PAGE_SIZE))
+    {}
+
+    std::weak_ptr<Texture> texture;
+    TexturePacker packer;
+  };
+
+public:
+  TextureAtlas();
+
+  static bool fits(int width, int height);
+
+  /** Copies `image` onto a page and returns the page texture, `region`
+      receives the area of the image on it. Returns nullptr if the image
+      is too large for the atlas. */
+  TexturePtr add(const SDL_Surface& image, const Rect& rect, Rect& region);
+
+  void debug_print(std::ostream& out) const;
+
+private:
+  TexturePtr create_page_texture() const;
+
+private:
+  std::vector<std::unique_ptr<Page> > m_pages;
+
+private:
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+};
+
+#endif
+
+/* EOF */
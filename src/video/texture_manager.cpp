@@ -22,12 +22,15 @@
 
 #include "math/rect.hpp"
 #include "physfs/physfs_sdl.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
+#include "video/image_decode_queue.hpp"
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture.hpp"
@@ -77,12 +80,19 @@ GLenum string2filter(const std::string& text)
 
 TextureManager::TextureManager() :
   m_image_textures(),
-  m_surfaces()
+  m_surfaces(),
+  m_surfaces_lru(),
+  m_surface_bytes(0),
+  m_atlas(),
+  m_atlas_entries(),
+  m_decode_queue()
 {
 }
 
 TextureManager::~TextureManager()
 {
+  m_decode_queue.reset();
+
   for (const auto& texture : m_image_textures)
   {
     if (!texture.second.expired())
@@ -91,7 +101,8 @@ TextureManager::~TextureManager()
     }
   }
   m_image_textures.clear();
-  m_surfaces.clear();
+  release_surfaces();
+  m_atlas_entries.clear();
 }
 
 TexturePtr
@@ -238,6 +249,91 @@ TextureManager::get(const std::string& _filename,
   return texture;
 }
 
+TexturePtr
+TextureManager::get_atlased(const std::string& _filename,
+                            const boost::optional<Rect>& rect,
+                            Rect& region)
+{
+  if (g_config->texture_atlas && VideoSystem::current()->supports_texture_atlas())
+  {
+    std::string filename = FileSystem::normalize(_filename);
+    Texture::Key key(filename, rect ? *rect : Rect());
+
+    auto i = m_atlas_entries.find(key);
+    if (i != m_atlas_entries.end())
+    {
+      TexturePtr texture = i->second.texture.lock();
+      if (texture)
+      {
+        region = i->second.region;
+        return texture;
+      }
+    }
+
+    TexturePtr texture = create_atlas_texture(filename, rect, region);
+    if (texture)
+    {
+      m_atlas_entries[key] = AtlasEntry{texture, region};
+      return texture;
+    }
+  }
+
+  TexturePtr texture = get(_filename, rect);
+  region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+  return texture;
+}
+
+TexturePtr
+TextureManager::create_atlas_texture(const std::string& filename, const boost::optional<Rect>& rect, Rect& region)
+{
+  try
+  {
+    if (rect)
+    {
+      if (!TextureAtlas::fits(rect->get_width(), rect->get_height()))
+        return TexturePtr();
+
+      const SDL_Surface& surface = get_surface(filename);
+
+      // invalid subregions are reported by the regular code path
+      if (!Rect(0, 0, surface.w, surface.h).contains(*rect))
+        return TexturePtr();
+
+      return m_atlas.add(surface, *rect, region);
+    }
+    else
+    {
+      Texture::Key key(filename, Rect());
+
+      // Don't decode images a second time that are already loaded as
+      // regular textures
+      auto i = m_image_textures.find(key);
+      if (i != m_image_textures.end() && !i->second.expired())
+        return TexturePtr();
+
+      SDLSurfacePtr image = load_image(filename);
+      if (!image)
+        return TexturePtr();
+
+      if (TextureAtlas::fits(image->w, image->h))
+        return m_atlas.add(*image, Rect(0, 0, image->w, image->h), region);
+
+      // Too large for the atlas, make a regular texture right away
+      // instead of loading the file again in get()
+      TexturePtr texture = VideoSystem::current()->new_texture(*image);
+      texture->m_cache_key = key;
+      m_image_textures[key] = texture;
+      region = Rect(0, 0, image->w, image->h);
+      return texture;
+    }
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Couldn't add '" << filename << "' to the texture atlas: " << err.what() << std::endl;
+    return TexturePtr();
+  }
+}
+
 void
 TextureManager::reap_cache_entry(const Texture::Key& key)
 {
@@ -267,17 +363,65 @@ TextureManager::create_image_texture(const std::string& filename, const Rect& re
   }
 }
 
+void
+TextureManager::prefetch(const std::string& _filename)
+{
+  std::string filename = FileSystem::normalize(_filename);
+
+  if (m_surfaces.find(filename) != m_surfaces.end())
+    return;
+
+  Texture::Key key(filename, Rect());
+
+  auto texture = m_image_textures.find(key);
+  if (texture != m_image_textures.end() && !texture->second.expired())
+    return;
+
+  auto atlas_entry = m_atlas_entries.find(key);
+  if (atlas_entry != m_atlas_entries.end() && !atlas_entry->second.texture.expired())
+    return;
+
+  if (!m_decode_queue)
+  {
+    m_decode_queue = std::make_unique<ImageDecodeQueue>();
+  }
+  m_decode_queue->prefetch(filename);
+}
+
+void
+TextureManager::clear_prefetched()
+{
+  if (m_decode_queue)
+  {
+    m_decode_queue->clear();
+  }
+}
+
+SDLSurfacePtr
+TextureManager::load_image(const std::string& filename)
+{
+  if (m_decode_queue)
+  {
+    SDLSurfacePtr image = m_decode_queue->take(filename);
+    if (image)
+      return image;
+  }
+
+  return SDLSurface::from_file(filename);
+}
+
 const SDL_Surface&
 TextureManager::get_surface(const std::string& filename)
 {
   auto i = m_surfaces.find(filename);
   if (i != m_surfaces.end())
   {
-    return *i->second;
+    m_surfaces_lru.splice(m_surfaces_lru.begin(), m_surfaces_lru, i->second.lru_it);
+    return *i->second.surface;
   }
   else
   {
-    SDLSurfacePtr image = SDLSurface::from_file(filename);
+    SDLSurfacePtr image = load_image(filename);
     if (!image)
     {
       std::ostringstream msg;
@@ -285,10 +429,45 @@ TextureManager::get_surface(const std::string& filename)
       throw std::runtime_error(msg.str());
     }
 
-    return *(m_surfaces[filename] = std::move(image));
+    const size_t bytes = static_cast<size_t>(image->pitch) * static_cast<size_t>(image->h);
+    m_surfaces_lru.push_front(filename);
+    m_surface_bytes += bytes;
+
+    SurfaceEntry& entry = m_surfaces[filename];
+    entry.surface = std::move(image);
+    entry.bytes = bytes;
+    entry.lru_it = m_surfaces_lru.begin();
+
+    evict_surfaces(filename);
+
+    return *entry.surface;
+  }
+}
+
+void
+TextureManager::evict_surfaces(const std::string& keep)
+{
+  while (m_surface_bytes > SURFACE_CACHE_BUDGET &&
+         m_surfaces_lru.back() != keep)
+  {
+    auto i = m_surfaces.find(m_surfaces_lru.back());
+    assert(i != m_surfaces.end());
+
+    log_debug << "Evicting decoded image '" << i->first << "'" << std::endl;
+    m_surface_bytes -= i->second.bytes;
+    m_surfaces.erase(i);
+    m_surfaces_lru.pop_back();
   }
 }
 
+void
+TextureManager::release_surfaces()
+{
+  m_surfaces.clear();
+  m_surfaces_lru.clear();
+  m_surface_bytes = 0;
+}
+
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Rect& rect, const Sampler& sampler)
 {
@@ -369,7 +548,7 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Sampler& sampler)
 {
-  SDLSurfacePtr image = SDLSurface::from_file(filename);
+  SDLSurfacePtr image = load_image(filename);
   if (!image)
   {
     std::ostringstream msg;
@@ -437,10 +616,11 @@ TextureManager::debug_print(std::ostream& out) const
   for(const auto& it : m_surfaces)
   {
     const auto& filename = it.first;
-    const auto& surface = it.second;
+    const auto& surface = it.second.surface;
 
     total_surface_pixels += surface->w * surface->h;
-    out << "  surface filename:" << filename << " " << surface->w << "x" << surface->h << std::endl;
+    out << "  surface filename:" << filename << " " << surface->w << "x" << surface->h
+        << " bytes:" << it.second.bytes << std::endl;
   }
   out << "surfaces:end" << std::endl;
 
@@ -449,6 +629,10 @@ TextureManager::debug_print(std::ostream& out) const
 
   out << "total surface count:" << m_surfaces.size() << std::endl;
   out << "total surface pixels:" << total_surface_pixels << std::endl;
+  out << "total surface bytes:" << m_surface_bytes
+      << " (budget " << SURFACE_CACHE_BUDGET << ")" << std::endl;
+
+  m_atlas.debug_print(out);
 }
 
 /* EOF */
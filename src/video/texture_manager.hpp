@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_VIDEO_TEXTURE_MANAGER_HPP
 
 #include <config.h>
+#include <list>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -31,9 +32,11 @@
 #include "video/sampler.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/texture_ptr.hpp"
 
 class GLTexture;
+class ImageDecodeQueue;
 class ReaderMapping;
 struct SDL_Surface;
 
@@ -42,6 +45,10 @@ class TextureManager final : public Currenton<TextureManager>
 public:
   friend class Texture;
 
+  /** Upper limit for the decoded images kept around for cutting
+      subregions out of them, least recently used ones are freed first */
+  static const size_t SURFACE_CACHE_BUDGET = 64 * 1024 * 1024;
+
 public:
   TextureManager();
   ~TextureManager() override;
@@ -52,10 +59,32 @@ public:
                  const boost::optional<Rect>& rect,
                  const Sampler& sampler = Sampler());
 
+  /** Like get(), but small images are placed on a shared atlas page
+      unless the atlas is disabled in the config. `region` receives
+      the area of the image on the returned texture. */
+  TexturePtr get_atlased(const std::string& filename,
+                         const boost::optional<Rect>& rect,
+                         Rect& region);
+
+  /** Frees all decoded images kept for cutting subregions */
+  void release_surfaces();
+
+  /** Starts decoding `filename` on a background thread, so that it is
+      ready by the time a texture is created from it */
+  void prefetch(const std::string& filename);
+
+  /** Drops prefetched images that haven't been used */
+  void clear_prefetched();
+
   void debug_print(std::ostream& out) const;
 
 private:
+  /** Returns the prefetched image if there is one, decodes the file
+      otherwise. Returns nullptr on failure. */
+  SDLSurfacePtr load_image(const std::string& filename);
+
   const SDL_Surface& get_surface(const std::string& filename);
+  void evict_surfaces(const std::string& keep);
   void reap_cache_entry(const Texture::Key& key);
 
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler);
@@ -69,9 +98,35 @@ private:
 
   TexturePtr create_dummy_texture();
 
+  /** Returns nullptr if the image has to be loaded with get() instead */
+  TexturePtr create_atlas_texture(const std::string& filename, const boost::optional<Rect>& rect, Rect& region);
+
+private:
+  struct SurfaceEntry
+  {
+    SDLSurfacePtr surface;
+    size_t bytes;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  struct AtlasEntry
+  {
+    std::weak_ptr<Texture> texture;
+    Rect region;
+  };
+
 private:
   std::map<Texture::Key, std::weak_ptr<Texture> > m_image_textures;
-  std::map<std::string, SDLSurfacePtr> m_surfaces;
+  std::map<std::string, SurfaceEntry> m_surfaces;
+
+  /** Filenames of m_surfaces, most recently used first */
+  std::list<std::string> m_surfaces_lru;
+  size_t m_surface_bytes;
+
+  TextureAtlas m_atlas;
+  std::map<Texture::Key, AtlasEntry> m_atlas_entries;
+
+  std::unique_ptr<ImageDecodeQueue> m_decode_queue;
 
 private:
   TextureManager(const TextureManager&) = delete;
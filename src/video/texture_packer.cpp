@@ -0,0 +1,86 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_packer.hpp"
+
+TexturePacker::TexturePacker(const Size& size) :
+  m_size(size),
+  m_shelves(),
+  m_bottom(0),
+  m_used_area(0),
+  m_rect_count(0)
+{
+}
+
+boost::optional<Rect>
+TexturePacker::insert(const Size& size)
+{
+  if (size.width <= 0 || size.height <= 0 ||
+      size.width > m_size.width || size.height > m_size.height)
+  {
+    return boost::none;
+  }
+
+  // Use the shelf that wastes the least height, images of the same
+  // size (tiles, animation frames) thereby end up next to each other.
+  Shelf* best = nullptr;
+  for (auto& shelf : m_shelves)
+  {
+    if (shelf.height >= size.height &&
+        m_size.width - shelf.used_width >= size.width &&
+        (!best || shelf.height < best->height))
+    {
+      best = &shelf;
+    }
+  }
+
+  if (!best)
+  {
+    if (m_size.height - m_bottom < size.height)
+      return boost::none;
+
+    m_shelves.push_back({m_bottom, size.height, 0});
+    m_bottom += size.height;
+    best = &m_shelves.back();
+  }
+
+  Rect rect(best->used_width, best->top, size);
+  best->used_width += size.width;
+
+  m_used_area += size.width * size.height;
+  m_rect_count += 1;
+
+  return rect;
+}
+
+void
+TexturePacker::clear()
+{
+  m_shelves.clear();
+  m_bottom = 0;
+  m_used_area = 0;
+  m_rect_count = 0;
+}
+
+float
+TexturePacker::get_fill() const
+{
+  return static_cast<float>(m_used_area) /
+    static_cast<float>(m_size.width * m_size.height);
+}
+
+/* EOF */
@@ -0,0 +1,73 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_PACKER_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_PACKER_HPP
+
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "math/rect.hpp"
+#include "math/size.hpp"
+
+/** Places rectangles on a fixed size page using horizontal shelves.
+    Rectangles are never freed individually, the whole page is reset
+    with clear() once none of its images are in use anymore. */
+class TexturePacker final
+{
+private:
+  struct Shelf
+  {
+    int top;
+    int height;
+    int used_width;
+  };
+
+public:
+  TexturePacker(const Size& size);
+
+  /** Returns the area reserved for a rectangle of `size`, or none if
+      the page is full */
+  boost::optional<Rect> insert(const Size& size);
+
+  void clear();
+
+  Size get_size() const { return m_size; }
+  int get_used_area() const { return m_used_area; }
+  int get_rect_count() const { return m_rect_count; }
+
+  /** Fraction of the page covered by rectangles, 0.0 to 1.0 */
+  float get_fill() const;
+
+private:
+  Size m_size;
+  std::vector<Shelf> m_shelves;
+
+  /** Top of the unused space below the last shelf */
+  int m_bottom;
+
+  int m_used_area;
+  int m_rect_count;
+
+private:
+  TexturePacker(const TexturePacker&) = delete;
+  TexturePacker& operator=(const TexturePacker&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -62,6 +62,10 @@ public:
 
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler = Sampler()) = 0;
 
+  /** Whether the painter can draw surfaces that are a region of a
+      texture atlas page, including repeated ones */
+  virtual bool supports_texture_atlas() const { return false; }
+
   virtual const Viewport& get_viewport() const = 0;
   virtual void apply_config() = 0;
   virtual void flip() = 0;
@@ -0,0 +1,50 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "sprite/action_id.hpp"
+
+TEST(ActionIdTest, intern)
+{
+  const ActionId left("action-id-test-left");
+  const ActionId right("action-id-test-right");
+
+  ASSERT_TRUE(left.is_valid());
+  ASSERT_TRUE(right.is_valid());
+  ASSERT_NE(left, right);
+
+  ASSERT_EQ(left, ActionId("action-id-test-left"));
+  ASSERT_EQ(left, ActionId(std::string("action-id-test-") + "left"));
+  ASSERT_EQ("action-id-test-left", left.get_name());
+  ASSERT_EQ("action-id-test-right", right.get_name());
+}
+
+TEST(ActionIdTest, find)
+{
+  ASSERT_FALSE(ActionId().is_valid());
+  ASSERT_EQ("", ActionId().get_name());
+
+  ASSERT_FALSE(ActionId::find("action-id-test-unknown").is_valid());
+  // find() doesn't intern
+  ASSERT_FALSE(ActionId::find("action-id-test-unknown").is_valid());
+
+  const ActionId id("action-id-test-known");
+  ASSERT_EQ(id, ActionId::find("action-id-test-known"));
+}
+
+/* EOF */
@@ -0,0 +1,210 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "supertux/autotile.hpp"
+#include "supertux/tile_set.hpp"
+
+namespace {
+
+/** Lookups done by scanning the autotiles, as AutotileSet and TileSet
+    did before they had lookup tables */
+class ScanLookup final
+{
+public:
+  ScanLookup(const std::vector<std::vector<const Autotile*> >& sets,
+             const std::vector<AutotileSet*>& autotilesets) :
+    m_sets(sets),
+    m_autotilesets(autotilesets)
+  {}
+
+  int get_set(uint32_t tile_id) const
+  {
+    if (tile_id == 0)
+      return -1;
+
+    for (size_t i = 0; i < m_sets.size(); ++i) {
+      if (is_member(i, tile_id))
+        return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  bool is_member(size_t set, uint32_t tile_id) const
+  {
+    for (const auto* autotile : m_sets[set]) {
+      if (autotile->is_amongst(tile_id))
+        return true;
+    }
+    const uint32_t default_tile = m_autotilesets[set]->get_default_tile();
+    return tile_id == default_tile && default_tile != 0;
+  }
+
+  bool is_solid(size_t set, uint32_t tile_id) const
+  {
+    for (const auto* autotile : m_sets[set]) {
+      if (autotile->is_amongst(tile_id))
+        return autotile->is_solid();
+    }
+    const uint32_t default_tile = m_autotilesets[set]->get_default_tile();
+    return tile_id == default_tile && default_tile != 0;
+  }
+
+  uint32_t get_autotile(size_t set, uint8_t mask, bool center, int x, int y) const
+  {
+    for (const auto* autotile : m_sets[set]) {
+      if (autotile->matches(mask, center))
+        return autotile->pick_tile(x, y);
+    }
+    return center ? m_autotilesets[set]->get_default_tile() : 0;
+  }
+
+private:
+  const std::vector<std::vector<const Autotile*> >& m_sets;
+  const std::vector<AutotileSet*>& m_autotilesets;
+
+private:
+  ScanLookup(const ScanLookup&) = delete;
+  ScanLookup& operator=(const ScanLookup&) = delete;
+};
+
+class AutotileTest : public ::testing::Test
+{
+protected:
+  AutotileTest() :
+    m_tileset(),
+    m_masks(),
+    m_autotiles(),
+    m_autotilesets(),
+    m_sets()
+  {
+    m_tileset.reset(new TileSet());
+
+    // A set with one autotile per mask and some alternative tiles, an
+    // overlapping set sharing tile 47 and a corner-based set
+    std::vector<Autotile*> blob;
+    for (int mask = 0; mask < 256; ++mask) {
+      std::vector<std::pair<uint32_t, float> > alt_tiles;
+      if (mask % 16 == 0)
+        alt_tiles.push_back(std::make_pair(static_cast<uint32_t>(1000 + mask), 0.25f));
+      blob.push_back(create_autotile(static_cast<uint32_t>(mask + 1), alt_tiles,
+                                     { static_cast<uint8_t>(mask) }, true));
+    }
+    blob.push_back(create_autotile(300, {}, { 0x00 }, false));
+    add_set(blob, 1, false);
+
+    add_set({ create_autotile(47, {}, { 0xff }, true),
+              create_autotile(400, {}, { 0x00, 0x1f }, true) }, 400, false);
+
+    std::vector<Autotile*> corner;
+    for (int mask = 1; mask < 16; ++mask) {
+      corner.push_back(create_autotile(static_cast<uint32_t>(500 + mask), {},
+                                       { static_cast<uint8_t>(mask) }, true));
+    }
+    add_set(corner, 501, true);
+
+    m_tileset->build_autotile_lookup();
+  }
+
+  Autotile* create_autotile(uint32_t tile_id, std::vector<std::pair<uint32_t, float> > alt_tiles,
+                            const std::vector<uint8_t>& masks, bool solid)
+  {
+    std::vector<AutotileMask*> autotile_masks;
+    for (const uint8_t mask : masks) {
+      m_masks.push_back(std::make_unique<AutotileMask>(mask, solid));
+      autotile_masks.push_back(m_masks.back().get());
+    }
+
+    m_autotiles.push_back(std::make_unique<Autotile>(tile_id, std::move(alt_tiles), autotile_masks, solid));
+    return m_autotiles.back().get();
+  }
+
+  void add_set(const std::vector<Autotile*>& autotiles, uint32_t default_tile, bool corner)
+  {
+    m_autotilesets.push_back(std::make_unique<AutotileSet>(autotiles, default_tile, "test", corner));
+    m_tileset->m_autotilesets->push_back(m_autotilesets.back().get());
+    m_sets.push_back(std::vector<const Autotile*>(autotiles.begin(), autotiles.end()));
+  }
+
+protected:
+  std::unique_ptr<TileSet> m_tileset;
+  std::vector<std::unique_ptr<AutotileMask> > m_masks;
+  std::vector<std::unique_ptr<Autotile> > m_autotiles;
+  std::vector<std::unique_ptr<AutotileSet> > m_autotilesets;
+  std::vector<std::vector<const Autotile*> > m_sets;
+};
+
+} // namespace
+
+TEST_F(AutotileTest, lookup_matches_scan)
+{
+  const ScanLookup scan(m_sets, *m_tileset->m_autotilesets);
+
+  for (uint32_t tile_id = 0; tile_id < 1500; ++tile_id) {
+    const int set = scan.get_set(tile_id);
+    ASSERT_EQ(set < 0 ? nullptr : m_autotilesets[set].get(), m_tileset->get_autotileset_from_tile(tile_id))
+      << "tile " << tile_id;
+
+    for (size_t i = 0; i < m_autotilesets.size(); ++i) {
+      ASSERT_EQ(scan.is_member(i, tile_id), m_autotilesets[i]->is_member(tile_id));
+      ASSERT_EQ(scan.is_solid(i, tile_id), m_autotilesets[i]->is_solid(tile_id));
+    }
+  }
+
+  for (size_t i = 0; i < m_autotilesets.size(); ++i) {
+    if (m_autotilesets[i]->is_corner())
+      continue;
+
+    for (int mask = 0; mask < 256; ++mask) {
+      for (const bool center : { false, true }) {
+        const bool bits[8] = { (mask & 0x80) != 0, (mask & 0x40) != 0, (mask & 0x20) != 0, (mask & 0x10) != 0,
+                               (mask & 0x08) != 0, (mask & 0x04) != 0, (mask & 0x02) != 0, (mask & 0x01) != 0 };
+        ASSERT_EQ(scan.get_autotile(i, static_cast<uint8_t>(mask), center, 3, 7),
+                  m_autotilesets[i]->get_autotile(0, bits[0], bits[1], bits[2], bits[3], center, bits[4],
+                                                  bits[5], bits[6], bits[7], 3, 7));
+      }
+    }
+  }
+}
+
+TEST_F(AutotileTest, overlapping_sets)
+{
+  // Tile 47 is in both of the first sets, the first one wins
+  ASSERT_EQ(m_autotilesets[0].get(), m_tileset->get_autotileset_from_tile(47));
+  ASSERT_TRUE(m_autotilesets[1]->is_member(47));
+  ASSERT_EQ(m_autotilesets[1].get(), m_tileset->get_autotileset_from_tile(400));
+}
+
+TEST_F(AutotileTest, corner_masks)
+{
+  const AutotileSet& corner = *m_autotilesets[2];
+  ASSERT_TRUE(corner.is_corner());
+  for (int mask = 1; mask < 16; ++mask) {
+    const uint32_t tile_id = static_cast<uint32_t>(500 + mask);
+    ASSERT_EQ(mask, corner.get_mask_from_tile(tile_id));
+    ASSERT_EQ(tile_id, corner.get_autotile(0, (mask & 0x08) != 0, false, (mask & 0x04) != 0,
+                                           false, false, false,
+                                           (mask & 0x02) != 0, false, (mask & 0x01) != 0, 0, 0));
+  }
+  ASSERT_EQ(0, corner.get_mask_from_tile(1));
+}
+
+/* EOF */
@@ -0,0 +1,73 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "collision/collision_hit.hpp"
+#include "collision/collision_listener.hpp"
+#include "collision/collision_movement_manager.hpp"
+#include "collision/collision_object.hpp"
+
+namespace {
+
+class DummyListener final : public CollisionListener
+{
+public:
+  void collision_solid(const CollisionHit&) override {}
+  bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  HitResponse collision(GameObject&, const CollisionHit&) override { return CONTINUE; }
+  void collision_tile(uint32_t) override {}
+  bool listener_is_valid() const override { return true; }
+};
+
+} // namespace
+
+TEST(CollisionMovementManagerTest, notify_object_removal)
+{
+  auto manager = std::make_shared<CollisionGroundMovementManager>();
+  DummyListener listener;
+
+  CollisionObject platform1(COLGROUP_STATIC, listener);
+  CollisionObject platform2(COLGROUP_STATIC, listener);
+  CollisionObject walker1(COLGROUP_MOVING, listener);
+  CollisionObject walker2(COLGROUP_MOVING, listener);
+  for (auto* object : { &platform1, &platform2, &walker1, &walker2 }) {
+    object->set_ground_movement_manager(manager);
+  }
+
+  platform1.collision_moving_object_bottom(walker1);
+  platform2.collision_moving_object_bottom(walker1);
+  platform2.collision_moving_object_bottom(walker2);
+
+  // Moving objects never remember what stands on them
+  walker1.collision_moving_object_bottom(walker2);
+
+  manager->notify_object_removal({ &walker1 });
+
+  const std::vector<CollisionObject*> none;
+  ASSERT_FALSE(platform1.notify_object_removal(none));
+  ASSERT_TRUE(platform2.notify_object_removal(none));
+  ASSERT_FALSE(walker1.notify_object_removal(none));
+
+  manager->notify_object_removal({ &walker2 });
+  ASSERT_FALSE(platform2.notify_object_removal(none));
+}
+
+/* EOF */
@@ -0,0 +1,178 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "collision/collision.hpp"
+#include "collision/collision_listener.hpp"
+#include "collision/collision_object.hpp"
+#include "collision/collision_spatial_grid.hpp"
+#include "math/rectf.hpp"
+
+namespace {
+
+class DummyListener final : public CollisionListener
+{
+public:
+  void collision_solid(const CollisionHit&) override {}
+  bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  HitResponse collision(GameObject&, const CollisionHit&) override { return CONTINUE; }
+  void collision_tile(uint32_t) override {}
+  bool listener_is_valid() const override { return true; }
+};
+
+class CollisionSpatialGridTest : public ::testing::Test
+{
+protected:
+  CollisionSpatialGridTest() :
+    m_listener(),
+    m_objects()
+  {}
+
+  CollisionObject& create(const Rectf& rect)
+  {
+    m_objects.push_back(std::make_unique<CollisionObject>(COLGROUP_MOVING, m_listener));
+    m_objects.back()->m_bbox = rect;
+    return *m_objects.back();
+  }
+
+  Rectf random_rect(std::mt19937& rng, float world_size)
+  {
+    std::uniform_real_distribution<float> pos(-world_size / 2.0f, world_size / 2.0f);
+    std::uniform_real_distribution<float> size(8.0f, 96.0f);
+    const Vector p(pos(rng), pos(rng));
+    return Rectf(p, Sizef(size(rng), size(rng)));
+  }
+
+  std::vector<CollisionObject*> brute_force(const Rectf& rect) const
+  {
+    std::vector<CollisionObject*> result;
+    for (const auto& object : m_objects) {
+      if (collision::intersects(rect, object->get_bbox()))
+        result.push_back(object.get());
+    }
+    return result;
+  }
+
+  std::vector<CollisionObject*> filtered_query(const CollisionSpatialGrid& grid, const Rectf& rect) const
+  {
+    std::vector<CollisionObject*> candidates;
+    grid.query(rect, candidates);
+
+    std::vector<CollisionObject*> result;
+    for (auto* object : candidates) {
+      if (collision::intersects(rect, object->get_bbox()))
+        result.push_back(object);
+    }
+    return result;
+  }
+
+protected:
+  DummyListener m_listener;
+  std::vector<std::unique_ptr<CollisionObject> > m_objects;
+};
+
+} // namespace
+
+TEST_F(CollisionSpatialGridTest, query_matches_brute_force)
+{
+  std::mt19937 rng(1234);
+  CollisionSpatialGrid grid;
+
+  for (int i = 0; i < 500; ++i) {
+    auto& object = create(random_rect(rng, 4000.0f));
+    grid.insert(object, object.get_bbox());
+  }
+
+  for (int i = 0; i < 200; ++i) {
+    const Rectf rect = random_rect(rng, 4000.0f).grown(64.0f);
+    ASSERT_EQ(brute_force(rect), filtered_query(grid, rect));
+  }
+}
+
+TEST_F(CollisionSpatialGridTest, query_keeps_insertion_order)
+{
+  CollisionSpatialGrid grid(32.0f);
+  std::vector<CollisionObject*> expected;
+
+  // Spread over several cells, inserted in reverse spatial order
+  for (int i = 10; i > 0; --i) {
+    auto& object = create(Rectf(static_cast<float>(i) * 20.0f, 0.0f,
+                                static_cast<float>(i) * 20.0f + 30.0f, 30.0f));
+    grid.insert(object, object.get_bbox());
+    expected.push_back(&object);
+  }
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(0.0f, 0.0f, 400.0f, 400.0f), result);
+  ASSERT_EQ(expected, result);
+}
+
+TEST_F(CollisionSpatialGridTest, touching_rects_are_found)
+{
+  CollisionSpatialGrid grid(32.0f);
+
+  auto& object = create(Rectf(64.0f, 0.0f, 96.0f, 32.0f));
+  grid.insert(object, object.get_bbox());
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(32.0f, 0.0f, 64.0f, 32.0f), result);
+  ASSERT_EQ(1u, result.size());
+}
+
+TEST_F(CollisionSpatialGridTest, update_and_remove)
+{
+  CollisionSpatialGrid grid;
+
+  auto& object = create(Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  grid.insert(object, object.get_bbox());
+
+  object.m_bbox = Rectf(1000.0f, 1000.0f, 1032.0f, 1032.0f);
+  grid.update(object, object.get_bbox());
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(0.0f, 0.0f, 32.0f, 32.0f), result);
+  ASSERT_TRUE(result.empty());
+
+  grid.query(Rectf(1010.0f, 1010.0f, 1020.0f, 1020.0f), result);
+  ASSERT_EQ(1u, result.size());
+
+  grid.remove(object);
+  result.clear();
+  grid.query(Rectf(1010.0f, 1010.0f, 1020.0f, 1020.0f), result);
+  ASSERT_TRUE(result.empty());
+  ASSERT_EQ(0u, grid.size());
+}
+
+TEST_F(CollisionSpatialGridTest, oversized_objects)
+{
+  CollisionSpatialGrid grid(16.0f);
+
+  auto& huge = create(Rectf(0.0f, 0.0f, 100000.0f, 100000.0f));
+  grid.insert(huge, huge.get_bbox());
+  auto& small = create(Rectf(5000.0f, 5000.0f, 5010.0f, 5010.0f));
+  grid.insert(small, small.get_bbox());
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(5000.0f, 5000.0f, 5001.0f, 5001.0f), result);
+  ASSERT_EQ((std::vector<CollisionObject*>{ &huge, &small }), result);
+}
+
+/* EOF */
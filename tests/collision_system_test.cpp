@@ -0,0 +1,102 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "collision/collision_hit.hpp"
+#include "collision/collision_listener.hpp"
+#include "collision/collision_object.hpp"
+#include "collision/collision_spatial_grid.hpp"
+#include "collision/collision_system.hpp"
+#include "supertux/game_object.hpp"
+
+namespace {
+
+class TestObject final : public GameObject,
+                         public CollisionListener
+{
+public:
+  TestObject(HitResponse response, const Rectf& rect) :
+    m_col(COLGROUP_MOVING, *this),
+    m_response(response),
+    m_hits()
+  {
+    m_col.set_size(rect.get_width(), rect.get_height());
+    m_col.set_pos(rect.p1());
+  }
+
+  void update(float) override {}
+  void draw(DrawingContext&) override {}
+
+  void collision_solid(const CollisionHit&) override {}
+  bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  HitResponse collision(GameObject& other, const CollisionHit&) override
+  {
+    m_hits.push_back(&other);
+    return m_response;
+  }
+  void collision_tile(uint32_t) override {}
+  bool listener_is_valid() const override { return true; }
+
+  bool was_hit_by(const TestObject& other) const
+  {
+    return std::find(m_hits.begin(), m_hits.end(), &other) != m_hits.end();
+  }
+
+public:
+  CollisionObject m_col;
+
+private:
+  HitResponse m_response;
+  std::vector<const GameObject*> m_hits;
+
+private:
+  TestObject(const TestObject&) = delete;
+  TestObject& operator=(const TestObject&) = delete;
+};
+
+} // namespace
+
+TEST(CollisionSystemTest, pushed_second_object_is_rebinned)
+{
+  // `first` doesn't move and pushes `pushed` out of grid cell 0 into
+  // cell 1, where it ends up overlapping `third`.
+  TestObject first(FORCE_MOVE, Rectf(100.0f, 0.0f, 140.0f, 32.0f));
+  TestObject pushed(CONTINUE, Rectf(120.0f, 0.0f, 127.0f, 32.0f));
+  TestObject third(CONTINUE, Rectf(145.0f, 0.0f, 175.0f, 32.0f));
+
+  CollisionSpatialGrid grid(128.0f);
+  std::vector<CollisionObject*> objects;
+  for (auto* object : { &first, &pushed, &third }) {
+    grid.insert(object->m_col, object->m_col.get_bbox());
+    objects.push_back(&object->m_col);
+  }
+
+  std::vector<CollisionObject*> candidates;
+  CollisionSystem::collision_moving_objects(objects, grid, candidates);
+
+  ASSERT_TRUE(pushed.was_hit_by(first));
+  ASSERT_FALSE(first.was_hit_by(third));
+  ASSERT_TRUE(pushed.was_hit_by(third));
+  ASSERT_TRUE(third.was_hit_by(pushed));
+}
+
+/* EOF */
@@ -0,0 +1,120 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+const char* const LEVEL =
+  "(supertux-level\n"
+  "  (version 3)\n"
+  "  (name (_ \"Compiled\"))\n"
+  "  (sector\n"
+  "    (name \"main\")\n"
+  "    (gravity 10.5)\n"
+  "    (tilemap\n"
+  "      (solid #t)\n"
+  "      (width 5) (height 4)\n"
+  "      (tiles 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19))\n"
+  "    (tilemap\n"
+  "      (solid #f)\n"
+  "      (width 2) (height 1)\n"
+  "      (tiles 7 8))))\n";
+
+ReaderDocument compile(const ReaderDocument& doc)
+{
+  std::ostringstream out;
+  doc.save_compiled(out);
+  return ReaderDocument::from_compiled_data(out.str());
+}
+
+std::vector<unsigned int> get_tiles(const ReaderMapping& tilemap)
+{
+  std::vector<unsigned int> tiles;
+  tilemap.get("tiles", tiles);
+  return tiles;
+}
+
+} // namespace
+
+TEST(CompiledDocumentTest, round_trip)
+{
+  std::istringstream in(LEVEL);
+  auto source = ReaderDocument::from_stream(in);
+  auto compiled = compile(source);
+
+  auto root = compiled.get_root();
+  ASSERT_EQ("supertux-level", root.get_name());
+  auto level = root.get_mapping();
+
+  int version = 0;
+  level.get("version", version);
+  ASSERT_EQ(3, version);
+
+  std::string name;
+  level.get("name", name);
+  ASSERT_EQ("Compiled", name);
+
+  boost::optional<ReaderMapping> sector;
+  ASSERT_TRUE(level.get("sector", sector));
+
+  float gravity = 0.0f;
+  sector->get("gravity", gravity);
+  ASSERT_EQ(10.5f, gravity);
+
+  std::vector<std::vector<unsigned int> > tilemaps;
+  auto iter = sector->get_iter();
+  while (iter.next())
+  {
+    if (iter.get_key() != "tilemap")
+      continue;
+
+    bool solid = false;
+    iter.as_mapping().get("solid", solid);
+    ASSERT_EQ(tilemaps.empty(), solid);
+    tilemaps.push_back(get_tiles(iter.as_mapping()));
+  }
+
+  ASSERT_EQ(2u, tilemaps.size());
+  ASSERT_EQ(20u, tilemaps[0].size());
+  for (unsigned int i = 0; i < 20; ++i)
+    ASSERT_EQ(i, tilemaps[0][i]);
+  ASSERT_EQ((std::vector<unsigned int>{ 7, 8 }), tilemaps[1]);
+}
+
+TEST(CompiledDocumentTest, malformed_data)
+{
+  std::istringstream in(LEVEL);
+  auto source = ReaderDocument::from_stream(in);
+
+  std::ostringstream out;
+  source.save_compiled(out);
+  const std::string data = out.str();
+
+  ASSERT_THROW(ReaderDocument::from_compiled_data(""), std::runtime_error);
+  ASSERT_THROW(ReaderDocument::from_compiled_data("(supertux-level)"), std::runtime_error);
+  ASSERT_THROW(ReaderDocument::from_compiled_data(data.substr(0, data.size() / 2)), std::runtime_error);
+  ASSERT_THROW(ReaderDocument::from_compiled_data(data.substr(0, data.size() - 1)), std::runtime_error);
+}
+
+/* EOF */
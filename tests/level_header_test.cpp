@@ -0,0 +1,111 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+
+#include "supertux/level_header.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+const char* const LEVEL =
+  "; comment (with parens\n"
+  "(supertux-level\n"
+  "  (version 3)\n"
+  "  (name (_ \"Level \\\"One\\\" (1)\"))\n"
+  "  (author \"Tux\") ; comment\n"
+  "  (license \"CC-by-sa 4.0\")\n"
+  "  (target-time 42.5)\n"
+  "  (sector\n"
+  "    (tilemap (name \"not the sector\") (tiles 1 2 3))\n"
+  "    (name \"main\")\n"
+  "    (music \"(name \\\"fake\\\")\"))\n"
+  "  (sector\n"
+  "    (name \"secret\"))\n"
+  ")\n";
+
+} // namespace
+
+TEST(LevelHeaderTest, from_stream)
+{
+  ReaderMapping::s_translations_enabled = false;
+
+  std::istringstream in(LEVEL);
+  auto header = LevelHeader::from_stream(in);
+  ASSERT_EQ(3, header.version);
+  ASSERT_EQ("Level \"One\" (1)", header.name);
+  ASSERT_TRUE(header.name_translatable);
+  ASSERT_EQ("Level \"One\" (1)", header.get_name());
+  ASSERT_EQ("Tux", header.author);
+  ASSERT_EQ("CC-by-sa 4.0", header.license);
+  ASSERT_EQ(42.5f, header.target_time);
+  ASSERT_TRUE(header.sectors.empty());
+
+  ReaderMapping::s_translations_enabled = true;
+}
+
+TEST(LevelHeaderTest, read_sectors)
+{
+  std::istringstream in(LEVEL);
+  auto header = LevelHeader::from_stream(in, true);
+  ASSERT_EQ("Tux", header.author);
+  ASSERT_EQ((std::vector<std::string>{ "main", "secret" }), header.sectors);
+}
+
+TEST(LevelHeaderTest, stops_after_header)
+{
+  // Nothing after the first sector is read
+  std::istringstream in(
+    "(supertux-level (name \"Broken\") (sector (name \"main\") (unterminated \"");
+  ASSERT_EQ("Broken", LevelHeader::from_stream(in).name);
+
+  std::istringstream in2(
+    "(supertux-level (name \"Broken\") (sector (name \"main\") (unterminated \"");
+  ASSERT_THROW(LevelHeader::from_stream(in2, true), std::runtime_error);
+}
+
+TEST(LevelHeaderTest, old_format)
+{
+  std::istringstream in(
+    "(supertux-level\n"
+    "  (version 1)\n"
+    "  (author \"Tux\")\n"
+    "  (name \"Old\")\n"
+    "  (width 3)\n"
+    "  (interactive-tm 0 0 0)\n"
+    "  (time 300))\n");
+
+  auto header = LevelHeader::from_stream(in, true);
+  ASSERT_EQ(1, header.version);
+  ASSERT_EQ("Old", header.name);
+  ASSERT_FALSE(header.name_translatable);
+  ASSERT_TRUE(header.sectors.empty());
+}
+
+TEST(LevelHeaderTest, not_a_level)
+{
+  std::istringstream in("(supertux-worldmap (name \"Map\"))");
+  ASSERT_THROW(LevelHeader::from_stream(in), std::runtime_error);
+
+  std::istringstream in2("");
+  ASSERT_THROW(LevelHeader::from_stream(in2), std::runtime_error);
+}
+
+/* EOF */
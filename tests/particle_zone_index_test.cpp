@@ -0,0 +1,105 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "object/particle_zone_index.hpp"
+
+namespace {
+
+struct TestZone
+{
+  std::string name;
+  ParticleZone::ParticleZoneType type;
+  Rectf rect;
+};
+
+std::vector<TestZone> random_zones(std::mt19937& rng, int count)
+{
+  std::uniform_real_distribution<float> pos(0.0f, 8000.0f);
+  std::uniform_real_distribution<float> size(32.0f, 2000.0f);
+  std::uniform_int_distribution<int> type(0, 4);
+  std::uniform_int_distribution<int> name(0, 2);
+
+  std::vector<TestZone> zones;
+  for (int i = 0; i < count; ++i) {
+    const Vector p(pos(rng), pos(rng));
+    zones.push_back(TestZone{ "particles" + std::to_string(name(rng)),
+                              static_cast<ParticleZone::ParticleZoneType>(type(rng)),
+                              Rectf(p, Sizef(size(rng), size(rng))) });
+  }
+  return zones;
+}
+
+} // namespace
+
+TEST(ParticleZoneIndexTest, matches_brute_force)
+{
+  std::mt19937 rng(1234);
+  const auto zones = random_zones(rng, 40);
+
+  ParticleZoneIndex index;
+  for (const auto& zone : zones) {
+    index.add(zone.name, zone.type, zone.rect);
+  }
+  ASSERT_EQ(zones.size(), index.size());
+
+  const int name_id = index.intern("particles1");
+  std::uniform_real_distribution<float> pos(-100.0f, 10000.0f);
+  for (int i = 0; i < 2000; ++i) {
+    const Vector p(pos(rng), pos(rng));
+
+    std::vector<const Rectf*> expected;
+    for (const auto& zone : zones) {
+      if (zone.name == "particles1" && zone.rect.contains(p))
+        expected.push_back(&zone.rect);
+    }
+
+    std::vector<Rectf> result;
+    index.for_each_zone_at(name_id, p, [&result](const ParticleZoneIndex::Zone& zone) {
+        result.push_back(zone.rect);
+      });
+
+    ASSERT_EQ(expected.size(), result.size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+      ASSERT_EQ(*expected[j], result[j]);
+    }
+  }
+}
+
+TEST(ParticleZoneIndexTest, names_survive_clear)
+{
+  ParticleZoneIndex index;
+  const int rain = index.intern("rain");
+  const int snow = index.intern("snow");
+  ASSERT_NE(rain, snow);
+
+  index.add("snow", ParticleZone::ParticleZoneType::Spawn, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  index.add("snow", ParticleZone::ParticleZoneType::Spawn, Rectf(0.0f, 0.0f, 1.0e6f, 1.0e6f));
+  index.clear();
+  ASSERT_EQ(0u, index.size());
+  ASSERT_EQ(snow, index.intern("snow"));
+
+  index.add("rain", ParticleZone::ParticleZoneType::Spawn, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  ASSERT_EQ(1, index.count_zones(rain, ParticleZone::ParticleZoneType::Spawn));
+  ASSERT_EQ(0, index.count_zones(snow, ParticleZone::ParticleZoneType::Spawn));
+}
+
+/* EOF */
@@ -0,0 +1,89 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "audio/pcm_ring_buffer.hpp"
+
+TEST(PCMRingBufferTest, wrap_around)
+{
+  PCMRingBuffer ring(8);
+  char out[8];
+
+  ASSERT_EQ(6u, ring.write("abcdef", 6));
+  ASSERT_EQ(4u, ring.read(out, 4));
+  ASSERT_EQ(2u, ring.get_read_available());
+  ASSERT_EQ(6u, ring.get_write_available());
+
+  // only 6 of the 7 bytes fit
+  ASSERT_EQ(6u, ring.write("ghijklm", 7));
+  ASSERT_EQ(0u, ring.get_write_available());
+
+  ASSERT_EQ(8u, ring.read(out, 8));
+  ASSERT_EQ(std::string("efghijkl"), std::string(out, 8));
+  ASSERT_EQ(0u, ring.read(out, 8));
+}
+
+TEST(PCMRingBufferTest, threaded)
+{
+  PCMRingBuffer ring(1000);
+  const size_t total = 100000;
+
+  std::thread producer([&ring, total]{
+      size_t written = 0;
+      char chunk[333];
+      while (written < total)
+      {
+        const size_t size = std::min(sizeof(chunk), total - written);
+        for (size_t i = 0; i < size; ++i)
+          chunk[i] = static_cast<char>((written + i) % 251);
+
+        size_t done = 0;
+        while (done < size)
+        {
+          const size_t count = ring.write(chunk + done, size - done);
+          if (count == 0)
+            std::this_thread::yield();
+          done += count;
+        }
+        written += size;
+      }
+    });
+
+  std::vector<char> received;
+  received.reserve(total);
+  char chunk[256];
+  while (received.size() < total)
+  {
+    const size_t size = ring.read(chunk, sizeof(chunk));
+    if (size == 0)
+      std::this_thread::yield();
+    received.insert(received.end(), chunk, chunk + size);
+  }
+  producer.join();
+
+  for (size_t i = 0; i < total; ++i)
+  {
+    ASSERT_EQ(static_cast<char>(i % 251), received[i]);
+  }
+}
+
+/* EOF */
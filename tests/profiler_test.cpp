@@ -0,0 +1,107 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string.h>
+
+#include "util/profiler.hpp"
+
+#ifdef ENABLE_PROFILER
+
+TEST(ProfilerTest, nested_zones)
+{
+  Profiler profiler;
+
+  profiler.begin_frame();
+  const int outer = profiler.begin_zone("outer");
+  const int inner = profiler.begin_zone("inner");
+  profiler.end_zone(inner);
+  const int inner2 = profiler.begin_zone("inner");
+  profiler.end_zone(inner2);
+  profiler.end_zone(outer);
+  profiler.end_frame();
+
+  ASSERT_EQ(1u, profiler.get_frame_count());
+  const auto& zones = profiler.get_frame(0).zones;
+  ASSERT_EQ(3u, zones.size());
+  ASSERT_EQ(0, zones[0].depth);
+  ASSERT_EQ(1, zones[1].depth);
+  ASSERT_EQ(1, zones[2].depth);
+  ASSERT_LE(zones[0].start, zones[1].start);
+  ASSERT_GE(zones[0].end, zones[2].end);
+
+  const auto summary = profiler.get_summary();
+  ASSERT_EQ(2u, summary.size());
+  ASSERT_STREQ("outer", summary[0].name);
+  ASSERT_STREQ("inner", summary[1].name);
+  ASSERT_GE(summary[0].last_ms, summary[1].last_ms);
+}
+
+TEST(ProfilerTest, zones_outside_frames_are_ignored)
+{
+  Profiler profiler;
+
+  const int zone = profiler.begin_zone("loading");
+  profiler.end_zone(zone);
+  ASSERT_EQ(-1, zone);
+  ASSERT_EQ(0u, profiler.get_frame_count());
+  ASSERT_TRUE(profiler.get_summary().empty());
+}
+
+TEST(ProfilerTest, ring_buffer_keeps_recent_frames)
+{
+  Profiler profiler;
+  const char* names[] = { "a", "b", "c" };
+
+  for (size_t i = 0; i < Profiler::FRAME_COUNT + 10; ++i) {
+    profiler.begin_frame();
+    profiler.end_zone(profiler.begin_zone(names[i % 3]));
+    profiler.end_frame();
+  }
+
+  ASSERT_EQ(Profiler::FRAME_COUNT, profiler.get_frame_count());
+
+  const size_t last = Profiler::FRAME_COUNT + 9;
+  ASSERT_STREQ(names[last % 3], profiler.get_frame(0).zones[0].name);
+  ASSERT_STREQ(names[(last - 1) % 3], profiler.get_frame(1).zones[0].name);
+  ASSERT_LE(profiler.get_frame(1).end, profiler.get_frame(0).start);
+}
+
+TEST(ProfilerTest, chrome_trace)
+{
+  Profiler profiler;
+
+  for (int i = 0; i < 2; ++i) {
+    profiler.begin_frame();
+    profiler.end_zone(profiler.begin_zone("frame"));
+    profiler.end_frame();
+  }
+
+  std::ostringstream out;
+  profiler.write_chrome_trace(out);
+  const std::string trace = out.str();
+
+  ASSERT_EQ(0u, trace.find("{\"traceEvents\":["));
+  ASSERT_NE(std::string::npos, trace.find("{\"name\":\"frame\",\"ph\":\"X\""));
+  ASSERT_NE(trace.find("\"name\""), trace.rfind("\"name\""));
+}
+
+#endif
+
+/* EOF */
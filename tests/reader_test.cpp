@@ -169,4 +169,64 @@ TEST(ReaderTest, syntax_error)
   ASSERT_THROW({mymapping->get("b", myint);}, std::runtime_error);
 }
 
+TEST(ReaderTest, indexed_lookup)
+{
+  // Enough keys for ReaderMapping to build its index
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (t 20) (s 19) (r 18) (q 17) (p 16) (o 15) (n 14)\n"
+    "   (m 13) (l 12) (k 11) (j 10) (i 9) (h 8) (g 7)\n"
+    "   (f 6) (e 5) (d 4) (c 3) (b 2) (a 1)\n"
+    "   (dup 1) (dup 2)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  const char* keys[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j",
+                         "k", "l", "m", "n", "o", "p", "q", "r", "s", "t" };
+  for (int i = 0; i < 20; ++i)
+  {
+    int value = 0;
+    ASSERT_TRUE(mapping.get(keys[i], value));
+    ASSERT_EQ(i + 1, value);
+  }
+
+  int dup = 0;
+  ASSERT_TRUE(mapping.get("dup", dup));
+  ASSERT_EQ(1, dup);
+
+  int missing = 42;
+  ASSERT_FALSE(mapping.get("", missing));
+  ASSERT_FALSE(mapping.get("aa", missing));
+  ASSERT_FALSE(mapping.get("zz", missing));
+  ASSERT_EQ(42, missing);
+
+  // Copies share the same lookup
+  boost::optional<ReaderMapping> copy(mapping);
+  ASSERT_TRUE(copy->get("t", dup));
+  ASSERT_EQ(20, dup);
+}
+
+TEST(ReaderTest, indexed_lookup_syntax_error)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (a 1) (b 2) (c 3) (d 4) (e 5) (f 6) (g 7) (h 8)\n"
+    "   (i 9) (j 10) (k 11) (l 12) (m 13) (n 14) (o 15) (p 16)\n"
+    "   err\n"
+    "   (q 17)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  // Keys before the broken entry are found, like with a linear search
+  int value = 0;
+  ASSERT_TRUE(mapping.get("b", value));
+  ASSERT_EQ(2, value);
+  ASSERT_THROW({mapping.get("q", value);}, std::runtime_error);
+  ASSERT_THROW({mapping.get("missing", value);}, std::runtime_error);
+}
+
 /* EOF */
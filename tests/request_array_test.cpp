@@ -0,0 +1,66 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "video/request_array.hpp"
+
+TEST(RequestArrayTest, empty)
+{
+  RequestArray<float> array;
+  ASSERT_TRUE(array.empty());
+  ASSERT_EQ(0u, array.size());
+  ASSERT_EQ(array.begin(), array.end());
+}
+
+TEST(RequestArrayTest, inline_element)
+{
+  RequestArray<Rectf> array;
+  array.set(Rectf(1.0f, 2.0f, 3.0f, 4.0f));
+
+  ASSERT_EQ(1u, array.size());
+  ASSERT_EQ(Rectf(1.0f, 2.0f, 3.0f, 4.0f), array[0]);
+
+  array[0] = Rectf(5.0f, 6.0f, 7.0f, 8.0f);
+  ASSERT_EQ(Rectf(5.0f, 6.0f, 7.0f, 8.0f), *array.begin());
+}
+
+TEST(RequestArrayTest, span)
+{
+  std::vector<float> values = { 1.0f, 2.0f, 3.0f };
+
+  RequestArray<float> array;
+  array.set(5.0f);
+  array.set_span(values.data(), values.size());
+
+  ASSERT_EQ(3u, array.size());
+  ASSERT_EQ(values.data(), array.data());
+
+  for (auto& value : array)
+    value *= 2.0f;
+  ASSERT_EQ((std::vector<float>{ 2.0f, 4.0f, 6.0f }), values);
+
+  // switching back to inline storage drops the span
+  array.set(7.0f);
+  ASSERT_EQ(1u, array.size());
+  ASSERT_EQ(7.0f, array[0]);
+  ASSERT_EQ(2.0f, values[0]);
+}
+
+/* EOF */
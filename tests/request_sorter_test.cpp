@@ -0,0 +1,179 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "video/drawing_request.hpp"
+#include "video/request_sorter.hpp"
+
+namespace {
+
+class RequestSorterTest : public ::testing::Test
+{
+protected:
+  RequestSorterTest() :
+    m_textures(),
+    m_storage(),
+    m_requests()
+  {}
+
+  /** The sorter only compares texture pointers, so these never have
+      to point to real textures */
+  const Texture* texture(int index) const
+  {
+    return reinterpret_cast<const Texture*>(&m_textures[index]);
+  }
+
+  TextureRequest& add(int layer, int texture_index, const Rectf& dstrect)
+  {
+    m_storage.push_back(std::make_unique<TextureRequest>());
+    TextureRequest& request = *m_storage.back();
+    request.layer = layer;
+    request.texture = texture(texture_index);
+    request.srcrects.set(Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+    request.dstrects.set(dstrect);
+    request.angles.set(0.0f);
+    request.repeats.set(Size(1, 1));
+    m_requests.push_back(&request);
+    return request;
+  }
+
+  void fill_random(size_t count, std::mt19937& rng)
+  {
+    // Layers as used by the game: the LAYER_* constants plus small offsets
+    const int layers[] = { -300, -200, -100, 0, 50, 50, 50, 51, 150, 200, 300, 500 };
+    std::uniform_int_distribution<size_t> layer(0, sizeof(layers) / sizeof(layers[0]) - 1);
+    std::uniform_int_distribution<int> offset(-2, 2);
+    std::uniform_int_distribution<int> texture_index(0, 15);
+    std::uniform_real_distribution<float> pos(0.0f, 1280.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+      add(layers[layer(rng)] + offset(rng), texture_index(rng),
+          Rectf(Vector(pos(rng), pos(rng)), Sizef(32.0f, 32.0f)));
+    }
+  }
+
+protected:
+  char m_textures[16];
+  std::vector<std::unique_ptr<TextureRequest> > m_storage;
+  std::vector<DrawingRequest*> m_requests;
+};
+
+} // namespace
+
+TEST_F(RequestSorterTest, sort_by_layer_is_stable)
+{
+  std::mt19937 rng(1234);
+  fill_random(2000, rng);
+
+  auto expected = m_requests;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const DrawingRequest* r1, const DrawingRequest* r2) {
+                     return r1->layer < r2->layer;
+                   });
+
+  RequestSorter sorter;
+  sorter.sort_by_layer(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+TEST_F(RequestSorterTest, sort_by_layer_wide_range)
+{
+  add(1000000, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(-1000000, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(1000000, 1, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(0, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+
+  const std::vector<DrawingRequest*> expected = { m_requests[1], m_requests[3], m_requests[0], m_requests[2] };
+
+  RequestSorter sorter;
+  sorter.sort_by_layer(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+TEST_F(RequestSorterTest, group_textures_moves_disjoint_requests)
+{
+  add(0, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(0, 1, Rectf(100.0f, 0.0f, 132.0f, 32.0f));
+  add(0, 0, Rectf(200.0f, 0.0f, 232.0f, 32.0f));
+
+  const std::vector<DrawingRequest*> expected = { m_requests[0], m_requests[2], m_requests[1] };
+
+  RequestSorter sorter;
+  sorter.sort(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+TEST_F(RequestSorterTest, group_textures_keeps_overlapping_order)
+{
+  add(0, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(0, 1, Rectf(100.0f, 0.0f, 132.0f, 32.0f));
+  add(0, 0, Rectf(116.0f, 16.0f, 148.0f, 48.0f));
+
+  const auto expected = m_requests;
+
+  RequestSorter sorter;
+  sorter.sort(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+TEST_F(RequestSorterTest, group_textures_respects_repeats)
+{
+  add(0, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  // Only overlaps the last request when its repeats are taken into account
+  add(0, 1, Rectf(100.0f, 0.0f, 132.0f, 32.0f)).repeats.set(Size(4, 1));
+  add(0, 0, Rectf(200.0f, 0.0f, 232.0f, 32.0f));
+
+  const auto expected = m_requests;
+
+  RequestSorter sorter;
+  sorter.sort(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+TEST_F(RequestSorterTest, group_textures_stays_in_layer)
+{
+  add(0, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(1, 1, Rectf(100.0f, 0.0f, 132.0f, 32.0f));
+  add(1, 0, Rectf(200.0f, 0.0f, 232.0f, 32.0f));
+
+  const auto expected = m_requests;
+
+  RequestSorter sorter;
+  sorter.sort(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+TEST_F(RequestSorterTest, group_textures_skips_rotated)
+{
+  add(0, 0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  add(0, 1, Rectf(100.0f, 0.0f, 132.0f, 32.0f)).angles.set(45.0f);
+  add(0, 0, Rectf(200.0f, 0.0f, 232.0f, 32.0f));
+
+  const auto expected = m_requests;
+
+  RequestSorter sorter;
+  sorter.sort(m_requests);
+  ASSERT_EQ(expected, m_requests);
+}
+
+/* EOF */
@@ -0,0 +1,77 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "squirrel/squirrel_environment.hpp"
+#include "squirrel/squirrel_vm.hpp"
+
+namespace {
+
+int read_counter(SquirrelVM& vm, const char* environment)
+{
+  sq_pushroottable(vm.get_vm());
+  vm.get_table_entry(environment);
+  const int result = vm.read_int("counter");
+  sq_pop(vm.get_vm(), 2);
+  return result;
+}
+
+} // namespace
+
+TEST(SquirrelEnvironmentTest, script_cache)
+{
+  SquirrelVM vm;
+  SquirrelEnvironment env(vm, "env");
+  env.expose_self();
+
+  env.run_script("counter <- 0;", "init");
+  for (int i = 0; i < 5; ++i) {
+    env.run_script("counter += 1;", "collect");
+  }
+
+  ASSERT_EQ(2, env.get_script_cache_misses());
+  ASSERT_EQ(4, env.get_script_cache_hits());
+  ASSERT_EQ(2u, env.get_script_cache_size());
+  ASSERT_EQ(5, read_counter(vm, "env"));
+
+  // The same source under another name is a different script
+  env.run_script("counter += 1;", "collect2");
+  ASSERT_EQ(3, env.get_script_cache_misses());
+  ASSERT_EQ(6, read_counter(vm, "env"));
+}
+
+TEST(SquirrelEnvironmentTest, script_cache_per_environment)
+{
+  SquirrelVM vm;
+  SquirrelEnvironment env1(vm, "env1");
+  SquirrelEnvironment env2(vm, "env2");
+  env1.expose_self();
+  env2.expose_self();
+
+  env1.run_script("counter <- 0;", "init");
+  env2.run_script("counter <- 100;", "init");
+
+  env1.run_script("counter += 1;", "collect");
+  env2.run_script("counter += 1;", "collect");
+  env2.run_script("counter += 1;", "collect");
+
+  ASSERT_EQ(1, read_counter(vm, "env1"));
+  ASSERT_EQ(102, read_counter(vm, "env2"));
+}
+
+/* EOF */
@@ -0,0 +1,65 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "video/texture_packer.hpp"
+
+TEST(TexturePackerTest, rects_do_not_overlap)
+{
+  TexturePacker packer(Size(256, 256));
+
+  std::vector<Rect> rects;
+  for (int i = 0; i < 40; ++i)
+  {
+    const Size size(10 + (i * 7) % 30, 10 + (i * 13) % 30);
+    auto rect = packer.insert(size);
+    ASSERT_TRUE(rect);
+    ASSERT_EQ(size, rect->get_size());
+    ASSERT_TRUE(Rect(0, 0, 256, 256).contains(*rect));
+
+    for (const auto& other : rects)
+    {
+      ASSERT_FALSE(rect->left < other.right && other.left < rect->right &&
+                   rect->top < other.bottom && other.top < rect->bottom);
+    }
+    rects.push_back(*rect);
+  }
+
+  ASSERT_EQ(40, packer.get_rect_count());
+}
+
+TEST(TexturePackerTest, full_page)
+{
+  TexturePacker packer(Size(64, 64));
+
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(packer.insert(Size(32, 32)));
+  }
+  ASSERT_FALSE(packer.insert(Size(32, 32)));
+  ASSERT_FALSE(packer.insert(Size(128, 8)));
+  ASSERT_FLOAT_EQ(1.0f, packer.get_fill());
+
+  packer.clear();
+  ASSERT_EQ(0, packer.get_used_area());
+  ASSERT_TRUE(packer.insert(Size(64, 64)));
+}
+
+/* EOF */
@@ -0,0 +1,131 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "collision/tile_collision_mask.hpp"
+
+namespace {
+
+struct TestTile
+{
+  bool solid;
+};
+
+/** Stand-in for a solid tilemap, tile ids are looked up in a tileset
+    and out of range lookups are clamped to the border like
+    TileMap::get_tile() does */
+class TestTileMap final
+{
+public:
+  TestTileMap(int width, int height, std::mt19937& rng) :
+    m_width(width),
+    m_height(height),
+    m_tiles(width * height, 0),
+    m_tileset()
+  {
+    for (int i = 0; i < 64; ++i) {
+      m_tileset.push_back(std::unique_ptr<TestTile>(new TestTile{ i >= 48 }));
+    }
+
+    std::uniform_int_distribution<uint32_t> empty(1, 47);
+    std::uniform_int_distribution<uint32_t> solid(48, 63);
+    std::uniform_int_distribution<int> dist(0, 99);
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        // Solid ground at the bottom and a few floating tiles
+        m_tiles[y * width + x] = (y >= height - 3 || dist(rng) < 3) ? solid(rng) : empty(rng);
+      }
+    }
+  }
+
+  bool is_solid(int x, int y) const
+  {
+    x = std::max(0, std::min(x, m_width - 1));
+    y = std::max(0, std::min(y, m_height - 1));
+    return m_tileset[m_tiles[y * m_width + x]]->solid;
+  }
+
+  void fill_mask(TileCollisionMask& mask) const
+  {
+    const Rect& rect = mask.get_rect();
+    for (int y = rect.top; y < rect.bottom; ++y) {
+      for (int x = rect.left; x < rect.right; ++x) {
+        if (is_solid(x, y))
+          mask.set(x, y);
+      }
+    }
+  }
+
+private:
+  int m_width;
+  int m_height;
+  std::vector<uint32_t> m_tiles;
+  std::vector<std::unique_ptr<TestTile> > m_tileset;
+};
+
+} // namespace
+
+TEST(TileCollisionMaskTest, any_matches_brute_force)
+{
+  std::mt19937 rng(1234);
+  const TestTileMap tilemap(100, 30, rng);
+
+  TileCollisionMask mask;
+  mask.reset(Rect(-70, -5, 130, 40));
+  tilemap.fill_mask(mask);
+
+  std::uniform_int_distribution<int> pos_x(-70, 129);
+  std::uniform_int_distribution<int> pos_y(-5, 39);
+  std::uniform_int_distribution<int> size(0, 80);
+  for (int i = 0; i < 5000; ++i) {
+    const int left = pos_x(rng);
+    const int top = pos_y(rng);
+    const int right = std::min(left + size(rng), 130);
+    const int bottom = std::min(top + size(rng) / 8, 40);
+    ASSERT_TRUE(mask.covers(left, top, right, bottom));
+
+    bool expected = false;
+    for (int y = top; y < bottom; ++y) {
+      for (int x = left; x < right; ++x) {
+        expected = expected || tilemap.is_solid(x, y);
+      }
+    }
+    ASSERT_EQ(expected, mask.any(left, top, right, bottom));
+  }
+}
+
+TEST(TileCollisionMaskTest, covers)
+{
+  TileCollisionMask mask;
+  mask.reset(Rect(0, 0, 10, 10));
+  ASSERT_TRUE(mask.covers(0, 0, 10, 10));
+  ASSERT_FALSE(mask.covers(-1, 0, 5, 5));
+  ASSERT_FALSE(mask.covers(5, 5, 11, 10));
+  ASSERT_FALSE(mask.any(3, 3, 3, 3));
+
+  mask.set(9, 9);
+  ASSERT_TRUE(mask.any(0, 0, 10, 10));
+  ASSERT_FALSE(mask.any(0, 0, 9, 10));
+}
+
+/* EOF */
@@ -0,0 +1,106 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "editor/tile_region.hpp"
+
+TEST(TileRegionTest, no_change)
+{
+  std::vector<uint32_t> tiles(12, 7);
+  TileRegion region;
+  ASSERT_FALSE(TileRegion::diff(tiles, tiles, 4, region));
+}
+
+TEST(TileRegionTest, bounding_rect)
+{
+  // 4x3 tilemap
+  const std::vector<uint32_t> before = { 0, 0, 0, 0,
+                                         0, 0, 0, 0,
+                                         0, 0, 0, 0 };
+  const std::vector<uint32_t> after =  { 0, 0, 0, 0,
+                                         0, 0, 5, 0,
+                                         0, 6, 0, 0 };
+  TileRegion region;
+  ASSERT_TRUE(TileRegion::diff(before, after, 4, region));
+  ASSERT_EQ(1, region.left);
+  ASSERT_EQ(1, region.top);
+  ASSERT_EQ(2, region.width);
+  ASSERT_EQ(2, region.height);
+  ASSERT_EQ((std::vector<uint32_t>{ 0, 0, 0, 0 }), region.before);
+  ASSERT_EQ((std::vector<uint32_t>{ 0, 5, 6, 0 }), region.after);
+}
+
+TEST(TileRegionTest, single_tile)
+{
+  std::vector<uint32_t> before(100 * 50, 1);
+  std::vector<uint32_t> after = before;
+  after[49 * 100 + 99] = 2;
+
+  TileRegion region;
+  ASSERT_TRUE(TileRegion::diff(before, after, 100, region));
+  ASSERT_EQ(99, region.left);
+  ASSERT_EQ(49, region.top);
+  ASSERT_EQ(1, region.width);
+  ASSERT_EQ(1, region.height);
+  ASSERT_EQ(std::vector<uint32_t>{ 1 }, region.before);
+  ASSERT_EQ(std::vector<uint32_t>{ 2 }, region.after);
+}
+
+TEST(TileRegionTest, changed_indices)
+{
+  std::vector<uint32_t> before(10 * 10, 1);
+  std::vector<uint32_t> after = before;
+  after[2 * 10 + 3] = 2;
+  after[5 * 10 + 6] = 3;
+
+  // Unchanged and repeated indices are ignored
+  TileRegion region;
+  ASSERT_TRUE(TileRegion::diff(before, after, 10, { 0, 2 * 10 + 3, 5 * 10 + 6, 2 * 10 + 3 }, region));
+  ASSERT_EQ(3, region.left);
+  ASSERT_EQ(2, region.top);
+  ASSERT_EQ(4, region.width);
+  ASSERT_EQ(4, region.height);
+
+  TileRegion full;
+  ASSERT_TRUE(TileRegion::diff(before, after, 10, full));
+  ASSERT_EQ(full.before, region.before);
+  ASSERT_EQ(full.after, region.after);
+
+  ASSERT_FALSE(TileRegion::diff(before, after, 10, { 0, 99 }, region));
+  ASSERT_FALSE(TileRegion::diff(before, after, 10, {}, region));
+}
+
+TEST(TileRegionTest, apply)
+{
+  const std::vector<uint32_t> before = { 0, 0, 0, 0,
+                                         0, 0, 0, 0,
+                                         0, 0, 0, 0 };
+  const std::vector<uint32_t> after =  { 0, 0, 0, 0,
+                                         0, 0, 5, 0,
+                                         0, 6, 0, 0 };
+  TileRegion region;
+  ASSERT_TRUE(TileRegion::diff(before, after, 4, region));
+
+  std::vector<uint32_t> tiles = before;
+  region.apply(tiles, 4, true);
+  ASSERT_EQ(after, tiles);
+  region.apply(tiles, 4, false);
+  ASSERT_EQ(before, tiles);
+}
+
+/* EOF */
@@ -0,0 +1,240 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <physfs.h>
+
+#include "audio/sound_manager.hpp"
+#include "editor/editor.hpp"
+#include "editor/undo_delta.hpp"
+#include "object/spawnpoint.hpp"
+#include "object/tilemap.hpp"
+#include "sprite/sprite_data.hpp"
+#include "sprite/sprite_manager.hpp"
+#include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/level.hpp"
+#include "supertux/level_parser.hpp"
+#include "supertux/sector.hpp"
+#include "supertux/sector_parser.hpp"
+#include "supertux/tile_manager.hpp"
+#include "util/reader_mapping.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+const char* const s_level =
+  "(supertux-level (version 3) (name \"undo\") (tileset \"images/tiles.strf\")\n"
+  "  (sector (name \"main\")\n"
+  "    (tilemap (solid #t) (width 4) (height 3) (tiles 0 0 0 0 0 0 0 0 1 1 1 1))\n"
+  "    (camera (mode \"normal\"))\n"
+  "    (spawnpoint (name \"main\") (x 32) (y 32)))\n"
+  "  (sector (name \"second\")\n"
+  "    (tilemap (solid #t) (width 2) (height 2) (tiles 0 0 1 1))\n"
+  "    (camera (mode \"normal\"))\n"
+  "    (spawnpoint (name \"main\") (x 0) (y 0))))\n";
+
+std::string save_level(Level& level)
+{
+  std::ostringstream out;
+  level.save(out);
+  return out.str();
+}
+
+template<typename T>
+T& get_first(Sector& sector)
+{
+  for (auto& object : sector.get_objects_by_type<T>())
+    return object;
+  throw std::runtime_error("object not found");
+}
+
+/** Sets up what loading a level needs, like Main does for the
+    benchmark cases, and records edits of a small editable level */
+class UndoDeltaTest : public ::testing::Test
+{
+protected:
+  UndoDeltaTest() :
+    m_config(),
+    m_video_system(),
+    m_sound_manager(),
+    m_squirrel_virtual_machine(),
+    m_tile_manager(),
+    m_sprite_manager(),
+    m_level(),
+    m_state(),
+    m_before()
+  {
+    PHYSFS_init("undo_delta_test");
+    PHYSFS_mount("../data", nullptr, 1);
+
+    g_config = &m_config;
+    m_video_system = VideoSystem::create(VideoSystem::VIDEO_NULL);
+    m_sound_manager.reset(new SoundManager());
+    m_sound_manager->enable_sound(false);
+    m_sound_manager->enable_music(false);
+    m_squirrel_virtual_machine.reset(new SquirrelVirtualMachine(false));
+    m_tile_manager.reset(new TileManager());
+    m_sprite_manager.reset(new SpriteManager());
+
+    Editor::s_resaving_in_progress = true;
+    ReaderMapping::s_translations_enabled = false;
+
+    std::istringstream in(s_level);
+    m_level = LevelParser::from_stream(in, "undo_delta_test", false, true);
+    m_state = LevelSnapshot::from_level(*m_level);
+    m_before = save_level(*m_level);
+  }
+
+  ~UndoDeltaTest() override
+  {
+    m_state.reset();
+    m_level.reset();
+
+    ReaderMapping::s_translations_enabled = true;
+    Editor::s_resaving_in_progress = false;
+
+    m_sprite_manager.reset();
+    m_tile_manager.reset();
+    m_squirrel_virtual_machine.reset();
+    m_sound_manager.reset();
+    m_video_system.reset();
+    g_config = nullptr;
+
+    PHYSFS_deinit();
+  }
+
+  Sector& get_sector(const std::string& name)
+  {
+    Sector* sector = m_level->get_sector(name);
+    if (!sector)
+      throw std::runtime_error("sector not found: " + name);
+    return *sector;
+  }
+
+  /** Records the edit made since the level was loaded, then checks that
+      undo and redo bring back both versions of the level */
+  void check_round_trip()
+  {
+    const std::string after = save_level(*m_level);
+    ASSERT_NE(m_before, after);
+
+    auto delta = UndoDelta::record(*m_state, *m_level);
+    ASSERT_TRUE(delta);
+    EXPECT_FALSE(UndoDelta::record(*m_state, *m_level));
+
+    delta->undo(*m_level);
+    EXPECT_EQ(m_before, save_level(*m_level));
+    UndoDelta::record(*m_state, *m_level);
+
+    delta->redo(*m_level);
+    EXPECT_EQ(after, save_level(*m_level));
+    UndoDelta::record(*m_state, *m_level);
+
+    delta->undo(*m_level);
+    EXPECT_EQ(m_before, save_level(*m_level));
+  }
+
+protected:
+  Config m_config;
+  std::unique_ptr<VideoSystem> m_video_system;
+  std::unique_ptr<SoundManager> m_sound_manager;
+  std::unique_ptr<SquirrelVirtualMachine> m_squirrel_virtual_machine;
+  std::unique_ptr<TileManager> m_tile_manager;
+  std::unique_ptr<SpriteManager> m_sprite_manager;
+  std::unique_ptr<Level> m_level;
+  std::unique_ptr<LevelSnapshot> m_state;
+  std::string m_before;
+};
+
+} // namespace
+
+TEST_F(UndoDeltaTest, nothing_changed)
+{
+  EXPECT_FALSE(UndoDelta::record(*m_state, *m_level));
+  EXPECT_EQ(m_before, save_level(*m_level));
+}
+
+TEST_F(UndoDeltaTest, object_add)
+{
+  Sector& sector = get_sector("main");
+  sector.add<SpawnPointMarker>("added", Vector(64.0f, 32.0f));
+  sector.flush_game_objects();
+
+  check_round_trip();
+}
+
+TEST_F(UndoDeltaTest, object_remove)
+{
+  Sector& sector = get_sector("main");
+  get_first<SpawnPointMarker>(sector).remove_me();
+  sector.flush_game_objects();
+
+  check_round_trip();
+}
+
+TEST_F(UndoDeltaTest, object_property_edit)
+{
+  Sector& sector = get_sector("main");
+  auto& spawnpoint = get_first<SpawnPointMarker>(sector);
+  spawnpoint.set_pos(Vector(96.0f, 64.0f));
+  m_state->mark_changed(sector, spawnpoint);
+
+  check_round_trip();
+}
+
+TEST_F(UndoDeltaTest, sector_add)
+{
+  auto sector = SectorParser::from_nothing(*m_level);
+  sector->set_name("added");
+  m_level->add_sector(std::move(sector));
+
+  check_round_trip();
+}
+
+TEST_F(UndoDeltaTest, sector_remove)
+{
+  // The first sector, so that the remaining one changes its position
+  m_level->m_sectors.erase(m_level->m_sectors.begin());
+
+  check_round_trip();
+}
+
+TEST_F(UndoDeltaTest, tile_paint)
+{
+  auto& tilemap = get_first<TileMap>(get_sector("main"));
+  tilemap.change(1, 0, 1);
+  tilemap.change(2, 1, 1);
+
+  check_round_trip();
+}
+
+TEST_F(UndoDeltaTest, tilemap_resize)
+{
+  auto& tilemap = get_first<TileMap>(get_sector("second"));
+  tilemap.resize(5, 3, 1);
+
+  check_round_trip();
+}
+
+/* EOF */
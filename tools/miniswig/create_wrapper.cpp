@@ -113,6 +113,7 @@ WrapperCreator::create_register_function_code(Function* function, Class* _class)
     if(function->type == Function::DESTRUCTOR)
         return;
 
+    begin_condition(function);
     out << ind << "sq_pushstring(v, \"" << function->name << "\", -1);\n";
     out << ind << "sq_newclosure(v, &"
         << (_class != 0 ? _class->name + "_" : "") << function->name
@@ -155,6 +156,7 @@ WrapperCreator::create_register_function_code(Function* function, Class* _class)
     }
 
     create_register_slot_code("function", function->name);
+    end_condition(function);
     out << "\n";
 }
 
@@ -279,6 +281,7 @@ WrapperCreator::create_function_wrapper(Class* _class, Function* function)
     if(function->type == Function::CONSTRUCTOR)
         function->name = "constructor";
 
+    begin_condition(function);
     out << "static SQInteger ";
     if(_class != 0) {
         out << _class->name << "_";
@@ -325,6 +328,7 @@ WrapperCreator::create_function_wrapper(Class* _class, Function* function)
             out << ns_prefix;
         out << function->name << "(vm);\n";
         out << "}\n";
+        end_condition(function);
         out << "\n";
         return;
     }
@@ -420,9 +424,24 @@ WrapperCreator::create_function_wrapper(Class* _class, Function* function)
     out << "\n";
 
     out << "}\n";
+    end_condition(function);
     out << "\n";
 }
 
+void
+WrapperCreator::begin_condition(const Function* function)
+{
+    if(!function->condition.empty())
+        out << "#ifdef " << function->condition << "\n";
+}
+
+void
+WrapperCreator::end_condition(const Function* function)
+{
+    if(!function->condition.empty())
+        out << "#endif\n";
+}
+
 void
 WrapperCreator::prepare_argument(const Type& type, size_t index,
         const std::string& var)
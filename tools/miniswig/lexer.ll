@@ -103,6 +103,7 @@ private                                 { return T_PRIVATE; }
 namespace                               { return T_NAMESPACE; }
 __suspend                               { return T_SUSPEND; }
 __custom                                { return T_CUSTOM; }
+__ifdef                                 { return T_IFDEF; }
 [a-zA-Z_][a-zA-Z_0-9]*                  {
         Namespace* ns = search_namespace;
         if(ns == 0)
@@ -73,6 +73,7 @@ private:
 %token T_STATIC
 %token T_SUSPEND
 %token T_CUSTOM
+%token T_IFDEF
 %token T_CONST
 %token T_UNSIGNED
 %token T_SIGNED
@@ -318,6 +319,13 @@ function_attributes:
       {
         current_function->suspend = true;
       }
+    | T_IFDEF '(' T_STRING ')' function_attributes
+      {
+        // strip the quotes
+        std::string macro($3);
+        current_function->condition = macro.substr(1, macro.size() - 2);
+        free($3);
+      }
 ;
 
 abstract_declaration:
@@ -195,6 +195,7 @@ public:
         type(),
         suspend(),
         custom(),
+        condition(),
         parameter_spec(),
         docu_comment(),
         name(),
@@ -216,6 +217,8 @@ public:
     bool suspend;
     /// a custom wrapper (just pass along HSQUIRRELVM)
     bool custom;
+    /// macro the wrapper is only compiled with, empty if unconditional
+    std::string condition;
     std::string parameter_spec;
     std::string docu_comment;
     std::string name;